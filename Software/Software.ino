@@ -17,7 +17,10 @@
 #include "src/communication/rs485/comm_rs485.h"
 #include "src/datalayer/datalayer.h"
 #include "src/devboard/sdcard/sdcard.h"
+#include "src/devboard/utils/cell_history.h"
+#include "src/devboard/utils/cell_stats.h"
 #include "src/devboard/utils/events.h"
+#include "src/devboard/utils/latency_trace.h"
 #include "src/devboard/utils/led_handler.h"
 #include "src/devboard/utils/logging.h"
 #include "src/devboard/utils/timer.h"
@@ -30,6 +33,7 @@
 #ifdef WIFI
 #include "src/devboard/wifi/wifi.h"
 #ifdef WEBSERVER
+#include "src/devboard/webserver/page_cache.h"
 #include "src/devboard/webserver/webserver.h"
 #ifdef MDNSRESPONDER
 #include <ESPmDNS.h>
@@ -41,6 +45,8 @@
 #endif  // WEBSERVER
 #ifdef MQTT
 #include "src/devboard/mqtt/mqtt.h"
+#include "src/devboard/mqtt/mqtt_batch.h"
+#include "src/devboard/mqtt/mqtt_commands.h"
 #endif  // MQTT
 #endif  // WIFI
 #ifdef PERIODIC_BMS_RESET_AT
@@ -106,6 +112,10 @@ void setup() {
   setup_inverter();
 #endif
   setup_battery();
+  log_datalayer_ram_usage();
+#ifdef CELL_HISTORY
+  init_cell_history();
+#endif  // CELL_HISTORY
 #ifdef EQUIPMENT_STOP_BUTTON
   init_equipment_stop_button();
 #endif
@@ -176,6 +186,8 @@ void connectivity_loop(void*) {
     wifi_monitor();
 #ifdef WEBSERVER
     ota_monitor();
+    store_settings_monitor();
+    expire_cached_pages();
 #endif
     END_TIME_MEASUREMENT_MAX(wifi, datalayer.system.status.wifi_task_10s_max_us);
 
@@ -209,6 +221,10 @@ void core_loop(void*) {
 
   while (true) {
     START_TIME_MEASUREMENT(all);
+#ifdef MQTT
+    // Commands queued by the MQTT task since the last tick
+    handle_mqtt_commands();
+#endif  // MQTT
     START_TIME_MEASUREMENT(comm);
 #ifdef EQUIPMENT_STOP_BUTTON
     monitor_equipment_stop_button();
@@ -233,10 +249,15 @@ void core_loop(void*) {
       START_TIME_MEASUREMENT(time_10ms);
 #endif
       led_exe();
-      handle_contactors();  // Take care of startup precharge/contactor closing
+      update_fast_safety(0);  // Catch critical values that did not arrive with a battery CAN frame
+      handle_contactors();    // Take care of startup precharge/contactor closing
 #ifdef PRECHARGE_CONTROL
       handle_precharge_control();
 #endif  // PRECHARGE_CONTROL
+#if defined(MQTT) && defined(MQTT_BATCH)
+      // Also while disconnected, whatever fits is sent after reconnecting
+      mqtt_batch_sample();
+#endif  // MQTT && MQTT_BATCH
 #ifdef FUNCTION_TIME_MEASUREMENT
       END_TIME_MEASUREMENT_MAX(time_10ms, datalayer.system.status.time_10ms_us);
 #endif
@@ -249,13 +270,21 @@ void core_loop(void*) {
 #endif
       update_pause_state();     // Check if we are OK to send CAN or need to pause
       update_values_battery();  // Fetch battery values
+      finish_cell_stats(datalayer.battery);
 #ifdef DOUBLE_BATTERY
       update_values_battery2();
+      finish_cell_stats(datalayer.battery2);
       check_interconnect_available();
 #endif  // DOUBLE_BATTERY
       update_calculated_values();
+#ifdef CELL_HISTORY
+      update_cell_history();
+#endif                               // CELL_HISTORY
       update_machineryprotection();  // Check safeties
+      release_held_events();         // Clear flapping events that have been quiet long enough
       update_values_inverter();      // Update values heading towards inverter
+      update_datalayer_generation();
+      publish_datalayer_snapshot();
 #ifdef FUNCTION_TIME_MEASUREMENT
       END_TIME_MEASUREMENT_MAX(time_values, datalayer.system.status.time_values_us);
 #endif
@@ -296,6 +325,7 @@ void core_loop(void*) {
       datalayer.system.status.core_task_10s_max_us = 0;
       datalayer.system.status.wifi_task_10s_max_us = 0;
       datalayer.system.status.mqtt_task_10s_max_us = 0;
+      datalayer.system.status.mqtt_publish_heap_10s_max = 0;
     }
 #endif                     // FUNCTION_TIME_MEASUREMENT
     esp_task_wdt_reset();  // Reset watchdog to prevent reset
@@ -511,6 +541,9 @@ void update_calculated_values() {
 }
 
 void update_values_inverter() {
+#ifdef FUNCTION_TIME_MEASUREMENT
+  latency_trace_map();
+#endif  // FUNCTION_TIME_MEASUREMENT
 #ifdef CAN_INVERTER_SELECTED
   update_values_can_inverter();
 #endif  // CAN_INVERTER_SELECTED
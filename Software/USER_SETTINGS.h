@@ -124,15 +124,45 @@
 
 /* MQTT options */
 // #define MQTT     // Enable this line to enable MQTT
-#define MQTT_QOS 0                  // MQTT Quality of Service (0, 1, or 2)
-#define MQTT_PUBLISH_CELL_VOLTAGES  // Enable this line to publish cell voltages to MQTT
-#define MQTT_TIMEOUT 2000           // MQTT timeout in milliseconds
+#define MQTT_QOS 0                                       // MQTT Quality of Service (0, 1, or 2)
+#define MQTT_PUBLISH_CELL_VOLTAGES                       // Enable this line to publish cell voltages to MQTT
+#define MQTT_CELL_VOLTAGE_FORMAT MQTT_CELL_FORMAT_VOLTS  // VOLTS, MILLIVOLTS, BASE64 or DELTA, see mqtt.h
+#define MQTT_CELLS_PER_MODULE 16              // Cells per message when a large pack is split over several topics
+#define MQTT_TIMEOUT 2000                     // MQTT timeout in milliseconds
+#define MQTT_POWER_INTERVAL_MS 1000           // Power, current and voltage to <topic>/power
+#define MQTT_INFO_INTERVAL_MS 10000           // SOC, capacity, temperatures and more to <topic>/info
+#define MQTT_CELL_VOLTAGES_INTERVAL_MS 30000  // Cell voltages to <topic>/spec_data, events are sent at once
+//#define MQTT_PUBLISH_ON_CHANGE  // Enable this line to only publish values that moved past their deadband below, instead of everything on every schedule above
+#define MQTT_HEARTBEAT_INTERVAL_MS 60000  // With MQTT_PUBLISH_ON_CHANGE, everything is still sent at least this often
+#define MQTT_DEADBAND_SOC_PPTT 10         // 0.10% SOC/SOH change needed to publish
+#define MQTT_DEADBAND_POWER_W 10          // Power change needed to publish, also used for the charge/discharge limits
+#define MQTT_DEADBAND_VOLTAGE_DV 5        // 0.5V pack voltage change needed to publish
+#define MQTT_DEADBAND_CURRENT_DA 5        // 0.5A current change needed to publish
+#define MQTT_DEADBAND_TEMPERATURE_DC 5    // 0.5°C temperature change needed to publish
+#define MQTT_DEADBAND_CAPACITY_WH 10      // Capacity/energy change needed to publish
+#define MQTT_DEADBAND_CELL_MV 2           // Cell voltage change needed to publish cell voltages
+//#define MQTT_BACKLOG  // Enable this line to keep telemetry samples while WiFi/MQTT is down, they are sent to <topic>/backlog after reconnecting
+#define MQTT_BACKLOG_INTERVAL_MS 10000  // One sample every 10s while disconnected
+#define MQTT_BACKLOG_SAMPLES 360        // Samples kept in RAM (32 bytes each), the oldest are dropped when full
+//#define MQTT_BACKLOG_TO_SD  // Enable this line to move samples to the SD card instead of dropping them when RAM is full
+#define MQTT_BACKLOG_SD_SAMPLES 8640  // Samples kept on the SD card, 24h at the default interval
+//#define MQTT_BATCH  // Enable this line to also sample the fields below at a high rate and send them together to <topic>/batch
+// Fields to sample with MQTT_BATCH, the MQTT_BATCH_* bits are listed in mqtt.h
+#define MQTT_BATCH_FIELDS (MQTT_BATCH_POWER | MQTT_BATCH_CURRENT | MQTT_BATCH_VOLTAGE)
+#define MQTT_BATCH_SAMPLE_INTERVAL_MS 100  // 10 samples per second
+#define MQTT_BATCH_INTERVAL_MS 10000       // Samples are sent every 10s
 #define MQTT_MANUAL_TOPIC_OBJECT_NAME
 // Enable MQTT_MANUAL_TOPIC_OBJECT_NAME to use custom MQTT topic, object ID prefix, and device name.
 // WARNING: If this is not defined, the previous default naming format 'battery-emulator_esp32-XXXXXX' (based on hardware ID) will be used.
 // This naming convention was in place until version 7.5.0. Users should check the version from which they are updating, as this change
 // may break compatibility with previous versions of MQTT naming. Please refer to USER_SETTINGS.cpp for configuration options.
 
+/* Cell history options */
+//#define CELL_HISTORY  // Enable this line to keep each cell's deviation from the pack mean over time, analysed at /api/cellhistory
+#define CELL_HISTORY_INTERVAL_MS 60000    // One sample per minute
+#define CELL_HISTORY_SAMPLES 1440         // Samples kept with PSRAM, 24h at the default interval (1 byte per cell each)
+#define CELL_HISTORY_SAMPLES_NO_PSRAM 60  // Samples kept in RAM on boards without PSRAM
+
 /* Home Assistant options */
 #define HA_AUTODISCOVERY  // Enable this line to send Home Assistant autodiscovery messages. If not enabled manual configuration of Home Assitant is required
 
@@ -1,7 +1,7 @@
 #include "../include.h"
 #ifdef STELLANTIS_ECMP_BATTERY
-#include <algorithm>  // For std::min and std::max
 #include "../datalayer/datalayer.h"
+#include "../devboard/utils/cell_stats.h"
 #include "../devboard/utils/events.h"
 #include "ECMP-BATTERY.h"
 
@@ -51,25 +51,11 @@ void update_values_battery() {
 
   datalayer.battery.status.temperature_max_dC;
 
-  // Initialize min and max, lets find which cells are min and max!
-  uint16_t min_cell_mv_value = std::numeric_limits<uint16_t>::max();
-  uint16_t max_cell_mv_value = 0;
-  // Loop to find the min and max while ignoring zero values
-  for (uint8_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-    uint16_t voltage_mV = datalayer.battery.status.cell_voltages_mV[i];
-    if (voltage_mV != 0) {  // Skip unread values (0)
-      min_cell_mv_value = std::min(min_cell_mv_value, voltage_mV);
-      max_cell_mv_value = std::max(max_cell_mv_value, voltage_mV);
-    }
-  }
-  // If all array values are 0, reset min/max to 3700
-  if (min_cell_mv_value == std::numeric_limits<uint16_t>::max()) {
-    min_cell_mv_value = 3700;
-    max_cell_mv_value = 3700;
-  }
-
-  datalayer.battery.status.cell_min_voltage_mV = min_cell_mv_value;
-  datalayer.battery.status.cell_max_voltage_mV = max_cell_mv_value;
+  // Min and max of the cells that have been read, 3700 until the first reading arrives
+  update_cell_stats(datalayer.battery);
+  const bool cells_read = datalayer.battery.cell_stats.count > 0;
+  datalayer.battery.status.cell_min_voltage_mV = cells_read ? datalayer.battery.cell_stats.min_mV : 3700;
+  datalayer.battery.status.cell_max_voltage_mV = cells_read ? datalayer.battery.cell_stats.max_mV : 3700;
 }
 
 void handle_incoming_can_frame_battery(CAN_frame rx_frame) {
@@ -1,6 +1,7 @@
 #include "../include.h"
 #ifdef RENAULT_ZOE_GEN1_BATTERY
 #include "../datalayer/datalayer.h"
+#include "../devboard/utils/cell_stats.h"
 #include "../devboard/utils/events.h"
 #include "RENAULT-ZOE-GEN1-BATTERY.h"
 
@@ -107,30 +108,19 @@ void update_values_battery() {  //This function maps all the values fetched via
   //Map all cell voltages to the global array
   memcpy(datalayer.battery.status.cell_voltages_mV, cellvoltages, 96 * sizeof(uint16_t));
 
-  // Initialize min and max, lets find which cells are min and max!
-  uint16_t min_cell_mv_value = std::numeric_limits<uint16_t>::max();
-  uint16_t max_cell_mv_value = 0;
-  calculated_total_pack_voltage_mV =
-      datalayer.battery.status.cell_voltages_mV
-          [0];  // cell96 issue, this value should be initialized to 0, but for now it is initialized to cell0
-  // Loop to find the min and max while ignoring zero values
-  for (uint8_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-    uint16_t voltage_mV = datalayer.battery.status.cell_voltages_mV[i];
-    calculated_total_pack_voltage_mV += voltage_mV;
-    if (voltage_mV != 0) {  // Skip unread values (0)
-      min_cell_mv_value = std::min(min_cell_mv_value, voltage_mV);
-      max_cell_mv_value = std::max(max_cell_mv_value, voltage_mV);
-    }
-  }
-  // If all array values are 0, reset min/max to 3700
-  if (min_cell_mv_value == std::numeric_limits<uint16_t>::max()) {
-    min_cell_mv_value = 3700;
-    max_cell_mv_value = 3700;
+  // Min, max and pack voltage from the cells that have been read, defaults until the first reading arrives
+  update_cell_stats(datalayer.battery);
+  const DATALAYER_CELL_STATS_TYPE& cell_stats = datalayer.battery.cell_stats;
+  if (cell_stats.count > 0) {
+    datalayer.battery.status.cell_min_voltage_mV = cell_stats.min_mV;
+    datalayer.battery.status.cell_max_voltage_mV = cell_stats.max_mV;
+    // cell96 issue, cell 0 is counted twice until the 96th cell is decoded correctly
+    calculated_total_pack_voltage_mV = cell_stats.total_mV + datalayer.battery.status.cell_voltages_mV[0];
+  } else {
+    datalayer.battery.status.cell_min_voltage_mV = 3700;
+    datalayer.battery.status.cell_max_voltage_mV = 3700;
     calculated_total_pack_voltage_mV = 370000;
   }
-
-  datalayer.battery.status.cell_min_voltage_mV = min_cell_mv_value;
-  datalayer.battery.status.cell_max_voltage_mV = max_cell_mv_value;
   datalayer.battery.status.voltage_dV = static_cast<uint32_t>((calculated_total_pack_voltage_mV / 100));  // mV to dV
 }
 
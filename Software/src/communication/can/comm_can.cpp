@@ -1,6 +1,8 @@
 #include "comm_can.h"
 #include "../../include.h"
 #include "src/devboard/sdcard/sdcard.h"
+#include "../../devboard/utils/latency_trace.h"
+#include "esp_timer.h"
 
 // Parameters
 
@@ -21,6 +23,11 @@ SPIClass SPI2517;
 ACAN2517FD canfd(MCP2517_CS, SPI2517, MCP2517_INT);
 #endif  //CANFD_ADDON
 
+#ifdef FUNCTION_TIME_MEASUREMENT
+// Frames sent meanwhile are traced as inverter frames
+static bool inverter_is_sending = false;
+#endif  // FUNCTION_TIME_MEASUREMENT
+
 // Initialization functions
 
 void init_CAN() {
@@ -115,7 +122,13 @@ void transmit_can() {
 #endif
 
 #ifdef CAN_INVERTER_SELECTED
+#ifdef FUNCTION_TIME_MEASUREMENT
+  inverter_is_sending = true;
+#endif  // FUNCTION_TIME_MEASUREMENT
   transmit_can_inverter();
+#ifdef FUNCTION_TIME_MEASUREMENT
+  inverter_is_sending = false;
+#endif  // FUNCTION_TIME_MEASUREMENT
 #endif  // CAN_INVERTER_SELECTED
 
 #ifdef CHARGER_SELECTED
@@ -137,6 +150,12 @@ void transmit_can_frame(CAN_frame* tx_frame, int interface) {
   add_can_frame_to_buffer(*tx_frame, frameDirection(MSG_TX));
 #endif
 
+#ifdef FUNCTION_TIME_MEASUREMENT
+  if (inverter_is_sending) {
+    latency_trace_inverter_tx(*tx_frame);
+  }
+#endif  // FUNCTION_TIME_MEASUREMENT
+
   switch (interface) {
     case CAN_NATIVE:
       CAN_frame_t frame;
@@ -313,7 +332,13 @@ void map_can_frame_to_variable(CAN_frame* rx_frame, int interface) {
 
   if (interface == can_config.battery) {
 #ifndef RS485_BATTERY_SELECTED
+    const int64_t frame_us = esp_timer_get_time();
     handle_incoming_can_frame_battery(*rx_frame);
+#ifdef FUNCTION_TIME_MEASUREMENT
+    latency_trace_battery_frame(frame_us);
+#endif  // FUNCTION_TIME_MEASUREMENT
+    // Batteries that write critical values straight from the frame get their limits cut without waiting a second
+    update_fast_safety(frame_us);
 #endif
 #ifdef CHADEMO_BATTERY
     ISA_handleFrame(rx_frame);
@@ -321,7 +346,14 @@ void map_can_frame_to_variable(CAN_frame* rx_frame, int interface) {
   }
   if (interface == can_config.inverter) {
 #ifdef CAN_INVERTER_SELECTED
+#ifdef FUNCTION_TIME_MEASUREMENT
+    // Some inverters are answered straight from their request
+    inverter_is_sending = true;
+#endif  // FUNCTION_TIME_MEASUREMENT
     map_can_frame_to_variable_inverter(*rx_frame);
+#ifdef FUNCTION_TIME_MEASUREMENT
+    inverter_is_sending = false;
+#endif  // FUNCTION_TIME_MEASUREMENT
 #endif
   }
   if (interface == can_config.battery_double) {
@@ -1,9 +1,33 @@
 #include "comm_nvm.h"
+#include <mutex>
+#include <nvs.h>
 #include "../../include.h"
 
 // Parameters
 Preferences settings;  // Store user settings
 
+// Values last committed to NVS by store_settings(), used to only rewrite keys that changed
+typedef struct {
+  std::string ssid;
+  std::string password;
+  uint32_t total_capacity_Wh;
+  uint8_t soc_scaling_active;
+  uint32_t max_percentage;
+  uint32_t min_percentage;
+  uint32_t max_user_set_charge_dA;
+  uint32_t max_user_set_discharge_dA;
+  uint8_t user_set_voltage_limits_active;
+  uint32_t max_user_set_charge_voltage_dV;
+  uint32_t max_user_set_discharge_voltage_dV;
+} STORED_SETTINGS_TYPE;
+
+static STORED_SETTINGS_TYPE stored;
+static bool stored_valid = false;  // Cache is only trusted after a complete, successful store
+// store_settings() runs from the connectivity loop and the /reboot handler, which must not interleave on the cache
+static std::mutex store_mutex;
+static volatile bool store_pending = false;
+static volatile unsigned long store_requested_ms = 0;
+
 // Initialization functions
 
 void init_stored_settings() {
@@ -78,48 +102,111 @@ void store_settings_equipment_stop() {
   settings.end();
 }
 
+/* Write a key only if it differs from what was last committed. A failing write raises
+ * EVENT_PERSISTENT_SAVE_INFO with the key index, same as before. */
+#define STORE_IF_CHANGED(setter, key, value, cache, index) \
+  do {                                                     \
+    if (!stored_valid || (cache) != (value)) {             \
+      if (setter(handle, key, value) == ESP_OK) {          \
+        cache = value;                                     \
+        changed++;                                         \
+      } else {                                             \
+        set_event(EVENT_PERSISTENT_SAVE_INFO, index);      \
+        failed = true;                                     \
+      }                                                    \
+    }                                                      \
+  } while (0)
+
 void store_settings() {
   //  ATTENTION ! The maximum length for settings keys is 15 characters
-  if (!settings.begin("batterySettings", false)) {
+  std::lock_guard<std::mutex> lock(store_mutex);
+  nvs_handle_t handle;
+  uint8_t changed = 0;
+  bool failed = false;
+
+  store_pending = false;
+
+  if (nvs_open("batterySettings", NVS_READWRITE, &handle) != ESP_OK) {
     set_event(EVENT_PERSISTENT_SAVE_INFO, 0);
     return;
   }
 
 #ifdef WIFI
-  if (!settings.putString("SSID", String(ssid.c_str()))) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 1);
-  }
-  if (!settings.putString("PASSWORD", String(password.c_str()))) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 2);
+  if (!stored_valid || stored.ssid != ssid) {
+    if (nvs_set_str(handle, "SSID", ssid.c_str()) == ESP_OK) {
+      stored.ssid = ssid;
+      changed++;
+    } else {
+      set_event(EVENT_PERSISTENT_SAVE_INFO, 1);
+      failed = true;
+    }
+  }
+  if (!stored_valid || stored.password != password) {
+    if (nvs_set_str(handle, "PASSWORD", password.c_str()) == ESP_OK) {
+      stored.password = password;
+      changed++;
+    } else {
+      set_event(EVENT_PERSISTENT_SAVE_INFO, 2);
+      failed = true;
+    }
   }
 #endif
 
-  if (!settings.putUInt("BATTERY_WH_MAX", datalayer.battery.info.total_capacity_Wh)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 3);
-  }
-  if (!settings.putBool("USE_SCALED_SOC", datalayer.battery.settings.soc_scaling_active)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 4);
-  }
-  if (!settings.putUInt("MAXPERCENTAGE", datalayer.battery.settings.max_percentage / 10)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 5);
-  }
-  if (!settings.putUInt("MINPERCENTAGE", datalayer.battery.settings.min_percentage / 10)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 6);
-  }
-  if (!settings.putUInt("MAXCHARGEAMP", datalayer.battery.settings.max_user_set_charge_dA)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 7);
-  }
-  if (!settings.putUInt("MAXDISCHARGEAMP", datalayer.battery.settings.max_user_set_discharge_dA)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 8);
+  STORE_IF_CHANGED(nvs_set_u32, "BATTERY_WH_MAX", datalayer.battery.info.total_capacity_Wh, stored.total_capacity_Wh,
+                   3);
+  STORE_IF_CHANGED(nvs_set_u8, "USE_SCALED_SOC", datalayer.battery.settings.soc_scaling_active,
+                   stored.soc_scaling_active, 4);
+  STORE_IF_CHANGED(nvs_set_u32, "MAXPERCENTAGE", (uint32_t)(datalayer.battery.settings.max_percentage / 10),
+                   stored.max_percentage, 5);
+  STORE_IF_CHANGED(nvs_set_u32, "MINPERCENTAGE", (uint32_t)(datalayer.battery.settings.min_percentage / 10),
+                   stored.min_percentage, 6);
+  STORE_IF_CHANGED(nvs_set_u32, "MAXCHARGEAMP", datalayer.battery.settings.max_user_set_charge_dA,
+                   stored.max_user_set_charge_dA, 7);
+  STORE_IF_CHANGED(nvs_set_u32, "MAXDISCHARGEAMP", datalayer.battery.settings.max_user_set_discharge_dA,
+                   stored.max_user_set_discharge_dA, 8);
+  STORE_IF_CHANGED(nvs_set_u8, "USEVOLTLIMITS", datalayer.battery.settings.user_set_voltage_limits_active,
+                   stored.user_set_voltage_limits_active, 9);
+  STORE_IF_CHANGED(nvs_set_u32, "TARGETCHVOLT", datalayer.battery.settings.max_user_set_charge_voltage_dV,
+                   stored.max_user_set_charge_voltage_dV, 10);
+  STORE_IF_CHANGED(nvs_set_u32, "TARGETDISCHVOLT", datalayer.battery.settings.max_user_set_discharge_voltage_dV,
+                   stored.max_user_set_discharge_voltage_dV, 11);
+
+  // One commit for the whole batch, skipped entirely when nothing changed
+  if (changed > 0 && nvs_commit(handle) != ESP_OK) {
+    set_event(EVENT_PERSISTENT_SAVE_INFO, 12);
+    failed = true;
   }
-  if (!settings.putBool("USEVOLTLIMITS", datalayer.battery.settings.user_set_voltage_limits_active)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 9);
+  nvs_close(handle);
+
+  // A failed write leaves the cache stale, so compare everything again next time
+  stored_valid = !failed;
+}
+
+void request_store_settings() {
+  store_requested_ms = millis();
+  store_pending = true;
+}
+
+#ifdef WIFI
+void update_wifi_ssid(const char* new_ssid) {
+  {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    ssid = new_ssid;
   }
-  if (!settings.putUInt("TARGETCHVOLT", datalayer.battery.settings.max_user_set_charge_voltage_dV)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 10);
+  request_store_settings();
+}
+
+void update_wifi_password(const char* new_password) {
+  {
+    std::lock_guard<std::mutex> lock(store_mutex);
+    password = new_password;
   }
-  if (!settings.putUInt("TARGETDISCHVOLT", datalayer.battery.settings.max_user_set_discharge_voltage_dV)) {
-    set_event(EVENT_PERSISTENT_SAVE_INFO, 11);
+  request_store_settings();
+}
+#endif  // WIFI
+
+void store_settings_monitor() {
+  if (store_pending && (millis() - store_requested_ms >= SETTINGS_STORE_DEBOUNCE_MS)) {
+    store_settings();
   }
-  settings.end();  // Close preferences handle
 }
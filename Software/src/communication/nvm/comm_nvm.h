@@ -7,6 +7,9 @@
 #include "../../devboard/utils/events.h"
 #include "../../devboard/wifi/wifi.h"
 
+// Time to wait after the last settings change before committing to NVS
+#define SETTINGS_STORE_DEBOUNCE_MS 2000
+
 /**
  * @brief Initialization of setting storage
  *
@@ -34,4 +37,44 @@ void store_settings_equipment_stop();
  */
 void store_settings();
 
+/**
+ * @brief Request a deferred store of settings. Requests arriving within
+ * SETTINGS_STORE_DEBOUNCE_MS of each other are coalesced into one NVS commit
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void request_store_settings();
+
+#ifdef WIFI
+/**
+ * @brief Change the Wi-Fi SSID and request a store. Takes the store lock, so the web server can call it while
+ * store_settings() runs on the connectivity task
+ *
+ * @param[in] new_ssid
+ *
+ * @return void
+ */
+void update_wifi_ssid(const char* new_ssid);
+
+/**
+ * @brief Change the Wi-Fi password and request a store, see update_wifi_ssid()
+ *
+ * @param[in] new_password
+ *
+ * @return void
+ */
+void update_wifi_password(const char* new_password);
+#endif  // WIFI
+
+/**
+ * @brief Store pending settings once the debounce time has passed
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void store_settings_monitor();
+
 #endif
@@ -1,4 +1,104 @@
 #include "datalayer.h"
+#include <stddef.h>
+#include <string.h>
+#include <algorithm>
+#include <atomic>
+#include "../devboard/utils/events.h"
 #include "../include.h"
 
 DataLayer datalayer;
+
+// Double buffered seqlock. Publish number n writes snapshots[n & 1] while the sequence is 2n + 1 and completes at
+// 2n + 2, so a reader that loaded sequence s finds the newest complete copy in snapshots[((s >> 1) + 1) & 1].
+// The core task only starts overwriting that copy once the sequence passes (s & ~1) + 2.
+static DATALAYER_SNAPSHOT_TYPE snapshots[2];
+static std::atomic<uint32_t> snapshot_sequence(0);
+
+static uint32_t fnv1a(uint32_t hash, const void* data, size_t length) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  for (size_t i = 0; i < length; i++) {
+    hash = (hash ^ bytes[i]) * 16777619u;
+  }
+  return hash;
+}
+
+static void hash_battery(uint32_t* hash, const DATALAYER_BATTERY_TYPE& battery) {
+  // The alive counter ticks every second even when nothing else changes, leave it out.
+  // Limits and cells have their own groups, the cells are skipped over rather than hashed as zeros
+  DATALAYER_BATTERY_STATUS_TYPE status = battery.status;
+  status.CAN_battery_still_alive = 0;
+  status.max_discharge_power_W = 0;
+  status.max_charge_power_W = 0;
+  status.max_discharge_current_dA = 0;
+  status.max_charge_current_dA = 0;
+  const size_t cells_start = offsetof(DATALAYER_BATTERY_STATUS_TYPE, cell_voltages_mV);
+  const size_t cells_end = cells_start + sizeof(status.cell_voltages_mV);
+  uint32_t& status_hash = hash[DATALAYER_GROUP_BATTERY_STATUS];
+  status_hash = fnv1a(status_hash, &battery.info, sizeof(battery.info));
+  status_hash = fnv1a(status_hash, &status, cells_start);
+  status_hash = fnv1a(status_hash, (const uint8_t*)&status + cells_end, sizeof(status) - cells_end);
+
+  const uint16_t cells = std::min<uint16_t>(battery.info.number_of_cells, MAX_AMOUNT_CELLS);
+  uint32_t& cells_hash = hash[DATALAYER_GROUP_CELL_VOLTAGES];
+  cells_hash = fnv1a(cells_hash, &battery.info.number_of_cells, sizeof(battery.info.number_of_cells));
+  cells_hash = fnv1a(cells_hash, battery.status.cell_voltages_mV, cells * sizeof(uint16_t));
+
+  uint32_t& limits_hash = hash[DATALAYER_GROUP_LIMITS];
+  const uint32_t limits[] = {battery.status.max_discharge_power_W, battery.status.max_charge_power_W,
+                             battery.status.max_discharge_current_dA, battery.status.max_charge_current_dA};
+  limits_hash = fnv1a(limits_hash, limits, sizeof(limits));
+  limits_hash = fnv1a(limits_hash, &battery.settings, sizeof(battery.settings));
+}
+
+void update_datalayer_generation() {
+  static uint32_t previous_hash[DATALAYER_GROUP_COUNT] = {0};
+  uint32_t hash[DATALAYER_GROUP_COUNT];
+  for (uint8_t group = 0; group < DATALAYER_GROUP_COUNT; group++) {
+    hash[group] = 2166136261u;
+  }
+  hash_battery(hash, datalayer.battery);
+#ifdef DOUBLE_BATTERY
+  hash_battery(hash, datalayer.battery2);
+#endif
+  hash[DATALAYER_GROUP_EVENTS] = get_event_generation();
+  hash[DATALAYER_GROUP_CHARGER] = fnv1a(hash[DATALAYER_GROUP_CHARGER], &datalayer.charger, sizeof(datalayer.charger));
+  hash[DATALAYER_GROUP_SHUNT] = fnv1a(hash[DATALAYER_GROUP_SHUNT], &datalayer.shunt, sizeof(datalayer.shunt));
+
+  uint32_t changed = 0;
+  for (uint8_t group = 0; group < DATALAYER_GROUP_COUNT; group++) {
+    if (hash[group] != previous_hash[group]) {
+      previous_hash[group] = hash[group];
+      datalayer.system.status.group_generation[group]++;
+      changed |= DATALAYER_GROUP_BIT(group);
+    }
+  }
+  // Events are left out of data_generation, pages that show them add get_event_generation() themselves
+  if (changed & ~DATALAYER_GROUP_BIT(DATALAYER_GROUP_EVENTS)) {
+    datalayer.system.status.data_generation++;
+  }
+}
+
+void publish_datalayer_snapshot() {
+  const uint32_t sequence = snapshot_sequence.load(std::memory_order_relaxed);
+  snapshot_sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);  // Odd sequence is visible before the copy is touched
+
+  DATALAYER_SNAPSHOT_TYPE& snapshot = snapshots[(sequence >> 1) & 1];
+  snapshot.battery = datalayer.battery;
+#ifdef DOUBLE_BATTERY
+  snapshot.battery2 = datalayer.battery2;
+#endif
+  snapshot.shunt = datalayer.shunt;
+  memcpy(snapshot.group_generation, datalayer.system.status.group_generation, sizeof(snapshot.group_generation));
+
+  snapshot_sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void read_datalayer_snapshot(DATALAYER_SNAPSHOT_TYPE& snapshot) {
+  uint32_t sequence;
+  do {
+    sequence = snapshot_sequence.load(std::memory_order_acquire);
+    memcpy(&snapshot, &snapshots[((sequence >> 1) + 1) & 1], sizeof(snapshot));
+    std::atomic_thread_fence(std::memory_order_acquire);  // Finish the copy before checking it was not overwritten
+  } while (snapshot_sequence.load(std::memory_order_relaxed) - (sequence & ~1u) >= 3);
+}
@@ -2,6 +2,20 @@
 #define _DATALAYER_H_
 
 #include "../include.h"
+#include "datalayer_extended.h"
+
+/** Groups of datalayer values that keep their own generation counter, see update_datalayer_generation() */
+typedef enum {
+  DATALAYER_GROUP_BATTERY_STATUS = 0,  // Battery info and status, other than the groups below
+  DATALAYER_GROUP_CELL_VOLTAGES,       // Number of cells and their voltages
+  DATALAYER_GROUP_LIMITS,              // Charge and discharge limits, user settings of the battery
+  DATALAYER_GROUP_EVENTS,
+  DATALAYER_GROUP_CHARGER,
+  DATALAYER_GROUP_SHUNT,
+  DATALAYER_GROUP_COUNT
+} DATALAYER_GROUP_TYPE;
+
+#define DATALAYER_GROUP_BIT(group) (1UL << (group))
 
 typedef struct {
   /** uint32_t */
@@ -157,10 +171,40 @@ typedef struct {
 
 } DATALAYER_BATTERY_SETTINGS_TYPE;
 
+#define CELL_STATS_HISTOGRAM_BINS 8
+#define CELL_STATS_HISTOGRAM_BIN_MV 5  // Width of a histogram bin, counted up from the lowest cell
+#define CELL_STATS_OUTLIER_MV 30       // Cells further than this from the mean count as outliers
+
+/** Statistics over status.cell_voltages_mV, see update_cell_stats(). Cells still at 0 mV have no reading and
+ * are left out. Without any reading, min, max and deviation are the pack values the BMS reports */
+typedef struct {
+  /** Sum of all cell voltages */
+  uint32_t total_mV = 0;
+  /** Number of cells with a reading */
+  uint16_t count = 0;
+  uint16_t min_mV = 0;
+  uint16_t max_mV = 0;
+  /** Index in status.cell_voltages_mV of the lowest and the highest cell */
+  uint16_t min_cell = 0;
+  uint16_t max_cell = 0;
+  /** Highest minus lowest cell voltage */
+  uint16_t deviation_mV = 0;
+  uint16_t mean_mV = 0;
+  /** Standard deviation in microVolts, saturates at 65535 */
+  uint16_t stddev_uV = 0;
+  /** Number of cells further than CELL_STATS_OUTLIER_MV from the mean */
+  uint16_t outliers = 0;
+  /** Cells per CELL_STATS_HISTOGRAM_BIN_MV wide bin above min_mV, the last bin also holds all higher cells */
+  uint16_t histogram[CELL_STATS_HISTOGRAM_BINS] = {0};
+  /** The battery driver already refreshed the statistics in this update cycle */
+  bool updated_by_driver = false;
+} DATALAYER_CELL_STATS_TYPE;
+
 typedef struct {
   DATALAYER_BATTERY_INFO_TYPE info;
   DATALAYER_BATTERY_STATUS_TYPE status;
   DATALAYER_BATTERY_SETTINGS_TYPE settings;
+  DATALAYER_CELL_STATS_TYPE cell_stats;
 } DATALAYER_BATTERY_TYPE;
 
 typedef struct {
@@ -226,8 +270,9 @@ typedef struct {
   char shunt_protocol[64] = {0};
   /** array with type of inverter brand used, for displaying on webserver */
   char inverter_brand[8] = {0};
-  /** array with incoming CAN messages, for displaying on webserver */
-  char logged_can_messages[15000] = {0};
+  /** array with incoming CAN messages, for displaying on webserver. Also holds the debug log with DEBUG_VIA_WEB.
+   * Grows by the RAM the extended datalayer no longer spends on batteries that are not compiled in */
+  char logged_can_messages[15000 + DATALAYER_EXTENDED_FREED_SIZE] = {0};
   size_t logged_can_messages_offset = 0;
   /** bool, determines if CAN messages should be logged for webserver */
   bool can_logging_active = false;
@@ -256,6 +301,14 @@ typedef struct {
   int64_t mqtt_task_10s_max_us = 0;
   /** Wifi sub-task measurement variable, reset each 10 seconds */
   int64_t wifi_task_10s_max_us = 0;
+  /** Largest drop in free heap across one MQTT publish cycle, reset each 10 seconds.
+   * The publish path itself does not allocate, so this is memory other tasks took in the meantime */
+  int32_t mqtt_publish_heap_10s_max = 0;
+  /** Heap fragmentation in percent, 100 - largest free block / free heap. Sampled after each MQTT publish */
+  uint8_t heap_fragmentation_pct = 0;
+  /** Time from an MQTT command arriving until the core task executed it, last command and worst since boot */
+  int64_t mqtt_command_latency_us = 0;
+  int64_t mqtt_command_latency_max_us = 0;
 
   /** OTA handling function measurement variable */
   int64_t time_ota_us = 0;
@@ -307,6 +360,19 @@ typedef struct {
   /** True if the contactor controlled by battery-emulator is closed. Determined by check_interconnect_available(); if voltage is OK */
   bool contactors_battery2_engaged = false;
 #endif
+  /** Power limit cuts made by update_fast_safety() between values passes, since boot */
+  uint32_t safety_fast_cuts = 0;
+  /** Time from receiving the battery CAN frame that brought a critical value until the power limit cut was mapped
+   * to the inverter, last cut and worst since boot
+   */
+  int64_t safety_cut_latency_us = 0;
+  int64_t safety_cut_latency_max_us = 0;
+  /** Incremented by the values pass whenever battery, shunt or charger data differs from the previous pass.
+   * Used as cache key for rendered web pages.
+   */
+  uint32_t data_generation = 0;
+  /** Incremented by the values pass whenever data of that DATALAYER_GROUP_TYPE differs from the previous pass */
+  uint32_t group_generation[DATALAYER_GROUP_COUNT] = {0};
   /** True if the BMS is being reset, by cutting power towards it */
   bool BMS_reset_in_progress = false;
   /** True if the BMS is starting up */
@@ -341,4 +407,44 @@ class DataLayer {
 
 extern DataLayer datalayer;
 
+/**
+ * @brief Bump the generation of every group whose data changed since the previous call, and
+ *        datalayer.system.status.data_generation if battery, shunt or charger data changed.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void update_datalayer_generation();
+
+/** Copy of the data the core task updates each cycle, for tasks on the other core that need the values to match */
+typedef struct {
+  DATALAYER_BATTERY_TYPE battery;
+#ifdef DOUBLE_BATTERY
+  DATALAYER_BATTERY_TYPE battery2;
+#endif
+  DATALAYER_SHUNT_TYPE shunt;
+  /** datalayer.system.status.group_generation when the snapshot was published */
+  uint32_t group_generation[DATALAYER_GROUP_COUNT];
+} DATALAYER_SNAPSHOT_TYPE;
+
+/**
+ * @brief Publish a snapshot of battery and shunt data. Only called by the core task, at the end of the values pass
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void publish_datalayer_snapshot();
+
+/**
+ * @brief Copy the latest published snapshot. Never blocks or delays the core task, the copy is only repeated
+ *        if the core task published twice while it was being taken
+ *
+ * @param[out] snapshot
+ *
+ * @return void
+ */
+void read_datalayer_snapshot(DATALAYER_SNAPSHOT_TYPE& snapshot);
+
 #endif
@@ -1,4 +1,18 @@
 #include "datalayer_extended.h"
 #include "../include.h"
+#include "datalayer.h"
 
 DataLayerExtended datalayer_extended;
+
+void log_datalayer_ram_usage() {
+  logging.printf("Datalayer RAM: battery %u, ", (unsigned)sizeof(datalayer.battery));
+#ifdef DOUBLE_BATTERY
+  logging.printf("battery2 %u, ", (unsigned)sizeof(datalayer.battery2));
+#endif
+  logging.printf("shunt %u, charger %u, system %u (log buffer %u), extended %u bytes\n",
+                 (unsigned)sizeof(datalayer.shunt), (unsigned)sizeof(datalayer.charger),
+                 (unsigned)sizeof(datalayer.system), (unsigned)sizeof(datalayer.system.info.logged_can_messages),
+                 (unsigned)sizeof(datalayer_extended));
+  logging.printf("Extended datalayer holds %s only, %u bytes went to the log buffer\n",
+                 datalayer.system.info.battery_protocol, (unsigned)DATALAYER_EXTENDED_FREED_SIZE);
+}
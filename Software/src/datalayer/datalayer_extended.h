@@ -748,24 +748,76 @@ typedef struct {
   uint16_t battery_soc_max = 0;
 } DATALAYER_INFO_ZOE_PH2;
 
+/**
+ * Extended info of the battery selected in USER_SETTINGS.h. Exactly one battery driver is compiled in (DOUBLE_BATTERY
+ * means two identical batteries), so the structs of all other batteries are left out.
+ */
 class DataLayerExtended {
  public:
+#ifdef BOLT_AMPERA_BATTERY
   DATALAYER_INFO_BOLTAMPERA boltampera;
+#endif
+#ifdef BMW_IX_BATTERY
   DATALAYER_INFO_BMWIX bmwix;
+#endif
+#ifdef BMW_PHEV_BATTERY
   DATALAYER_INFO_BMWPHEV bmwphev;
+#endif
+#ifdef BMW_I3_BATTERY
   DATALAYER_INFO_BMWI3 bmwi3;
+#endif
+#ifdef BYD_ATTO_3_BATTERY
   DATALAYER_INFO_BYDATTO3 bydAtto3;
+#endif
+#ifdef CELLPOWER_BMS
   DATALAYER_INFO_CELLPOWER cellpower;
+#endif
+#ifdef CMFA_EV_BATTERY
   DATALAYER_INFO_CMFAEV CMFAEV;
+#endif
+#ifdef KIA_HYUNDAI_64_BATTERY
   DATALAYER_INFO_KIAHYUNDAI64 KiaHyundai64;
+#endif
+#ifdef TESLA_BATTERY
   DATALAYER_INFO_TESLA tesla;
+#endif
+#ifdef NISSAN_LEAF_BATTERY
   DATALAYER_INFO_NISSAN_LEAF nissanleaf;
+#endif
+#ifdef MEB_BATTERY
   DATALAYER_INFO_MEB meb;
+#endif
+#ifdef VOLVO_SPA_BATTERY
   DATALAYER_INFO_VOLVO_POLESTAR VolvoPolestar;
+#endif
+#ifdef VOLVO_SPA_HYBRID_BATTERY
   DATALAYER_INFO_VOLVO_HYBRID VolvoHybrid;
+#endif
+#ifdef RENAULT_ZOE_GEN2_BATTERY
   DATALAYER_INFO_ZOE_PH2 zoePH2;
+#endif
 };
 
+/** Static RAM the extended layer took while it held the structs of every battery */
+const size_t DATALAYER_EXTENDED_ALL_BATTERIES_SIZE =
+    sizeof(DATALAYER_INFO_BOLTAMPERA) + sizeof(DATALAYER_INFO_BMWIX) + sizeof(DATALAYER_INFO_BMWPHEV) +
+    sizeof(DATALAYER_INFO_BMWI3) + sizeof(DATALAYER_INFO_BYDATTO3) + sizeof(DATALAYER_INFO_CELLPOWER) +
+    sizeof(DATALAYER_INFO_CMFAEV) + sizeof(DATALAYER_INFO_KIAHYUNDAI64) + sizeof(DATALAYER_INFO_TESLA) +
+    sizeof(DATALAYER_INFO_NISSAN_LEAF) + sizeof(DATALAYER_INFO_MEB) + sizeof(DATALAYER_INFO_VOLVO_POLESTAR) +
+    sizeof(DATALAYER_INFO_VOLVO_HYBRID) + sizeof(DATALAYER_INFO_ZOE_PH2);
+
+/** What selecting one battery saves, handed on to the CAN and debug log buffer */
+const size_t DATALAYER_EXTENDED_FREED_SIZE = DATALAYER_EXTENDED_ALL_BATTERIES_SIZE - sizeof(DataLayerExtended);
+
 extern DataLayerExtended datalayer_extended;
 
+/**
+ * @brief Log the static RAM taken by the datalayer structs
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void log_datalayer_ram_usage();
+
 #endif
@@ -0,0 +1,25 @@
+#include "datalayer_fields.h"
+#include <type_traits>
+
+const DATALAYER_FIELD_TYPE datalayer_battery_fields[DATALAYER_BATTERY_FIELD_COUNT] = {
+#define DATALAYER_FIELD_ENTRY(id, read, value_type, key, metric, title, unit, decimals, group) \
+  {key, metric, title, unit, decimals, DATALAYER_GROUP_##group, sizeof(value_type), std::is_signed<value_type>::value},
+    DATALAYER_BATTERY_FIELDS(DATALAYER_FIELD_ENTRY)
+#undef DATALAYER_FIELD_ENTRY
+};
+
+int32_t read_datalayer_field(const DATALAYER_BATTERY_TYPE& battery, uint8_t field) {
+  switch (field) {
+// A registry type that does not match its value would make serializers store the wrong width or sign
+#define DATALAYER_FIELD_READ(id, read, value_type, key, metric, title, unit, decimals, group)                       \
+  case DATALAYER_FIELD_##id:                                                                                        \
+    static_assert(sizeof(read) == sizeof(value_type) && sizeof(value_type) <= sizeof(int32_t) &&                    \
+                      std::is_signed<std::decay<decltype(read)>::type>::value == std::is_signed<value_type>::value, \
+                  "Datalayer field " #id " does not match its registry type");                                      \
+    return (int32_t)(read);
+    DATALAYER_BATTERY_FIELDS(DATALAYER_FIELD_READ)
+#undef DATALAYER_FIELD_READ
+    default:
+      return 0;
+  }
+}
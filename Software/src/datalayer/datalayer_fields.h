@@ -0,0 +1,109 @@
+#ifndef _DATALAYER_FIELDS_H_
+#define _DATALAYER_FIELDS_H_
+
+#include "datalayer.h"
+
+/**
+ * Registry of the battery values that leave the emulator, so MQTT, Home Assistant discovery and /metrics all
+ * publish a new value from one line here instead of each serializer wiring it by hand.
+ *
+ * X(id, read, value_type, key, metric, title, unit, decimals, group)
+ *   read        expression of `battery`, a const DATALAYER_BATTERY_TYPE&, that reads the value
+ *   value_type  type of the value, checked against the expression at compile time
+ *   key         name the value is published under, the MQTT and JSON key
+ *   metric      OpenMetrics name without the prefix, ends with the base unit the value is exported in
+ *   title       human readable name, Home Assistant sensor name and OpenMetrics help text
+ *   unit        unit of the published value, the raw integer is that value times 10^decimals
+ *   group       DATALAYER_GROUP_TYPE whose generation changes with the value
+ */
+// clang-format off
+#define DATALAYER_BATTERY_FIELDS(X)                                                                                    \
+  X(SOC, battery.status.reported_soc, uint16_t, "SOC", "soc_ratio", "SOC (Scaled)", "%", 2, BATTERY_STATUS)            \
+  X(SOC_REAL, battery.status.real_soc, uint16_t, "SOC_real", "real_soc_ratio", "SOC (real)", "%", 2, BATTERY_STATUS)   \
+  X(STATE_OF_HEALTH, battery.status.soh_pptt, uint16_t, "state_of_health", "soh_ratio", "State Of Health", "%", 2,     \
+    BATTERY_STATUS)                                                                                                    \
+  X(TEMPERATURE_MIN, battery.status.temperature_min_dC, int16_t, "temperature_min", "temperature_min_celsius",         \
+    "Temperature Min", "°C", 1, BATTERY_STATUS)                                                                        \
+  X(TEMPERATURE_MAX, battery.status.temperature_max_dC, int16_t, "temperature_max", "temperature_max_celsius",         \
+    "Temperature Max", "°C", 1, BATTERY_STATUS)                                                                        \
+  X(POWER, battery.status.active_power_W, int32_t, "stat_batt_power", "power_watts", "Stat Batt Power", "W", 0,        \
+    BATTERY_STATUS)                                                                                                    \
+  X(CURRENT, battery.status.current_dA, int16_t, "battery_current", "current_amperes", "Battery Current", "A", 1,      \
+    BATTERY_STATUS)                                                                                                    \
+  X(VOLTAGE, battery.status.voltage_dV, uint16_t, "battery_voltage", "voltage_volts", "Battery Voltage", "V", 1,       \
+    BATTERY_STATUS)                                                                                                    \
+  X(CELL_MAX_VOLTAGE, battery.status.cell_max_voltage_mV, uint16_t, "cell_max_voltage", "cell_max_voltage_volts",      \
+    "Cell Max Voltage", "V", 3, BATTERY_STATUS)                                                                        \
+  X(CELL_MIN_VOLTAGE, battery.status.cell_min_voltage_mV, uint16_t, "cell_min_voltage", "cell_min_voltage_volts",      \
+    "Cell Min Voltage", "V", 3, BATTERY_STATUS)                                                                        \
+  X(CELL_VOLTAGE_DELTA, battery.status.cell_max_voltage_mV - battery.status.cell_min_voltage_mV, int32_t,              \
+    "cell_voltage_delta", "cell_voltage_delta_volts", "Cell Voltage Delta", "mV", 0, BATTERY_STATUS)                   \
+  X(CELL_MEAN_VOLTAGE, battery.cell_stats.mean_mV, uint16_t, "cell_mean_voltage", "cell_mean_voltage_volts",           \
+    "Cell Mean Voltage", "V", 3, CELL_VOLTAGES)                                                                        \
+  X(CELL_VOLTAGE_STDDEV, battery.cell_stats.stddev_uV, uint16_t, "cell_voltage_stddev", "cell_voltage_stddev_volts",   \
+    "Cell Voltage Standard Deviation", "mV", 3, CELL_VOLTAGES)                                                         \
+  X(CELL_OUTLIERS, battery.cell_stats.outliers, uint16_t, "cell_outliers", "cell_outliers",                            \
+    "Cells far from the mean voltage", "", 0, CELL_VOLTAGES)                                                           \
+  X(TOTAL_CAPACITY, battery.info.total_capacity_Wh, uint32_t, "total_capacity", "total_capacity_wh",                   \
+    "Battery Total Capacity", "Wh", 0, BATTERY_STATUS)                                                                 \
+  X(REMAINING_CAPACITY_REAL, battery.status.remaining_capacity_Wh, uint32_t, "remaining_capacity_real",                \
+    "remaining_capacity_wh", "Battery Remaining Capacity (real)", "Wh", 0, BATTERY_STATUS)                             \
+  X(REMAINING_CAPACITY, battery.status.reported_remaining_capacity_Wh, uint32_t, "remaining_capacity",                 \
+    "reported_remaining_capacity_wh", "Battery Remaining Capacity (scaled)", "Wh", 0, BATTERY_STATUS)                  \
+  X(MAX_DISCHARGE_POWER, battery.status.max_discharge_power_W, uint32_t, "max_discharge_power",                        \
+    "max_discharge_power_watts", "Battery Max Discharge Power", "W", 0, LIMITS)                                        \
+  X(MAX_CHARGE_POWER, battery.status.max_charge_power_W, uint32_t, "max_charge_power", "max_charge_power_watts",       \
+    "Battery Max Charge Power", "W", 0, LIMITS)                                                                        \
+  X(MAX_DISCHARGE_CURRENT, battery.status.max_discharge_current_dA, uint16_t, "max_discharge_current",                 \
+    "max_discharge_current_amperes", "Battery Max Discharge Current", "A", 1, LIMITS)                                  \
+  X(MAX_CHARGE_CURRENT, battery.status.max_charge_current_dA, uint16_t, "max_charge_current",                          \
+    "max_charge_current_amperes", "Battery Max Charge Current", "A", 1, LIMITS)                                        \
+  X(CHARGED_ENERGY, battery.status.total_charged_battery_Wh, int32_t, "charged_energy", "charged_energy_wh",           \
+    "Battery Charged Energy", "Wh", 0, BATTERY_STATUS)                                                                 \
+  X(DISCHARGED_ENERGY, battery.status.total_discharged_battery_Wh, int32_t, "discharged_energy",                       \
+    "discharged_energy_wh", "Battery Discharged Energy", "Wh", 0, BATTERY_STATUS)                                      \
+  X(NUMBER_OF_CELLS, battery.info.number_of_cells, uint8_t, "number_of_cells", "number_of_cells", "Number Of Cells",   \
+    "", 0, CELL_VOLTAGES)                                                                                              \
+  X(BMS_STATUS, battery.status.bms_status, bms_status_enum, "bms_status", "bms_status",                                \
+    "System status, 0 STANDBY 1 INACTIVE 2 DARKSTART 3 ACTIVE 4 FAULT 5 UPDATING", "", 0, BATTERY_STATUS)              \
+  X(REAL_BMS_STATUS, battery.status.real_bms_status, real_bms_status_enum, "real_bms_status", "real_bms_status",       \
+    "Battery status, 0 DISCONNECTED 1 STANDBY 2 ACTIVE 3 FAULT", "", 0, BATTERY_STATUS)                                \
+  X(CAN_ERRORS, battery.status.CAN_error_counter, uint16_t, "can_errors", "can_errors", "Battery CAN error counter",   \
+    "", 0, BATTERY_STATUS)                                                                                             \
+  X(CAN_ALIVE, battery.status.CAN_battery_still_alive, uint8_t, "can_alive", "can_alive",                              \
+    "Battery CAN still alive counter, 0 when the battery is missing", "", 0, BATTERY_STATUS)
+
+typedef enum {
+#define DATALAYER_FIELD_ENUM(id, read, value_type, key, metric, title, unit, decimals, group) DATALAYER_FIELD_##id,
+  DATALAYER_BATTERY_FIELDS(DATALAYER_FIELD_ENUM)
+#undef DATALAYER_FIELD_ENUM
+  DATALAYER_BATTERY_FIELD_COUNT
+} DATALAYER_BATTERY_FIELD_TYPE;
+// clang-format on
+
+typedef struct {
+  const char* key;
+  const char* metric;
+  const char* title;
+  const char* unit;
+  uint8_t decimals;
+  /** DATALAYER_GROUP_TYPE */
+  uint8_t group;
+  /** Size in bytes and signedness of the value, for serializers that store it at its own width */
+  uint8_t size;
+  bool is_signed;
+} DATALAYER_FIELD_TYPE;
+
+extern const DATALAYER_FIELD_TYPE datalayer_battery_fields[DATALAYER_BATTERY_FIELD_COUNT];
+
+/**
+ * @brief Raw integer of a registry field, scaled as described by its decimals
+ *
+ * @param[in] battery
+ * @param[in] field DATALAYER_BATTERY_FIELD_TYPE
+ *
+ * @return int32_t
+ */
+int32_t read_datalayer_field(const DATALAYER_BATTERY_TYPE& battery, uint8_t field);
+
+#endif
@@ -2,487 +2,1176 @@
 #include <Arduino.h>
 #include <WiFi.h>
 #include <freertos/FreeRTOS.h>
+#include <atomic>
 #include "../../../USER_SECRETS.h"
 #include "../../../USER_SETTINGS.h"
 #include "../../battery/BATTERIES.h"
 #include "../../communication/contactorcontrol/comm_contactorcontrol.h"
 #include "../../datalayer/datalayer.h"
-#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../../datalayer/datalayer_fields.h"
 #include "../utils/events.h"
 #include "../utils/timer.h"
+#include "mqtt_backlog.h"
+#include "mqtt_batch.h"
 #include "mqtt_client.h"
+#include "mqtt_commands.h"
+#include "mqtt_json_writer.h"
 
 esp_mqtt_client_config_t mqtt_cfg;
 esp_mqtt_client_handle_t client;
 char mqtt_msg[MQTT_MSG_BUFFER_SIZE];
-MyTimer publish_global_timer(5000);  //publish timer
-MyTimer check_global_timer(800);     // check timmer - low-priority MQTT checks, where responsiveness is not critical.
+MyTimer check_global_timer(MQTT_CHECK_INTERVAL_MS);  // check timer - granularity of the publish schedules below
+MyTimer background_timer(800);  // Low priority MQTT work (discovery, backlog replay) that is not time critical
 bool client_started = false;
-static String lwt_topic = "";
 
 static String topic_name = "";
 static String object_id_prefix = "";
 static String device_name = "";
 static String device_id = "";
 
+#ifdef DOUBLE_BATTERY
+#define MQTT_BATTERY_COUNT 2
+#else
+#define MQTT_BATTERY_COUNT 1
+#endif  // DOUBLE_BATTERY
+
+static const char* const battery_suffixes[] = {"", "_2"};
+
+// Topics used while publishing are built once in init_mqtt(), so the publish path never allocates
+static char status_topic[MQTT_TOPIC_LENGTH];
+static char info_topic[MQTT_TOPIC_LENGTH];
+static char power_topic[MQTT_TOPIC_LENGTH];
+static char events_topic[MQTT_TOPIC_LENGTH];
+static char cell_voltages_topic[MQTT_BATTERY_COUNT][MQTT_TOPIC_LENGTH];
+static char command_topic_prefix[MQTT_TOPIC_LENGTH];
+#ifdef MQTT_BACKLOG
+static char backlog_topic[MQTT_TOPIC_LENGTH];
+#endif  // MQTT_BACKLOG
+#ifdef MQTT_BATCH
+static char batch_topic[MQTT_TOPIC_LENGTH];
+#endif  // MQTT_BATCH
+
+static MqttJsonWriter json(mqtt_msg, sizeof(mqtt_msg));
+
+static bool publish_status(void);
+static bool publish_power(void);
 static bool publish_common_info(void);
 static bool publish_cell_voltages(void);
 static bool publish_events(void);
+#ifdef MQTT_BATCH
+static bool publish_batch(void);
+#endif  // MQTT_BATCH
+static bool cell_voltages_split(uint16_t number_of_cells);
+
+enum MQTT_TOPIC_GROUP {
+  MQTT_GROUP_POWER,
+  MQTT_GROUP_INFO,
+  MQTT_GROUP_CELL_VOLTAGES,
+  MQTT_GROUP_BATCH,
+  MQTT_GROUP_COUNT
+};
+
+typedef struct {
+  unsigned long interval_ms;
+  unsigned long due_ms;
+} MQTT_SCHEDULE_TYPE;
+
+// Same order as MQTT_TOPIC_GROUP
+static MQTT_SCHEDULE_TYPE schedules[MQTT_GROUP_COUNT] = {{MQTT_POWER_INTERVAL_MS, 0},
+                                                         {MQTT_INFO_INTERVAL_MS, 0},
+                                                         {MQTT_CELL_VOLTAGES_INTERVAL_MS, 0},
+                                                         {MQTT_BATCH_INTERVAL_MS, 0}};
+
+/** Give every group its own phase, one check apart, so they are never due in the same mqtt_loop() */
+static void stagger_schedules(void) {
+  for (uint8_t group = 0; group < MQTT_GROUP_COUNT; group++) {
+    schedules[group].due_ms = millis() + (group + 1) * MQTT_CHECK_INTERVAL_MS;
+  }
+}
+
+/** True when the group should be published now, the next slot keeps the group's phase */
+static bool schedule_due(MQTT_TOPIC_GROUP group) {
+  MQTT_SCHEDULE_TYPE& schedule = schedules[group];
+  unsigned long now = millis();
+  if ((long)(now - schedule.due_ms) < 0) {
+    return false;
+  }
+  schedule.due_ms += schedule.interval_ms;
+  if ((long)(now - schedule.due_ms) >= 0) {
+    schedule.due_ms = now + schedule.interval_ms;  // Fell behind, e.g. while disconnected, don't try to catch up
+  }
+  return true;
+}
 
-/** Publish global values and call callbacks for specific modules */
+/** Publish the topic groups that are due, events go out as soon as they are raised */
 static void publish_values(void) {
 
-  if (mqtt_publish((topic_name + "/status").c_str(), "online", false) == false) {
+  if (schedule_due(MQTT_GROUP_POWER) && publish_power() == false) {
     return;
   }
 
-  if (publish_events() == false) {
+  if (schedule_due(MQTT_GROUP_INFO) && (publish_status() == false || publish_common_info() == false)) {
     return;
   }
 
-  if (publish_common_info() == false) {
+  if (publish_events() == false) {
     return;
   }
 
 #ifdef MQTT_PUBLISH_CELL_VOLTAGES
-  if (publish_cell_voltages() == false) {
+  if (schedule_due(MQTT_GROUP_CELL_VOLTAGES) && publish_cell_voltages() == false) {
     return;
   }
 #endif
+
+#ifdef MQTT_BATCH
+  if (schedule_due(MQTT_GROUP_BATCH) && publish_batch() == false) {
+    return;
+  }
+#endif  // MQTT_BATCH
 }
 
+#if defined(MEB_BATTERY) || defined(TESLA_BATTERY)
+#define MQTT_ENERGY_FIELDS(X)                  \
+  X(CHARGED_ENERGY, MQTT_DEADBAND_CAPACITY_WH) \
+  X(DISCHARGED_ENERGY, MQTT_DEADBAND_CAPACITY_WH)
+#else
+#define MQTT_ENERGY_FIELDS(X)
+#endif
+
+// Datalayer registry fields of the info message, and the smallest change of the raw value that is worth a new
+// message with MQTT_PUBLISH_ON_CHANGE. Key, scaling and Home Assistant sensor come from the registry.
+#define MQTT_INFO_FIELDS(X)                             \
+  X(SOC, MQTT_DEADBAND_SOC_PPTT)                        \
+  X(SOC_REAL, MQTT_DEADBAND_SOC_PPTT)                   \
+  X(STATE_OF_HEALTH, MQTT_DEADBAND_SOC_PPTT)            \
+  X(TEMPERATURE_MIN, MQTT_DEADBAND_TEMPERATURE_DC)      \
+  X(TEMPERATURE_MAX, MQTT_DEADBAND_TEMPERATURE_DC)      \
+  X(POWER, MQTT_DEADBAND_POWER_W)                       \
+  X(CURRENT, MQTT_DEADBAND_CURRENT_DA)                  \
+  X(VOLTAGE, MQTT_DEADBAND_VOLTAGE_DV)                  \
+  X(CELL_MAX_VOLTAGE, MQTT_DEADBAND_CELL_MV)            \
+  X(CELL_MIN_VOLTAGE, MQTT_DEADBAND_CELL_MV)            \
+  X(CELL_VOLTAGE_DELTA, MQTT_DEADBAND_CELL_MV)          \
+  X(TOTAL_CAPACITY, MQTT_DEADBAND_CAPACITY_WH)          \
+  X(REMAINING_CAPACITY_REAL, MQTT_DEADBAND_CAPACITY_WH) \
+  X(REMAINING_CAPACITY, MQTT_DEADBAND_CAPACITY_WH)      \
+  X(MAX_DISCHARGE_POWER, MQTT_DEADBAND_POWER_W)         \
+  X(MAX_CHARGE_POWER, MQTT_DEADBAND_POWER_W)            \
+  MQTT_ENERGY_FIELDS(X)
+
+// clang-format off
+enum MQTT_INFO_FIELD {
+#define MQTT_INFO_FIELD_ENUM(id, deadband) INFO_##id,
+  MQTT_INFO_FIELDS(MQTT_INFO_FIELD_ENUM)
+#undef MQTT_INFO_FIELD_ENUM
+  INFO_FIELD_COUNT
+};
+// clang-format on
+
+typedef struct {
+  /** DATALAYER_BATTERY_FIELD_TYPE */
+  uint8_t field;
+  int32_t deadband;
+} MQTT_INFO_FIELD_TYPE;
+
+static const MQTT_INFO_FIELD_TYPE info_fields[INFO_FIELD_COUNT] = {
+#define MQTT_INFO_FIELD_ENTRY(id, deadband) {DATALAYER_FIELD_##id, deadband},
+    MQTT_INFO_FIELDS(MQTT_INFO_FIELD_ENTRY)
+#undef MQTT_INFO_FIELD_ENTRY
+};
+
+// Fields of a message, as a mask of MQTT_INFO_FIELD bits
+#define INFO_FIELD_BIT(field) (1UL << (field))
+#define INFO_ALL_FIELDS (INFO_FIELD_BIT(INFO_FIELD_COUNT) - 1)
+#define INFO_POWER_FIELDS (INFO_FIELD_BIT(INFO_POWER) | INFO_FIELD_BIT(INFO_CURRENT) | INFO_FIELD_BIT(INFO_VOLTAGE))
+
 #ifdef HA_AUTODISCOVERY
-static bool ha_common_info_published = false;
-static bool ha_cell_voltages_published = false;
-static bool ha_events_published = false;
-static bool ha_buttons_published = false;
 struct SensorConfig {
   const char* object_id;
   const char* name;
-  const char* value_template;
   const char* unit;
   const char* device_class;
+  const char* state_topic;  // info_topic when not set
 };
 
-SensorConfig sensorConfigTemplate[] = {
-    {"SOC", "SOC (Scaled)", "", "%", "battery"},
-    {"SOC_real", "SOC (real)", "", "%", "battery"},
-    {"state_of_health", "State Of Health", "", "%", "battery"},
-    {"temperature_min", "Temperature Min", "", "°C", "temperature"},
-    {"temperature_max", "Temperature Max", "", "°C", "temperature"},
-    {"stat_batt_power", "Stat Batt Power", "", "W", "power"},
-    {"battery_current", "Battery Current", "", "A", "current"},
-    {"cell_max_voltage", "Cell Max Voltage", "", "V", "voltage"},
-    {"cell_min_voltage", "Cell Min Voltage", "", "V", "voltage"},
-    {"cell_voltage_delta", "Cell Voltage Delta", "", "mV", "voltage"},
-    {"battery_voltage", "Battery Voltage", "", "V", "voltage"},
-    {"total_capacity", "Battery Total Capacity", "", "Wh", "energy"},
-    {"remaining_capacity", "Battery Remaining Capacity (scaled)", "", "Wh", "energy"},
-    {"remaining_capacity_real", "Battery Remaining Capacity (real)", "", "Wh", "energy"},
-    {"max_discharge_power", "Battery Max Discharge Power", "", "W", "power"},
-    {"max_charge_power", "Battery Max Charge Power", "", "W", "power"},
-#if defined(MEB_BATTERY) || defined(TESLA_BATTERY)
-    {"charged_energy", "Battery Charged Energy", "", "Wh", "energy"},
-    {"discharged_energy", "Battery Discharged Energy", "", "Wh", "energy"},
-#endif
-    {"bms_status", "BMS Status", "", "", ""},
-    {"pause_status", "Pause Status", "", "", ""}};
+// Sensors besides the info fields, they are not repeated for the second battery
+SensorConfig statusSensorConfigs[] = {{"bms_status", "BMS Status", "", ""}, {"pause_status", "Pause Status", "", ""}};
+
+#define STATUS_SENSOR_COUNT (sizeof(statusSensorConfigs) / sizeof(statusSensorConfigs[0]))
+#define SENSOR_TEMPLATE_COUNT (INFO_FIELD_COUNT + STATUS_SENSOR_COUNT)
+
+SensorConfig buttonConfigs[] = {{"BMSRESET", "Reset BMS"},
+                                {"PAUSE", "Pause charge/discharge"},
+                                {"RESUME", "Resume charge/discharge"},
+                                {"RESTART", "Restart Battery Emulator"},
+                                {"STOP", "Open Contactors"}};
+
+#define BUTTON_CONFIG_COUNT (sizeof(buttonConfigs) / sizeof(buttonConfigs[0]))
+
+/**
+ * Discovery messages are sent a few at a time, in this order. Only the position is kept between calls and each
+ * message is rendered again when its turn comes, so the whole set costs a few bytes of RAM instead of a stored
+ * payload per message. A failed publish does not move the position, sending resumes there after a reconnect.
+ */
+enum HA_DISCOVERY_STAGE {
+  HA_DISCOVERY_BUTTONS,
+  HA_DISCOVERY_SENSORS,
+  HA_DISCOVERY_EVENT,
+  HA_DISCOVERY_CELLS,
+  HA_DISCOVERY_CELLS_2,
+  HA_DISCOVERY_DONE
+};
+
+static HA_DISCOVERY_STAGE ha_discovery_stage = HA_DISCOVERY_BUTTONS;
+static uint16_t ha_discovery_index = 0;
+// Set from the MQTT task when Home Assistant comes online, picked up by the next publish_ha_discovery()
+static volatile bool ha_discovery_restart = false;
+static char ha_discovery_topic[MQTT_TOPIC_LENGTH * 2];
+// "device" and "availability" members shared by every discovery message, rendered once in init_mqtt()
+static char ha_device_members[320];
+
+static void render_ha_device_members(void) {
+  MqttJsonWriter members(ha_device_members, sizeof(ha_device_members));
+  members.key("device");
+  members.begin_object();
+  members.key("identifiers");
+  members.begin_array();
+  members.value(device_id.c_str());
+  members.end_array();
+  members.key("manufacturer");
+  members.value("DalaTech");
+  members.key("model");
+  members.value("BatteryEmulator");
+  members.key("name");
+  members.value(device_name.c_str());
+  members.end_object();
+  members.key("availability");
+  members.begin_array();
+  members.begin_object();
+  members.key("topic");
+  members.value(status_topic);
+  members.end_object();
+  members.end_array();
+  members.key("payload_available");
+  members.value("online");
+  members.key("payload_not_available");
+  members.value("offline");
+  members.key("enabled_by_default");
+  members.raw("true");
+}
+
+static void write_ha_string(const char* key, const char* value) {
+  json.key(key);
+  json.value(value);
+}
+
+static uint16_t ha_cell_discovery_count(const DATALAYER_BATTERY_TYPE& battery) {
+#ifdef MQTT_PUBLISH_CELL_VOLTAGES
+  // Home Assistant templates cannot unpack base64, so that format is for other consumers only
+  if (MQTT_CELL_VOLTAGE_FORMAT != MQTT_CELL_FORMAT_BASE64) {
+    return battery.info.number_of_cells;
+  }
+#endif  // MQTT_PUBLISH_CELL_VOLTAGES
+  return 0;
+}
 
+/** Number of discovery messages in a stage */
+static uint16_t ha_discovery_stage_size(HA_DISCOVERY_STAGE stage) {
+  switch (stage) {
+    case HA_DISCOVERY_BUTTONS:
+      return BUTTON_CONFIG_COUNT;
+    case HA_DISCOVERY_SENSORS:
+      // The second battery repeats everything but bms_status and pause_status
+      return MQTT_BATTERY_COUNT == 2 ? SENSOR_TEMPLATE_COUNT * 2 - STATUS_SENSOR_COUNT : SENSOR_TEMPLATE_COUNT;
+    case HA_DISCOVERY_EVENT:
+      return 1;
+    case HA_DISCOVERY_CELLS:
+      return ha_cell_discovery_count(datalayer.battery);
 #ifdef DOUBLE_BATTERY
-SensorConfig sensorConfigs[((sizeof(sensorConfigTemplate) / sizeof(sensorConfigTemplate[0])) * 2) - 2];
-#else
-SensorConfig sensorConfigs[sizeof(sensorConfigTemplate) / sizeof(sensorConfigTemplate[0])];
+    case HA_DISCOVERY_CELLS_2:
+      return ha_cell_discovery_count(datalayer.battery2);
 #endif  // DOUBLE_BATTERY
+    default:
+      return 0;
+  }
+}
 
-void create_sensor_configs() {
-  int number_of_templates = sizeof(sensorConfigTemplate) / sizeof(sensorConfigTemplate[0]);
-  for (int i = 0; i < number_of_templates; i++) {
-    SensorConfig config = sensorConfigTemplate[i];
-    config.value_template = strdup(("{{ value_json." + std::string(config.object_id) + " }}").c_str());
-    sensorConfigs[i] = config;
+/** Cell discovery has to wait until the battery has reported how many cells it has */
+static bool ha_discovery_waiting_for_cells(HA_DISCOVERY_STAGE stage) {
+#ifdef MQTT_PUBLISH_CELL_VOLTAGES
+  if (MQTT_CELL_VOLTAGE_FORMAT != MQTT_CELL_FORMAT_BASE64) {
+    if (stage == HA_DISCOVERY_CELLS) {
+      return datalayer.battery.info.number_of_cells == 0;
+    }
 #ifdef DOUBLE_BATTERY
-    if (config.object_id == "pause_status" || config.object_id == "bms_status") {
-      continue;
+    if (stage == HA_DISCOVERY_CELLS_2) {
+      return datalayer.battery2.info.number_of_cells == 0;
     }
-    sensorConfigs[i + number_of_templates] = config;
-    sensorConfigs[i + number_of_templates].name = strdup(String(config.name + String(" 2")).c_str());
-    sensorConfigs[i + number_of_templates].object_id = strdup(String(config.object_id + String("_2")).c_str());
-    sensorConfigs[i + number_of_templates].value_template =
-        strdup(("{{ value_json." + std::string(config.object_id) + "_2 }}").c_str());
 #endif  // DOUBLE_BATTERY
   }
+#endif  // MQTT_PUBLISH_CELL_VOLTAGES
+  return false;
 }
 
-SensorConfig buttonConfigs[] = {{"BMSRESET", "Reset BMS"},
-                                {"PAUSE", "Pause charge/discharge"},
-                                {"RESUME", "Resume charge/discharge"},
-                                {"RESTART", "Restart Battery Emulator"},
-                                {"STOP", "Open Contactors"}};
+static void render_ha_button(uint16_t index) {
+  const SensorConfig& config = buttonConfigs[index];
+  char value[MQTT_TOPIC_LENGTH + 16];
+  snprintf(ha_discovery_topic, sizeof(ha_discovery_topic), "homeassistant/button/%s/%s/config", topic_name.c_str(),
+           config.object_id);
+
+  write_ha_string("name", config.name);
+  snprintf(value, sizeof(value), "%s%s", object_id_prefix.c_str(), config.object_id);
+  write_ha_string("unique_id", value);
+  snprintf(value, sizeof(value), "%s%s", command_topic_prefix, config.object_id);
+  write_ha_string("command_topic", value);
+}
 
-static String generateCommonInfoAutoConfigTopic(const char* object_id) {
-  return "homeassistant/sensor/" + topic_name + "/" + String(object_id) + "/config";
+/** Home Assistant device class for the unit of a registry field, it decides which units the sensor accepts */
+static const char* ha_device_class(const char* unit) {
+  if (strcmp(unit, "%") == 0) {
+    return "battery";
+  } else if (strcmp(unit, "°C") == 0) {
+    return "temperature";
+  } else if (strcmp(unit, "W") == 0) {
+    return "power";
+  } else if (strcmp(unit, "A") == 0) {
+    return "current";
+  } else if (strcmp(unit, "V") == 0 || strcmp(unit, "mV") == 0) {
+    return "voltage";
+  } else if (strcmp(unit, "Wh") == 0) {
+    return "energy";
+  }
+  return "";
 }
 
-static String generateCellVoltageAutoConfigTopic(int cell_number, String battery_suffix) {
-  return "homeassistant/sensor/" + topic_name + "/cell_voltage" + battery_suffix + String(cell_number) + "/config";
+static SensorConfig ha_sensor_config(uint16_t template_index) {
+  if (template_index >= INFO_FIELD_COUNT) {
+    return statusSensorConfigs[template_index - INFO_FIELD_COUNT];
+  }
+  const DATALAYER_FIELD_TYPE& field = datalayer_battery_fields[info_fields[template_index].field];
+  const bool power_topic_field = INFO_POWER_FIELDS & INFO_FIELD_BIT(template_index);
+  return {field.key, field.title, field.unit, ha_device_class(field.unit), power_topic_field ? power_topic : nullptr};
+}
+
+static void render_ha_sensor(uint16_t index) {
+  const SensorConfig config = ha_sensor_config(index % SENSOR_TEMPLATE_COUNT);
+  bool second_battery = index >= SENSOR_TEMPLATE_COUNT;
+  const char* suffix = second_battery ? "_2" : "";
+  char value[MQTT_TOPIC_LENGTH + 16];
+  snprintf(ha_discovery_topic, sizeof(ha_discovery_topic), "homeassistant/sensor/%s/%s%s/config", topic_name.c_str(),
+           config.object_id, suffix);
+
+  snprintf(value, sizeof(value), "%s%s", config.name, second_battery ? " 2" : "");
+  write_ha_string("name", value);
+  write_ha_string("state_topic", config.state_topic != nullptr ? config.state_topic : info_topic);
+  snprintf(value, sizeof(value), "%s_%s%s", topic_name.c_str(), config.object_id, suffix);
+  write_ha_string("unique_id", value);
+  snprintf(value, sizeof(value), "%s%s%s", object_id_prefix.c_str(), config.object_id, suffix);
+  write_ha_string("object_id", value);
+  snprintf(value, sizeof(value), "{{ value_json.%s%s }}", config.object_id, suffix);
+  write_ha_string("value_template", value);
+  if (strlen(config.unit) > 0) {
+    write_ha_string("unit_of_measurement", config.unit);
+  }
+  if (strlen(config.device_class) > 0) {
+    write_ha_string("device_class", config.device_class);
+    write_ha_string("state_class", "measurement");
+  }
 }
 
-static String generateEventsAutoConfigTopic(const char* object_id) {
-  return "homeassistant/sensor/" + topic_name + "/" + String(object_id) + "/config";
+static void render_ha_event(void) {
+  char value[MQTT_TOPIC_LENGTH + 16];
+  snprintf(ha_discovery_topic, sizeof(ha_discovery_topic), "homeassistant/sensor/%s/event/config", topic_name.c_str());
+
+  write_ha_string("name", "Event");
+  write_ha_string("state_topic", events_topic);
+  snprintf(value, sizeof(value), "%s_event", topic_name.c_str());
+  write_ha_string("unique_id", value);
+  snprintf(value, sizeof(value), "%sevent", object_id_prefix.c_str());
+  write_ha_string("object_id", value);
+  write_ha_string("value_template",
+                  "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ "
+                  "value_json.message }}");
+  write_ha_string("json_attributes_topic", events_topic);
+  write_ha_string("json_attributes_template", "{{ value_json | tojson }}");
 }
 
-static String generateButtonAutoConfigTopic(const char* subtype) {
-  return "homeassistant/button/" + topic_name + "/" + String(subtype) + "/config";
+static void render_ha_cell(uint8_t battery_index, uint16_t number_of_cells, uint16_t i) {
+  // The second battery has always used "_2_" in the config topic and "2_" in the ids
+  const char* id_suffix = battery_index == 0 ? "" : "2_";
+  uint16_t cell_number = i + 1;
+  char value[MQTT_TOPIC_LENGTH + 32];
+  snprintf(ha_discovery_topic, sizeof(ha_discovery_topic), "homeassistant/sensor/%s/cell_voltage%s%u/config",
+           topic_name.c_str(), battery_index == 0 ? "" : "_2_", cell_number);
+
+  snprintf(value, sizeof(value), "Battery%s Cell Voltage %u", battery_index == 0 ? "" : " 2", cell_number);
+  write_ha_string("name", value);
+  snprintf(value, sizeof(value), "%s%sbattery_voltage_cell%u", object_id_prefix.c_str(), id_suffix, cell_number);
+  write_ha_string("object_id", value);
+  snprintf(value, sizeof(value), "%s%s%s_battery_voltage_cell%u", topic_name.c_str(), object_id_prefix.c_str(),
+           id_suffix, cell_number);
+  write_ha_string("unique_id", value);
+  write_ha_string("device_class", "voltage");
+  write_ha_string("state_class", "measurement");
+
+  uint16_t position = i;  // Position of the cell within its message
+  if (cell_voltages_split(number_of_cells)) {
+    snprintf(value, sizeof(value), "%s/%u", cell_voltages_topic[battery_index], i / MQTT_CELLS_PER_MODULE + 1);
+    position = i % MQTT_CELLS_PER_MODULE;
+    write_ha_string("state_topic", value);
+  } else {
+    write_ha_string("state_topic", cell_voltages_topic[battery_index]);
+  }
+  write_ha_string("unit_of_measurement", "V");
+
+  switch (MQTT_CELL_VOLTAGE_FORMAT) {
+    case MQTT_CELL_FORMAT_MILLIVOLTS:
+      snprintf(value, sizeof(value), "{{ value_json.cell_voltages_mV[%u] / 1000 }}", position);
+      break;
+    case MQTT_CELL_FORMAT_DELTA:
+      snprintf(value, sizeof(value), "{{ (value_json.cell_base_mV[%u] + value_json.cell_deltas_mV[%u]) / 1000 }}",
+               position / MQTT_CELLS_PER_MODULE, position);
+      break;
+    default:
+      snprintf(value, sizeof(value), "{{ value_json.cell_voltages[%u] }}", position);
+      break;
+  }
+  write_ha_string("value_template", value);
 }
 
-void set_common_discovery_attributes(JsonDocument& doc) {
-  doc["device"]["identifiers"][0] = device_id;
-  doc["device"]["manufacturer"] = "DalaTech";
-  doc["device"]["model"] = "BatteryEmulator";
-  doc["device"]["name"] = device_name;
-  doc["availability"][0]["topic"] = lwt_topic;
-  doc["payload_available"] = "online";
-  doc["payload_not_available"] = "offline";
-  doc["enabled_by_default"] = true;
+/** Render the discovery message at the current position into mqtt_msg and ha_discovery_topic */
+static void render_ha_discovery(void) {
+  json.reset();
+  json.begin_object();
+  switch (ha_discovery_stage) {
+    case HA_DISCOVERY_BUTTONS:
+      render_ha_button(ha_discovery_index);
+      break;
+    case HA_DISCOVERY_SENSORS:
+      render_ha_sensor(ha_discovery_index);
+      break;
+    case HA_DISCOVERY_EVENT:
+      render_ha_event();
+      break;
+    case HA_DISCOVERY_CELLS:
+      render_ha_cell(0, datalayer.battery.info.number_of_cells, ha_discovery_index);
+      break;
+#ifdef DOUBLE_BATTERY
+    case HA_DISCOVERY_CELLS_2:
+      render_ha_cell(1, datalayer.battery2.info.number_of_cells, ha_discovery_index);
+      break;
+#endif  // DOUBLE_BATTERY
+    default:
+      break;
+  }
+  json.raw(ha_device_members);
+  json.end_object();
 }
 
-void set_battery_voltage_attributes(JsonDocument& doc, int i, int cellNumber, const String& state_topic,
-                                    const String& object_id_prefix, const String& battery_name_suffix) {
-  doc["name"] = "Battery" + battery_name_suffix + " Cell Voltage " + String(cellNumber);
-  doc["object_id"] = object_id_prefix + "battery_voltage_cell" + String(cellNumber);
-  doc["unique_id"] = topic_name + object_id_prefix + "_battery_voltage_cell" + String(cellNumber);
-  doc["device_class"] = "voltage";
-  doc["state_class"] = "measurement";
-  doc["state_topic"] = state_topic;
-  doc["unit_of_measurement"] = "V";
-  doc["value_template"] = "{{ value_json.cell_voltages[" + String(i) + "] }}";
+/**
+ * @brief Send the next few Home Assistant discovery messages
+ *
+ * At most HA_DISCOVERY_MESSAGES_PER_CYCLE messages are sent per call, and none while the outbox already holds more
+ * than MQTT_OUTBOX_LIMIT bytes, so a large pack never floods the outbox or delays the state topics.
+ */
+static void publish_ha_discovery(void) {
+  if (ha_discovery_restart) {
+    ha_discovery_restart = false;
+    ha_discovery_stage = HA_DISCOVERY_BUTTONS;
+    ha_discovery_index = 0;
+  }
+
+  uint8_t sent = 0;
+  while (ha_discovery_stage != HA_DISCOVERY_DONE && sent < HA_DISCOVERY_MESSAGES_PER_CYCLE) {
+    if (ha_discovery_index >= ha_discovery_stage_size(ha_discovery_stage)) {
+      if (ha_discovery_waiting_for_cells(ha_discovery_stage)) {
+        return;
+      }
+      ha_discovery_stage = (HA_DISCOVERY_STAGE)(ha_discovery_stage + 1);
+      ha_discovery_index = 0;
+      continue;
+    }
+
+    if (esp_mqtt_client_get_outbox_size(client) > MQTT_OUTBOX_LIMIT) {
+      return;
+    }
+
+    render_ha_discovery();
+    if (json.overflowed()) {
+#ifdef DEBUG_LOG
+      logging.printf("Discovery message does not fit in the MQTT buffer: %s\n", ha_discovery_topic);
+#endif  // DEBUG_LOG
+    } else if (!mqtt_publish(ha_discovery_topic, mqtt_msg, true)) {
+#ifdef DEBUG_LOG
+      logging.println("Discovery MQTT msg could not be sent");
+#endif  // DEBUG_LOG
+      return;
+    }
+    ha_discovery_index++;
+    sent++;
+  }
 }
 #endif  // HA_AUTODISCOVERY
 
-static String generateButtonTopic(const char* subtype) {
-  return topic_name + "/command/" + String(subtype);
-}
-
-void set_battery_attributes(JsonDocument& doc, const DATALAYER_BATTERY_TYPE& battery, const String& suffix) {
-  doc["SOC" + suffix] = ((float)battery.status.reported_soc) / 100.0;
-  doc["SOC_real" + suffix] = ((float)battery.status.real_soc) / 100.0;
-  doc["state_of_health" + suffix] = ((float)battery.status.soh_pptt) / 100.0;
-  doc["temperature_min" + suffix] = ((float)((int16_t)battery.status.temperature_min_dC)) / 10.0;
-  doc["temperature_max" + suffix] = ((float)((int16_t)battery.status.temperature_max_dC)) / 10.0;
-  doc["stat_batt_power" + suffix] = ((float)((int32_t)battery.status.active_power_W));
-  doc["battery_current" + suffix] = ((float)((int16_t)battery.status.current_dA)) / 10.0;
-  doc["battery_voltage" + suffix] = ((float)battery.status.voltage_dV) / 10.0;
-  if (battery.info.number_of_cells != 0u && battery.status.cell_voltages_mV[battery.info.number_of_cells - 1] != 0u) {
-    doc["cell_max_voltage" + suffix] = ((float)battery.status.cell_max_voltage_mV) / 1000.0;
-    doc["cell_min_voltage" + suffix] = ((float)battery.status.cell_min_voltage_mV) / 1000.0;
-    doc["cell_voltage_delta" + suffix] =
-        ((float)battery.status.cell_max_voltage_mV) - ((float)battery.status.cell_min_voltage_mV);
-  }
-  doc["total_capacity" + suffix] = ((float)battery.info.total_capacity_Wh);
-  doc["remaining_capacity_real" + suffix] = ((float)battery.status.remaining_capacity_Wh);
-  doc["remaining_capacity" + suffix] = ((float)battery.status.reported_remaining_capacity_Wh);
-  doc["max_discharge_power" + suffix] = ((float)battery.status.max_discharge_power_W);
-  doc["max_charge_power" + suffix] = ((float)battery.status.max_charge_power_W);
+/** Marks a field that is left out of the info message */
+#define INFO_FIELD_ABSENT INT32_MIN
+
+/** Battery data the current publish works from, copied in one piece so values of one message belong together */
+static DATALAYER_SNAPSHOT_TYPE snapshot;
+
+/** Raw values of the info message, per battery */
+static int32_t info_values[MQTT_BATTERY_COUNT][INFO_FIELD_COUNT];
+
+void set_battery_attributes(int32_t* values, const DATALAYER_BATTERY_TYPE& battery) {
+  for (uint8_t i = 0; i < INFO_FIELD_COUNT; i++) {
+    values[i] = INFO_FIELD_ABSENT;
+  }
+  //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
+  if (!battery.status.CAN_battery_still_alive || !allowed_to_send_CAN || millis() <= BOOTUP_TIME) {
+    return;
+  }
+  for (uint8_t i = 0; i < INFO_FIELD_COUNT; i++) {
+    values[i] = read_datalayer_field(battery, info_fields[i].field);
+  }
+  if (battery.info.number_of_cells == 0u || battery.status.cell_voltages_mV[battery.info.number_of_cells - 1] == 0u) {
+    values[INFO_CELL_MAX_VOLTAGE] = INFO_FIELD_ABSENT;
+    values[INFO_CELL_MIN_VOLTAGE] = INFO_FIELD_ABSENT;
+    values[INFO_CELL_VOLTAGE_DELTA] = INFO_FIELD_ABSENT;
+  }
 #if defined(MEB_BATTERY) || defined(TESLA_BATTERY)
-  if (datalayer.battery.status.total_charged_battery_Wh != 0 &&
-      datalayer.battery.status.total_discharged_battery_Wh != 0) {
-    doc["charged_energy" + suffix] = ((float)datalayer.battery.status.total_charged_battery_Wh);
-    doc["discharged_energy" + suffix] = ((float)datalayer.battery.status.total_discharged_battery_Wh);
+  if (battery.status.total_charged_battery_Wh == 0 || battery.status.total_discharged_battery_Wh == 0) {
+    values[INFO_CHARGED_ENERGY] = INFO_FIELD_ABSENT;
+    values[INFO_DISCHARGED_ENERGY] = INFO_FIELD_ABSENT;
   }
 #endif
 }
 
-static std::vector<EventData> order_events;
+static void write_battery_attributes(const int32_t* values, const char* suffix, uint32_t fields) {
+  for (uint8_t i = 0; i < INFO_FIELD_COUNT; i++) {
+    if ((fields & INFO_FIELD_BIT(i)) && values[i] != INFO_FIELD_ABSENT) {
+      const DATALAYER_FIELD_TYPE& field = datalayer_battery_fields[info_fields[i].field];
+      json.key(field.key, suffix);
+      json.value(values[i], field.decimals);
+    }
+  }
+}
 
-static bool publish_common_info(void) {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/info";
-#ifdef HA_AUTODISCOVERY
-  if (ha_common_info_published == false) {
-    for (int i = 0; i < sizeof(sensorConfigs) / sizeof(sensorConfigs[0]); i++) {
-      SensorConfig& config = sensorConfigs[i];
-      doc["name"] = config.name;
-      doc["state_topic"] = state_topic;
-      doc["unique_id"] = topic_name + "_" + String(config.object_id);
-      doc["object_id"] = object_id_prefix + String(config.object_id);
-      doc["value_template"] = config.value_template;
-      if (config.unit != nullptr && strlen(config.unit) > 0)
-        doc["unit_of_measurement"] = config.unit;
-      if (config.device_class != nullptr && strlen(config.device_class) > 0) {
-        doc["device_class"] = config.device_class;
-        doc["state_class"] = "measurement";
+#ifdef MQTT_PUBLISH_ON_CHANGE
+typedef struct {
+  /** Last published raw value per field, INFO_FIELD_ABSENT when the field was left out of the message */
+  int32_t values[MQTT_BATTERY_COUNT][INFO_FIELD_COUNT];
+  bms_status_enum bms_status;
+  battery_pause_status pause_status;
+  unsigned long published_ms;
+  bool published;
+} MQTT_PUBLISHED_INFO_TYPE;
+
+typedef struct {
+  uint16_t voltages_mV[MAX_AMOUNT_CELLS];
+  uint8_t number_of_cells;
+  unsigned long published_ms;
+  bool published;
+  /** Cell voltage group generation of the last completed pass, while it holds no cell can have moved */
+  uint32_t generation;
+} MQTT_PUBLISHED_CELLS_TYPE;
+
+static MQTT_PUBLISHED_INFO_TYPE published_info;
+static MQTT_PUBLISHED_INFO_TYPE published_power;
+static MQTT_PUBLISHED_CELLS_TYPE published_cells[MQTT_BATTERY_COUNT];
+static unsigned long status_published_ms = 0;
+static bool status_published = false;
+// Set by the MQTT task on connect, the published state itself is only touched by mqtt_loop()
+static std::atomic<bool> republish_requested(false);
+
+/** Whatever was published before the disconnect may have been missed, start with a full refresh */
+static void reset_published(void) {
+  status_published = false;
+  published_info.published = false;
+  published_power.published = false;
+  for (uint8_t battery = 0; battery < MQTT_BATTERY_COUNT; battery++) {
+    published_cells[battery].published = false;
+  }
+}
+
+static bool heartbeat_due(bool published, unsigned long published_ms) {
+  return !published || millis() - published_ms >= MQTT_HEARTBEAT_INTERVAL_MS;
+}
+
+/** True when any of the fields moved past its deadband since the message was last published */
+static bool info_changed(const MQTT_PUBLISHED_INFO_TYPE& published_message, uint32_t fields) {
+  if (heartbeat_due(published_message.published, published_message.published_ms)) {
+    return true;
+  }
+  for (uint8_t battery = 0; battery < MQTT_BATTERY_COUNT; battery++) {
+    for (uint8_t i = 0; i < INFO_FIELD_COUNT; i++) {
+      if (!(fields & INFO_FIELD_BIT(i))) {
+        continue;
       }
-      set_common_discovery_attributes(doc);
-      serializeJson(doc, mqtt_msg);
-      if (mqtt_publish(generateCommonInfoAutoConfigTopic(config.object_id).c_str(), mqtt_msg, true)) {
-        ha_common_info_published = true;
-      } else {
-        return false;
+      int32_t value = info_values[battery][i];
+      int32_t published = published_message.values[battery][i];
+      if ((value == INFO_FIELD_ABSENT) != (published == INFO_FIELD_ABSENT)) {
+        return true;  // Field appeared or disappeared
+      }
+      if (value != INFO_FIELD_ABSENT && abs(value - published) >= info_fields[i].deadband) {
+        return true;
       }
-      doc.clear();
     }
+  }
+  return false;
+}
 
-  } else {
-#endif  // HA_AUTODISCOVERY
-    doc["bms_status"] = getBMSStatus(datalayer.battery.status.bms_status);
-    doc["pause_status"] = get_emulator_pause_status();
+static void remember_info(MQTT_PUBLISHED_INFO_TYPE& published_message) {
+  memcpy(published_message.values, info_values, sizeof(info_values));
+  published_message.bms_status = snapshot.battery.status.bms_status;
+  published_message.pause_status = emulator_pause_status;
+  published_message.published_ms = millis();
+  published_message.published = true;
+}
 
-    //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-    if (datalayer.battery.status.CAN_battery_still_alive && allowed_to_send_CAN && millis() > BOOTUP_TIME) {
-      set_battery_attributes(doc, datalayer.battery, "");
-    }
-#ifdef DOUBLE_BATTERY
-    //only publish these values if BMS is active and we are comunication  with the battery (can send CAN messages to the battery)
-    if (datalayer.battery2.status.CAN_battery_still_alive && allowed_to_send_CAN && millis() > BOOTUP_TIME) {
-      set_battery_attributes(doc, datalayer.battery2, "_2");
-    }
-#endif  // DOUBLE_BATTERY
-    serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(state_topic.c_str(), mqtt_msg, false) == false) {
-#ifdef DEBUG_LOG
-      logging.println("Common info MQTT msg could not be sent");
-#endif  // DEBUG_LOG
-      return false;
+/** True when all cells should be republished, regardless of how much they moved */
+static bool cells_refresh_due(const DATALAYER_BATTERY_TYPE& battery, const MQTT_PUBLISHED_CELLS_TYPE& published) {
+  return heartbeat_due(published.published, published.published_ms) ||
+         published.number_of_cells != battery.info.number_of_cells;
+}
+
+/** True when any cell in the range moved past MQTT_DEADBAND_CELL_MV since it was last published */
+static bool cells_changed(const DATALAYER_BATTERY_TYPE& battery, const MQTT_PUBLISHED_CELLS_TYPE& published,
+                          uint16_t first, uint16_t count) {
+  for (uint16_t i = first; i < first + count; i++) {
+    if (abs((int)battery.status.cell_voltages_mV[i] - (int)published.voltages_mV[i]) >= MQTT_DEADBAND_CELL_MV) {
+      return true;
     }
-    doc.clear();
-#ifdef HA_AUTODISCOVERY
   }
-#endif  // HA_AUTODISCOVERY
-  return true;
+  return false;
 }
 
-static bool publish_cell_voltages(void) {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/spec_data";
-#ifdef DOUBLE_BATTERY
-  static String state_topic_2 = topic_name + "/spec_data_2";
-#endif  // DOUBLE_BATTERY
+static void remember_cells(const DATALAYER_BATTERY_TYPE& battery, MQTT_PUBLISHED_CELLS_TYPE& published, uint16_t first,
+                           uint16_t count) {
+  memcpy(&published.voltages_mV[first], &battery.status.cell_voltages_mV[first], count * sizeof(uint16_t));
+}
+#endif  // MQTT_PUBLISH_ON_CHANGE
 
-#ifdef HA_AUTODISCOVERY
-  bool failed_to_publish = false;
-  if (ha_cell_voltages_published == false) {
+/** True when the cell voltages of the battery have been populated */
+static bool cell_voltages_populated(const DATALAYER_BATTERY_TYPE& battery) {
+  return battery.info.number_of_cells != 0u && battery.status.cell_voltages_mV[battery.info.number_of_cells - 1] != 0u;
+}
 
-    // If the cell voltage number isn't initialized...
-    if (datalayer.battery.info.number_of_cells != 0u) {
+/**
+ * Longest text a cell can take in the payload, including the separator. Deciding the split on the worst case
+ * keeps the topic layout fixed for a pack, so Home Assistant sensors never move between topics.
+ */
+static uint16_t cell_voltages_worst_case_size(uint16_t number_of_cells) {
+  const uint16_t overhead = 64;  // Braces, keys and first_cell
+  switch (MQTT_CELL_VOLTAGE_FORMAT) {
+    case MQTT_CELL_FORMAT_MILLIVOLTS:
+      return overhead + number_of_cells * 6;  // "65535,"
+    case MQTT_CELL_FORMAT_BASE64:
+      return overhead + ((number_of_cells * 2 + 2) / 3) * 4;
+    case MQTT_CELL_FORMAT_DELTA:
+      // "65535," per delta and one base per module
+      return overhead + number_of_cells * 6 +
+             ((number_of_cells + MQTT_CELLS_PER_MODULE - 1) / MQTT_CELLS_PER_MODULE) * 6;
+    default:
+      return overhead + number_of_cells * 7;  // "65.535,"
+  }
+}
 
-      for (int i = 0; i < datalayer.battery.info.number_of_cells; i++) {
-        int cellNumber = i + 1;
-        set_battery_voltage_attributes(doc, i, cellNumber, state_topic, object_id_prefix, "");
-        set_common_discovery_attributes(doc);
+/** True when the cells of a pack are published per module to <spec_data>/<module> instead of one message */
+static bool cell_voltages_split(uint16_t number_of_cells) {
+  return cell_voltages_worst_case_size(number_of_cells) > MQTT_MSG_BUFFER_SIZE;
+}
 
-        serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-        if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "").c_str(), mqtt_msg, true) == false) {
-          failed_to_publish = true;
-          return false;
-        }
+static uint16_t module_min_voltage(const uint16_t* voltages_mV, uint16_t module_first, uint16_t count) {
+  uint16_t lowest = UINT16_MAX;
+  for (uint16_t i = module_first; i < count && i < module_first + MQTT_CELLS_PER_MODULE; i++) {
+    lowest = min(lowest, voltages_mV[i]);
+  }
+  return lowest;
+}
+
+static void write_cell_voltages(const DATALAYER_BATTERY_TYPE& battery, uint16_t first, uint16_t count, bool split) {
+  const uint16_t* voltages_mV = &battery.status.cell_voltages_mV[first];
+  json.reset();
+  json.begin_object();
+  if (split) {
+    json.key("first_cell");
+    json.value(first + 1);
+  }
+  switch (MQTT_CELL_VOLTAGE_FORMAT) {
+    case MQTT_CELL_FORMAT_MILLIVOLTS:
+      json.key("cell_voltages_mV");
+      json.begin_array();
+      for (uint16_t i = 0; i < count; i++) {
+        json.value(voltages_mV[i]);
       }
-      doc.clear();  // clear after sending autoconfig
-    }
-#ifdef DOUBLE_BATTERY
-    // If the cell voltage number isn't initialized...
-    if (datalayer.battery2.info.number_of_cells != 0u) {
-
-      for (int i = 0; i < datalayer.battery.info.number_of_cells; i++) {
-        int cellNumber = i + 1;
-        set_battery_voltage_attributes(doc, i, cellNumber, state_topic_2, object_id_prefix + "2_", " 2");
-        set_common_discovery_attributes(doc);
-
-        serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
-        if (mqtt_publish(generateCellVoltageAutoConfigTopic(cellNumber, "_2_").c_str(), mqtt_msg, true) == false) {
-          failed_to_publish = true;
-          return false;
+      json.end_array();
+      break;
+    case MQTT_CELL_FORMAT_BASE64:
+      // The ESP32 is little endian, so the datalayer array already is the packed little endian uint16 stream
+      json.key("cell_voltages_b64");
+      json.value_base64((const uint8_t*)voltages_mV, count * sizeof(uint16_t));
+      break;
+    case MQTT_CELL_FORMAT_DELTA:
+      // Each module is sent as its lowest voltage and the offset of every cell above it
+      json.key("cell_base_mV");
+      json.begin_array();
+      for (uint16_t module = 0; module < count; module += MQTT_CELLS_PER_MODULE) {
+        json.value(module_min_voltage(voltages_mV, module, count));
+      }
+      json.end_array();
+      json.key("cell_deltas_mV");
+      json.begin_array();
+      for (uint16_t i = 0, base = 0; i < count; i++) {
+        if (i % MQTT_CELLS_PER_MODULE == 0) {
+          base = module_min_voltage(voltages_mV, i, count);
         }
+        json.value(voltages_mV[i] - base);
       }
-      doc.clear();  // clear after sending autoconfig
-    }
+      json.end_array();
+      break;
+    default:
+      json.key("cell_voltages");
+      json.begin_array();
+      for (uint16_t i = 0; i < count; i++) {
+        json.value(voltages_mV[i], 3);
+      }
+      json.end_array();
+      break;
+  }
+  json.end_object();
+}
+
+static bool publish_status(void) {
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  if (!heartbeat_due(status_published, status_published_ms)) {
+    return true;
+  }
+#endif  // MQTT_PUBLISH_ON_CHANGE
+  if (mqtt_publish(status_topic, "online", false) == false) {
+    return false;
+  }
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  status_published_ms = millis();
+  status_published = true;
+#endif  // MQTT_PUBLISH_ON_CHANGE
+  return true;
+}
+
+static std::vector<EventData> order_events;
+
+static bool publish_common_info(void) {
+  read_datalayer_snapshot(snapshot);
+  set_battery_attributes(info_values[0], snapshot.battery);
+#ifdef DOUBLE_BATTERY
+  set_battery_attributes(info_values[1], snapshot.battery2);
 #endif  // DOUBLE_BATTERY
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  if (!info_changed(published_info, INFO_ALL_FIELDS) &&
+      published_info.bms_status == snapshot.battery.status.bms_status &&
+      published_info.pause_status == emulator_pause_status) {
+    return true;
   }
-  if (failed_to_publish == false) {
-    ha_cell_voltages_published = true;
+#endif  // MQTT_PUBLISH_ON_CHANGE
+
+  json.reset();
+  json.begin_object();
+  json.key("bms_status");
+  json.value(getBMSStatus(snapshot.battery.status.bms_status).c_str());
+  json.key("pause_status");
+  json.value(get_emulator_pause_status().c_str());
+  for (uint8_t battery = 0; battery < MQTT_BATTERY_COUNT; battery++) {
+    write_battery_attributes(info_values[battery], battery_suffixes[battery], INFO_ALL_FIELDS);
   }
-#endif  // HA_AUTODISCOVERY
+  json.end_object();
 
-  // If cell voltages have been populated...
-  if (datalayer.battery.info.number_of_cells != 0u &&
-      datalayer.battery.status.cell_voltages_mV[datalayer.battery.info.number_of_cells - 1] != 0u) {
+  if (json.overflowed() || mqtt_publish(info_topic, mqtt_msg, false) == false) {
+#ifdef DEBUG_LOG
+    logging.println("Common info MQTT msg could not be sent");
+#endif  // DEBUG_LOG
+    return false;
+  }
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  remember_info(published_info);
+#endif  // MQTT_PUBLISH_ON_CHANGE
+  return true;
+}
 
-    JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery.info.number_of_cells; ++i) {
-      cell_voltages.add(((float)datalayer.battery.status.cell_voltages_mV[i]) / 1000.0);
-    }
+/** Power, current and voltage on their own faster schedule, they are repeated in the info message */
+static bool publish_power(void) {
+  read_datalayer_snapshot(snapshot);
+  set_battery_attributes(info_values[0], snapshot.battery);
+#ifdef DOUBLE_BATTERY
+  set_battery_attributes(info_values[1], snapshot.battery2);
+#endif  // DOUBLE_BATTERY
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  if (!info_changed(published_power, INFO_POWER_FIELDS)) {
+    return true;
+  }
+#endif  // MQTT_PUBLISH_ON_CHANGE
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+  json.reset();
+  json.begin_object();
+  for (uint8_t battery = 0; battery < MQTT_BATTERY_COUNT; battery++) {
+    write_battery_attributes(info_values[battery], battery_suffixes[battery], INFO_POWER_FIELDS);
+  }
+  json.end_object();
 
-    if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
+  if (json.overflowed() || mqtt_publish(power_topic, mqtt_msg, false) == false) {
 #ifdef DEBUG_LOG
-      logging.println("Cell voltage MQTT msg could not be sent");
+    logging.println("Power MQTT msg could not be sent");
 #endif  // DEBUG_LOG
-      return false;
-    }
-    doc.clear();
+    return false;
   }
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  remember_info(published_power);
+#endif  // MQTT_PUBLISH_ON_CHANGE
+  return true;
+}
 
-#ifdef DOUBLE_BATTERY
-  // If cell voltages have been populated...
-  if (datalayer.battery2.info.number_of_cells != 0u &&
-      datalayer.battery2.status.cell_voltages_mV[datalayer.battery2.info.number_of_cells - 1] != 0u) {
+static bool publish_battery_cell_voltages(const DATALAYER_BATTERY_TYPE& battery, uint8_t index) {
+  uint16_t number_of_cells = battery.info.number_of_cells;
+  bool split = cell_voltages_split(number_of_cells);
+  uint16_t cells_per_message = split ? MQTT_CELLS_PER_MODULE : number_of_cells;
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  bool refresh = cells_refresh_due(battery, published_cells[index]);
+  const uint32_t generation = snapshot.group_generation[DATALAYER_GROUP_CELL_VOLTAGES];
+  if (!refresh && published_cells[index].generation == generation) {
+    return true;  // Skip comparing every cell against the published copy
+  }
+#endif  // MQTT_PUBLISH_ON_CHANGE
 
-    JsonArray cell_voltages = doc["cell_voltages"].to<JsonArray>();
-    for (size_t i = 0; i < datalayer.battery2.info.number_of_cells; ++i) {
-      cell_voltages.add(((float)datalayer.battery2.status.cell_voltages_mV[i]) / 1000.0);
+  for (uint16_t first = 0; first < number_of_cells; first += cells_per_message) {
+    uint16_t count = min((uint16_t)(number_of_cells - first), cells_per_message);
+#ifdef MQTT_PUBLISH_ON_CHANGE
+    if (!refresh && !cells_changed(battery, published_cells[index], first, count)) {
+      continue;
     }
+#endif  // MQTT_PUBLISH_ON_CHANGE
 
-    serializeJson(doc, mqtt_msg, sizeof(mqtt_msg));
+    write_cell_voltages(battery, first, count, split);
+    if (json.overflowed()) {
+#ifdef DEBUG_LOG
+      logging.println("Cell voltage MQTT msg does not fit in the MQTT buffer");
+#endif  // DEBUG_LOG
+      // Retrying will not make it fit, carry on with the other topics
+      return true;
+    }
 
-    if (!mqtt_publish(state_topic_2.c_str(), mqtt_msg, false)) {
+    char module_topic[MQTT_TOPIC_LENGTH + 4];
+    const char* topic = cell_voltages_topic[index];
+    if (split) {
+      snprintf(module_topic, sizeof(module_topic), "%s/%u", topic, first / MQTT_CELLS_PER_MODULE + 1);
+      topic = module_topic;
+    }
+    if (!mqtt_publish(topic, mqtt_msg, false)) {
 #ifdef DEBUG_LOG
       logging.println("Cell voltage MQTT msg could not be sent");
 #endif  // DEBUG_LOG
       return false;
     }
-    doc.clear();
+#ifdef MQTT_PUBLISH_ON_CHANGE
+    remember_cells(battery, published_cells[index], first, count);
+#endif  // MQTT_PUBLISH_ON_CHANGE
   }
-#endif  // DOUBLE_BATTERY
+
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  if (refresh) {
+    published_cells[index].number_of_cells = battery.info.number_of_cells;
+    published_cells[index].published_ms = millis();
+    published_cells[index].published = true;
+  }
+  published_cells[index].generation = generation;
+#endif  // MQTT_PUBLISH_ON_CHANGE
   return true;
 }
 
-bool publish_events() {
-  static JsonDocument doc;
-  static String state_topic = topic_name + "/events";
-#ifdef HA_AUTODISCOVERY
-  if (ha_events_published == false) {
-
-    doc["name"] = "Event";
-    doc["state_topic"] = state_topic;
-    doc["unique_id"] = topic_name + "_event";
-    doc["object_id"] = object_id_prefix + "event";
-    doc["value_template"] =
-        "{{ value_json.event_type ~ ' (c:' ~ value_json.count ~ ',m:' ~  value_json.millis ~ ') ' ~ value_json.message "
-        "}}";
-    doc["json_attributes_topic"] = state_topic;
-    doc["json_attributes_template"] = "{{ value_json | tojson }}";
-    set_common_discovery_attributes(doc);
-    serializeJson(doc, mqtt_msg);
-    if (mqtt_publish(generateEventsAutoConfigTopic("event").c_str(), mqtt_msg, true)) {
-      ha_events_published = true;
-    } else {
-      return false;
-    }
+static bool publish_cell_voltages(void) {
+  read_datalayer_snapshot(snapshot);
+  // If cell voltages have been populated...
+  if (cell_voltages_populated(snapshot.battery) && !publish_battery_cell_voltages(snapshot.battery, 0)) {
+    return false;
+  }
 
-    doc.clear();
-  } else {
-#endif  // HA_AUTODISCOVERY
+#ifdef DOUBLE_BATTERY
+  // If cell voltages have been populated...
+  if (cell_voltages_populated(snapshot.battery2) && !publish_battery_cell_voltages(snapshot.battery2, 1)) {
+    return false;
+  }
+#endif  // DOUBLE_BATTERY
+  return true;
+}
 
-    const EVENTS_STRUCT_TYPE* event_pointer;
+static bool publish_events(void) {
+  const EVENTS_STRUCT_TYPE* event_pointer;
 
-    //clear the vector
-    order_events.clear();
-    // Collect all events
-    for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
-      event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
-      if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
-        order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
-      }
+  //clear the vector
+  order_events.clear();
+  // Collect all events
+  for (int i = 0; i < EVENT_NOF_EVENTS; i++) {
+    event_pointer = get_event_pointer((EVENTS_ENUM_TYPE)i);
+    if (event_pointer->occurences > 0 && !event_pointer->MQTTpublished) {
+      order_events.push_back({static_cast<EVENTS_ENUM_TYPE>(i), event_pointer});
+    }
+  }
+  // Sort events by timestamp
+  std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
+
+  for (const auto& event : order_events) {
+
+    EVENTS_ENUM_TYPE event_handle = event.event_handle;
+    event_pointer = event.event_pointer;
+    char number[12];
+
+    // The numbers have always been published as strings, keep it that way for existing automations
+    json.reset();
+    json.begin_object();
+    json.key("event_type");
+    json.value(get_event_enum_string(event_handle));
+    json.key("severity");
+    json.value(get_event_level_string(event_handle));
+    json.key("count");
+    snprintf(number, sizeof(number), "%u", event_pointer->occurences);
+    json.value(number);
+    json.key("data");
+    snprintf(number, sizeof(number), "%u", event_pointer->data);
+    json.value(number);
+    json.key("message");
+    json.value(get_event_message_string(event_handle));
+    json.key("millis");
+    snprintf(number, sizeof(number), "%lu", (unsigned long)event_pointer->timestamp);
+    json.value(number);
+    // A flapping event is published when it starts and once more when it settles, with the flaps in between
+    json.key("flapping");
+    json.value(event_pointer->flapping ? "1" : "0");
+    json.key("flaps");
+    snprintf(number, sizeof(number), "%u", event_pointer->flaps);
+    json.value(number);
+    json.end_object();
+
+    if (json.overflowed() || !mqtt_publish(events_topic, mqtt_msg, false)) {
+#ifdef DEBUG_LOG
+      logging.println("Common info MQTT msg could not be sent");
+#endif  // DEBUG_LOG
+      return false;
+    } else {
+      set_event_MQTTpublished(event_handle);
     }
-    // Sort events by timestamp
-    std::sort(order_events.begin(), order_events.end(), compareEventsByTimestampAsc);
+  }
+  //clear the vector
+  order_events.clear();
+  return true;
+}
+
+#ifdef MQTT_BACKLOG
+MyTimer backlog_sample_timer(MQTT_BACKLOG_INTERVAL_MS);
+// Written by the MQTT task, read by mqtt_loop()
+static volatile bool mqtt_connected = false;
+static MQTT_BACKLOG_SAMPLE_TYPE backlog_batch[MQTT_BACKLOG_BATCH_SAMPLES];
+
+static void store_backlog_sample(void) {
+  read_datalayer_snapshot(snapshot);
+  const DATALAYER_BATTERY_STATUS_TYPE& status = snapshot.battery.status;
+  if (!status.CAN_battery_still_alive) {
+    return;  // A gap is better than repeating stale values
+  }
+  MQTT_BACKLOG_SAMPLE_TYPE sample;
+  sample.millis = millis();
+  sample.power_W = status.active_power_W;
+  sample.remaining_capacity_Wh = status.reported_remaining_capacity_Wh;
+  sample.total_charged_Wh = status.total_charged_battery_Wh;
+  sample.total_discharged_Wh = status.total_discharged_battery_Wh;
+  sample.soc_pptt = status.reported_soc;
+  sample.voltage_dV = status.voltage_dV;
+  sample.current_dA = status.current_dA;
+  sample.temperature_min_dC = status.temperature_min_dC;
+  sample.temperature_max_dC = status.temperature_max_dC;
+  mqtt_backlog_push(sample);
+}
 
-    for (const auto& event : order_events) {
+static void write_backlog_batch(uint16_t count) {
+  static const char* const fields[] = {"millis",          "SOC",
+                                       "stat_batt_power", "battery_voltage",
+                                       "battery_current", "temperature_min",
+                                       "temperature_max", "remaining_capacity",
+                                       "charged_energy",  "discharged_energy"};
+  char number[12];
+
+  json.reset();
+  json.begin_object();
+  json.key("millis");
+  snprintf(number, sizeof(number), "%lu", (unsigned long)millis());
+  json.raw(number);
+  json.key("dropped");
+  snprintf(number, sizeof(number), "%lu", (unsigned long)mqtt_backlog_dropped());
+  json.raw(number);
+  json.key("fields");
+  json.begin_array();
+  for (const char* field : fields) {
+    json.value(field);
+  }
+  json.end_array();
+  json.key("samples");
+  json.begin_array();
+  for (uint16_t i = 0; i < count; i++) {
+    const MQTT_BACKLOG_SAMPLE_TYPE& sample = backlog_batch[i];
+    json.begin_array();
+    snprintf(number, sizeof(number), "%lu", (unsigned long)sample.millis);
+    json.raw(number);
+    json.value(sample.soc_pptt, 2);
+    json.value(sample.power_W);
+    json.value(sample.voltage_dV, 1);
+    json.value(sample.current_dA, 1);
+    json.value(sample.temperature_min_dC, 1);
+    json.value(sample.temperature_max_dC, 1);
+    json.value((int32_t)sample.remaining_capacity_Wh);
+    json.value(sample.total_charged_Wh);
+    json.value(sample.total_discharged_Wh);
+    json.end_array();
+  }
+  json.end_array();
+  json.end_object();
+}
 
-      EVENTS_ENUM_TYPE event_handle = event.event_handle;
-      event_pointer = event.event_pointer;
+/** Replay one batch of the backlog, oldest samples first */
+static bool publish_backlog(void) {
+  if (mqtt_backlog_size() == 0 || esp_mqtt_client_get_outbox_size(client) > MQTT_OUTBOX_LIMIT) {
+    return true;
+  }
 
-      doc["event_type"] = String(get_event_enum_string(event_handle));
-      doc["severity"] = String(get_event_level_string(event_handle));
-      doc["count"] = String(event_pointer->occurences);
-      doc["data"] = String(event_pointer->data);
-      doc["message"] = String(get_event_message_string(event_handle));
-      doc["millis"] = String(event_pointer->timestamp);
+  uint16_t count = mqtt_backlog_peek(backlog_batch, MQTT_BACKLOG_BATCH_SAMPLES);
+  if (count == 0) {
+    return false;
+  }
+  write_backlog_batch(count);
+  // Halve the batch until it fits in the MQTT buffer
+  while (json.overflowed() && count > 1) {
+    count /= 2;
+    write_backlog_batch(count);
+  }
 
-      serializeJson(doc, mqtt_msg);
-      if (!mqtt_publish(state_topic.c_str(), mqtt_msg, false)) {
+  if (json.overflowed() || !mqtt_publish(backlog_topic, mqtt_msg, false)) {
 #ifdef DEBUG_LOG
-        logging.println("Common info MQTT msg could not be sent");
+    logging.println("Backlog MQTT msg could not be sent");
 #endif  // DEBUG_LOG
-        return false;
-      } else {
-        set_event_MQTTpublished(event_handle);
-      }
-      doc.clear();
-      //clear the vector
-      order_events.clear();
-    }
-#ifdef HA_AUTODISCOVERY
+    return false;
   }
-#endif  // HA_AUTODISCOVERY
+  mqtt_backlog_pop(count);
   return true;
 }
+#endif  // MQTT_BACKLOG
+
+#ifdef MQTT_BATCH
+static void write_batch(uint16_t count) {
+  char number[12];
+
+  json.reset();
+  json.begin_object();
+  json.key("millis");
+  snprintf(number, sizeof(number), "%lu", (unsigned long)millis());
+  json.raw(number);
+  json.key("dropped");
+  snprintf(number, sizeof(number), "%lu", (unsigned long)mqtt_batch_dropped());
+  json.raw(number);
+
+  // Timestamps and values are each the oldest sample followed by the differences to the previous one
+  json.key("t");
+  json.begin_array();
+  snprintf(number, sizeof(number), "%lu", (unsigned long)mqtt_batch_millis(0));
+  json.raw(number);
+  for (uint16_t i = 1; i < count; i++) {
+    json.value((int32_t)(mqtt_batch_millis(i) - mqtt_batch_millis(i - 1)));
+  }
+  json.end_array();
+  for (uint8_t field = 0; field < MQTT_BATCH_FIELD_COUNT; field++) {
+    json.key(mqtt_batch_field_name(field));
+    json.begin_array();
+    json.value(mqtt_batch_value(0, field));
+    for (uint16_t i = 1; i < count; i++) {
+      json.value(mqtt_batch_value(i, field) - mqtt_batch_value(i - 1, field));
+    }
+    json.end_array();
+  }
+  json.end_object();
+}
 
-static bool publish_buttons_discovery(void) {
-#ifdef HA_AUTODISCOVERY
-  if (ha_buttons_published == false) {
+/** Send every sample taken since the last batch, oldest first, in as many messages as they need */
+static bool publish_batch(void) {
+  while (mqtt_batch_size() > 0) {
+    uint16_t count = mqtt_batch_size();
+    write_batch(count);
+    // Halve the batch until it fits in the MQTT buffer
+    while (json.overflowed() && count > 1) {
+      count /= 2;
+      write_batch(count);
+    }
+
+    if (json.overflowed() || !mqtt_publish(batch_topic, mqtt_msg, false)) {
 #ifdef DEBUG_LOG
-    logging.println("Publishing buttons discovery");
+      logging.println("Batch MQTT msg could not be sent");
 #endif  // DEBUG_LOG
-
-    static JsonDocument doc;
-    for (int i = 0; i < sizeof(buttonConfigs) / sizeof(buttonConfigs[0]); i++) {
-      SensorConfig& config = buttonConfigs[i];
-      doc["name"] = config.name;
-      doc["unique_id"] = object_id_prefix + config.object_id;
-      doc["command_topic"] = generateButtonTopic(config.object_id);
-      set_common_discovery_attributes(doc);
-      serializeJson(doc, mqtt_msg);
-      if (mqtt_publish(generateButtonAutoConfigTopic(config.object_id).c_str(), mqtt_msg, true)) {
-        ha_buttons_published = true;
-      } else {
-        return false;
-      }
-      doc.clear();
+      return false;
     }
+    mqtt_batch_pop(count);
   }
-#endif  // HA_AUTODISCOVERY
   return true;
 }
+#endif  // MQTT_BATCH
 
 static void subscribe() {
-  esp_mqtt_client_subscribe(client, (topic_name + "/command/+").c_str(), 1);
+  char topic[MQTT_TOPIC_LENGTH + 1];
+  snprintf(topic, sizeof(topic), "%s+", command_topic_prefix);
+  esp_mqtt_client_subscribe(client, topic, 1);
+#ifdef HA_AUTODISCOVERY
+  esp_mqtt_client_subscribe(client, "homeassistant/status", 1);
+#endif  // HA_AUTODISCOVERY
 }
 
-void mqtt_message_received(char* topic_raw, int topic_len, char* data, int data_len) {
-
-  char* topic = strndup(topic_raw, topic_len);
-
-#ifdef DEBUG_LOG
-  logging.printf("MQTT message arrived: [%.*s]\n", topic_len, topic);
-#endif  // DEBUG_LOG
+typedef struct {
+  const char* name;
+  MQTT_COMMAND command;
+} MQTT_COMMAND_NAME_TYPE;
 
+static const MQTT_COMMAND_NAME_TYPE command_names[] = {
 #ifdef REMOTE_BMS_RESET
-  const char* bmsreset_topic = generateButtonTopic("BMSRESET").c_str();
-  if (strcmp(topic, bmsreset_topic) == 0) {
-#ifdef DEBUG_LOG
-    logging.println("Triggering BMS reset");
-#endif  // DEBUG_LOG
-    start_bms_reset();
-  }
+    {"BMSRESET", MQTT_COMMAND_BMSRESET},
 #endif  // REMOTE_BMS_RESET
+    {"PAUSE", MQTT_COMMAND_PAUSE},
+    {"RESUME", MQTT_COMMAND_RESUME},
+    {"RESTART", MQTT_COMMAND_RESTART},
+    {"STOP", MQTT_COMMAND_STOP}};
+
+/** True when the received topic, which is not null terminated, is <topic>/command/<command> */
+static bool is_command(const char* topic, int topic_len, const char* command) {
+  size_t prefix_len = strlen(command_topic_prefix);
+  size_t command_len = strlen(command);
+  return (size_t)topic_len == prefix_len + command_len && memcmp(topic, command_topic_prefix, prefix_len) == 0 &&
+         memcmp(topic + prefix_len, command, command_len) == 0;
+}
 
-  if (strcmp(topic, generateButtonTopic("PAUSE").c_str()) == 0) {
-    setBatteryPause(true, false);
-  }
+void mqtt_message_received(char* topic, int topic_len, char* data, int data_len) {
 
-  if (strcmp(topic, generateButtonTopic("RESUME").c_str()) == 0) {
-    setBatteryPause(false, false, false);
-  }
+#ifdef DEBUG_LOG
+  logging.printf("MQTT message arrived: [%.*s]\n", topic_len, topic);
+#endif  // DEBUG_LOG
 
-  if (strcmp(topic, generateButtonTopic("RESTART").c_str()) == 0) {
-    setBatteryPause(true, true, true, false);
-    delay(1000);
-    ESP.restart();
+#ifdef HA_AUTODISCOVERY
+  // Home Assistant may have lost the retained configs when it restarted, send them all again
+  if ((size_t)topic_len == strlen("homeassistant/status") && memcmp(topic, "homeassistant/status", topic_len) == 0 &&
+      (size_t)data_len == strlen("online") && memcmp(data, "online", data_len) == 0) {
+    ha_discovery_restart = true;
   }
+#endif  // HA_AUTODISCOVERY
 
-  if (strcmp(topic, generateButtonTopic("STOP").c_str()) == 0) {
-    setBatteryPause(true, false, true);
+  for (const MQTT_COMMAND_NAME_TYPE& command : command_names) {
+    if (is_command(topic, topic_len, command.name)) {
+      if (!queue_mqtt_command(command.command)) {
+#ifdef DEBUG_LOG
+        logging.printf("MQTT command %s dropped, queue full\n", command.name);
+#endif  // DEBUG_LOG
+      }
+      return;
+    }
   }
 }
 
@@ -492,8 +1181,13 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
     case MQTT_EVENT_CONNECTED:
       clear_event(EVENT_MQTT_DISCONNECT);
       set_event(EVENT_MQTT_CONNECT, 0);
+#ifdef MQTT_BACKLOG
+      mqtt_connected = true;
+#endif  // MQTT_BACKLOG
+#ifdef MQTT_PUBLISH_ON_CHANGE
+      republish_requested = true;
+#endif  // MQTT_PUBLISH_ON_CHANGE
 
-      publish_buttons_discovery();
       subscribe();
 #ifdef DEBUG_LOG
       logging.println("MQTT connected");
@@ -501,6 +1195,9 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
       break;
     case MQTT_EVENT_DISCONNECTED:
       set_event(EVENT_MQTT_DISCONNECT, 0);
+#ifdef MQTT_BACKLOG
+      mqtt_connected = false;
+#endif  // MQTT_BACKLOG
 #ifdef DEBUG_LOG
       logging.println("MQTT disconnected!");
 #endif  // DEBUG_LOG
@@ -524,9 +1221,6 @@ static void mqtt_event_handler(void* handler_args, esp_event_base_t base, int32_
 
 void init_mqtt(void) {
 
-#ifdef HA_AUTODISCOVERY
-  create_sensor_configs();
-#endif  // HA_AUTODISCOVERY
 #ifdef MQTT_MANUAL_TOPIC_OBJECT_NAME
   // Use custom topic name, object ID prefix, and device name from user settings
   topic_name = mqtt_topic_name;
@@ -541,6 +1235,27 @@ void init_mqtt(void) {
   device_id = "battery-emulator";
 #endif
 
+  snprintf(status_topic, sizeof(status_topic), "%s/status", topic_name.c_str());
+  snprintf(info_topic, sizeof(info_topic), "%s/info", topic_name.c_str());
+  snprintf(power_topic, sizeof(power_topic), "%s/power", topic_name.c_str());
+  snprintf(events_topic, sizeof(events_topic), "%s/events", topic_name.c_str());
+  snprintf(cell_voltages_topic[0], sizeof(cell_voltages_topic[0]), "%s/spec_data", topic_name.c_str());
+#ifdef DOUBLE_BATTERY
+  snprintf(cell_voltages_topic[1], sizeof(cell_voltages_topic[1]), "%s/spec_data_2", topic_name.c_str());
+#endif  // DOUBLE_BATTERY
+  snprintf(command_topic_prefix, sizeof(command_topic_prefix), "%s/command/", topic_name.c_str());
+#ifdef MQTT_BACKLOG
+  snprintf(backlog_topic, sizeof(backlog_topic), "%s/backlog", topic_name.c_str());
+  init_mqtt_backlog();
+#endif  // MQTT_BACKLOG
+#ifdef MQTT_BATCH
+  snprintf(batch_topic, sizeof(batch_topic), "%s/batch", topic_name.c_str());
+#endif  // MQTT_BATCH
+  order_events.reserve(EVENT_NOF_EVENTS);
+#ifdef HA_AUTODISCOVERY
+  render_ha_device_members();
+#endif  // HA_AUTODISCOVERY
+
   char clientId[64];  // Adjust the size as needed
   snprintf(clientId, sizeof(clientId), "BatteryEmulatorClient-%s", WiFi.getHostname());
   mqtt_cfg.broker.address.transport = MQTT_TRANSPORT_OVER_TCP;
@@ -549,8 +1264,7 @@ void init_mqtt(void) {
   mqtt_cfg.credentials.client_id = clientId;
   mqtt_cfg.credentials.username = MQTT_USER;
   mqtt_cfg.credentials.authentication.password = MQTT_PASSWORD;
-  lwt_topic = topic_name + "/status";
-  mqtt_cfg.session.last_will.topic = lwt_topic.c_str();
+  mqtt_cfg.session.last_will.topic = status_topic;
   mqtt_cfg.session.last_will.qos = 1;
   mqtt_cfg.session.last_will.retain = true;
   mqtt_cfg.session.last_will.msg = "offline";
@@ -560,22 +1274,61 @@ void init_mqtt(void) {
   esp_mqtt_client_register_event(client, MQTT_EVENT_ANY, mqtt_event_handler, client);
 }
 
+#ifdef FUNCTION_TIME_MEASUREMENT
+static void measure_publish_heap(uint32_t free_heap_before) {
+  uint32_t free_heap = ESP.getFreeHeap();
+  int32_t heap_drop = (int32_t)(free_heap_before - free_heap);
+  if (heap_drop > datalayer.system.status.mqtt_publish_heap_10s_max) {
+    datalayer.system.status.mqtt_publish_heap_10s_max = heap_drop;
+  }
+  if (free_heap > 0) {
+    datalayer.system.status.heap_fragmentation_pct = 100 - (uint8_t)((uint64_t)ESP.getMaxAllocHeap() * 100 / free_heap);
+  }
+}
+#endif  // FUNCTION_TIME_MEASUREMENT
+
 void mqtt_loop(void) {
+#ifdef MQTT_BACKLOG
+  if (backlog_sample_timer.elapsed() && (!mqtt_connected || WiFi.status() != WL_CONNECTED)) {
+    store_backlog_sample();
+  }
+#endif  // MQTT_BACKLOG
+
   // Only attempt to publish/reconnect MQTT if Wi-Fi is connectedand checkTimmer is elapsed
   if (check_global_timer.elapsed() && WiFi.status() == WL_CONNECTED) {
 
     if (client_started == false) {
       esp_mqtt_client_start(client);
       client_started = true;
+      stagger_schedules();
 #ifdef DEBUG_LOG
       logging.println("MQTT initialized");
 #endif  // DEBUG_LOG
       return;
     }
 
-    if (publish_global_timer.elapsed())  // Every 5s
-    {
-      publish_values();
+#ifdef MQTT_PUBLISH_ON_CHANGE
+    if (republish_requested.exchange(false)) {
+      reset_published();
+    }
+#endif  // MQTT_PUBLISH_ON_CHANGE
+#ifdef FUNCTION_TIME_MEASUREMENT
+    uint32_t free_heap_before = ESP.getFreeHeap();
+#endif  // FUNCTION_TIME_MEASUREMENT
+    publish_values();
+#ifdef FUNCTION_TIME_MEASUREMENT
+    measure_publish_heap(free_heap_before);
+#endif  // FUNCTION_TIME_MEASUREMENT
+
+    if (background_timer.elapsed()) {
+#ifdef HA_AUTODISCOVERY
+      publish_ha_discovery();
+#endif  // HA_AUTODISCOVERY
+#ifdef MQTT_BACKLOG
+      if (mqtt_connected) {
+        publish_backlog();
+      }
+#endif  // MQTT_BACKLOG
     }
   }
 }
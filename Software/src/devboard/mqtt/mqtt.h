@@ -39,6 +39,40 @@
 #include "../../include.h"
 
 #define MQTT_MSG_BUFFER_SIZE (1024)
+#define MQTT_TOPIC_LENGTH (96)
+
+// Payload formats for MQTT_CELL_VOLTAGE_FORMAT in USER_SETTINGS.h
+#define MQTT_CELL_FORMAT_VOLTS 0       // {"cell_voltages":[3.712,3.715,..]}
+#define MQTT_CELL_FORMAT_MILLIVOLTS 1  // {"cell_voltages_mV":[3712,3715,..]}
+#define MQTT_CELL_FORMAT_BASE64 2      // {"cell_voltages_b64":"gA6DDg.."}, little endian uint16 mV
+#define MQTT_CELL_FORMAT_DELTA 3       // {"cell_base_mV":[3712,..],"cell_deltas_mV":[0,3,..]}, lowest cell per module
+// When a whole pack could exceed MQTT_MSG_BUFFER_SIZE, every MQTT_CELLS_PER_MODULE cells go to <spec_data>/<module>
+// with "first_cell" added, module numbering starts at 1
+
+// mqtt_loop() checks the publish schedules (MQTT_*_INTERVAL_MS in USER_SETTINGS.h) this often
+#define MQTT_CHECK_INTERVAL_MS 100
+
+// Home Assistant discovery is sent a few messages per 800ms
+#define HA_DISCOVERY_MESSAGES_PER_CYCLE 8
+// Background traffic (discovery, backlog replay) waits while the MQTT outbox holds more bytes than this
+#define MQTT_OUTBOX_LIMIT (4 * MQTT_MSG_BUFFER_SIZE)
+
+// With MQTT_BACKLOG, samples taken while disconnected are replayed oldest first, one batch per 800ms:
+// {"millis":<now>,"dropped":<lost since boot>,"fields":["millis","SOC",..],"samples":[[<millis>,50.12,..],..]}
+// Sample time is the receive time minus (now - sample millis)
+#define MQTT_BACKLOG_BATCH_SAMPLES 16
+
+// Fields for MQTT_BATCH_FIELDS in USER_SETTINGS.h, sampled from the first battery in raw datalayer units
+#define MQTT_BATCH_POWER (1 << 0)        // "power_W"
+#define MQTT_BATCH_CURRENT (1 << 1)      // "current_dA"
+#define MQTT_BATCH_VOLTAGE (1 << 2)      // "voltage_dV"
+#define MQTT_BATCH_SOC (1 << 3)          // "soc_pptt", reported SOC
+#define MQTT_BATCH_CELL_MIN (1 << 4)     // "cell_min_mV"
+#define MQTT_BATCH_CELL_MAX (1 << 5)     // "cell_max_mV"
+#define MQTT_BATCH_TEMPERATURE (1 << 6)  // "temperature_max_dC"
+// With MQTT_BATCH the samples go to <topic>/batch every MQTT_BATCH_INTERVAL_MS, split over several messages if needed:
+// {"millis":<now>,"dropped":<lost since boot>,"t":[<millis>,100,..],"power_W":[-1234,5,..],"current_dA":[..]}
+// Every array starts with the value of the oldest sample and continues with the difference to the previous sample
 
 extern const char* version_number;  // The current software version, used for mqtt
 
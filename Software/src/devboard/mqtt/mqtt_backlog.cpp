@@ -0,0 +1,138 @@
+#include "mqtt_backlog.h"
+
+#ifdef MQTT_BACKLOG
+
+#if defined(MQTT_BACKLOG_TO_SD) && defined(SD_CS_PIN) && defined(SD_SCLK_PIN) && defined(SD_MOSI_PIN) && \
+    defined(SD_MISO_PIN)
+#define MQTT_BACKLOG_SD
+#include "../sdcard/sdcard.h"
+#endif
+
+/** Fixed size ring of samples, head is the oldest */
+typedef struct {
+  uint32_t head;
+  uint32_t count;
+  uint32_t capacity;
+} BACKLOG_RING_TYPE;
+
+static MQTT_BACKLOG_SAMPLE_TYPE ram_samples[MQTT_BACKLOG_SAMPLES];
+static BACKLOG_RING_TYPE ram_ring = {0, 0, MQTT_BACKLOG_SAMPLES};
+static uint32_t dropped = 0;
+
+static uint32_t ring_slot(const BACKLOG_RING_TYPE& ring, uint32_t offset) {
+  return (ring.head + offset) % ring.capacity;
+}
+
+static void ring_pop(BACKLOG_RING_TYPE& ring, uint32_t count) {
+  ring.head = ring_slot(ring, count);
+  ring.count -= count;
+}
+
+#ifdef MQTT_BACKLOG_SD
+// Samples older than everything in RAM, in a file used as a ring of fixed size records
+#define MQTT_BACKLOG_FILE "/mqtt_backlog.bin"
+
+static File sd_file;
+static bool sd_file_open = false;
+static BACKLOG_RING_TYPE sd_ring = {0, 0, MQTT_BACKLOG_SD_SAMPLES};
+
+static bool open_sd_file(void) {
+  if (!sd_file_open && is_sdcard_active()) {
+    // Whatever was left from before a reboot has no matching ring position, start empty
+    sd_file = SD_MMC.open(MQTT_BACKLOG_FILE, "w+");
+    sd_file_open = sd_file;
+  }
+  return sd_file_open;
+}
+
+static bool write_sd_sample(uint32_t slot, const MQTT_BACKLOG_SAMPLE_TYPE& sample) {
+  return sd_file.seek(slot * sizeof(sample)) &&
+         sd_file.write((const uint8_t*)&sample, sizeof(sample)) == sizeof(sample);
+}
+
+static bool read_sd_sample(uint32_t slot, MQTT_BACKLOG_SAMPLE_TYPE& sample) {
+  return sd_file.seek(slot * sizeof(sample)) && sd_file.read((uint8_t*)&sample, sizeof(sample)) == sizeof(sample);
+}
+
+/** Move the oldest RAM sample to the SD card, false if it has to be dropped instead */
+static bool spill_to_sd(void) {
+  if (!open_sd_file()) {
+    return false;
+  }
+  if (sd_ring.count == sd_ring.capacity) {
+    ring_pop(sd_ring, 1);
+    dropped++;
+  }
+  if (!write_sd_sample(ring_slot(sd_ring, sd_ring.count), ram_samples[ram_ring.head])) {
+#ifdef DEBUG_LOG
+    logging.println("MQTT backlog could not be written to SD card");
+#endif  // DEBUG_LOG
+    return false;
+  }
+  sd_file.flush();
+  sd_ring.count++;
+  return true;
+}
+#endif  // MQTT_BACKLOG_SD
+
+void init_mqtt_backlog(void) {
+#if defined(MQTT_BACKLOG_SD) && !defined(LOG_TO_SD) && !defined(LOG_CAN_TO_SD)
+  init_sdcard();  // Otherwise the logging task brings up the card
+#endif
+}
+
+void mqtt_backlog_push(const MQTT_BACKLOG_SAMPLE_TYPE& sample) {
+  if (ram_ring.count == ram_ring.capacity) {
+#ifdef MQTT_BACKLOG_SD
+    if (!spill_to_sd()) {
+      dropped++;
+    }
+#else
+    dropped++;
+#endif  // MQTT_BACKLOG_SD
+    ring_pop(ram_ring, 1);
+  }
+  ram_samples[ring_slot(ram_ring, ram_ring.count)] = sample;
+  ram_ring.count++;
+}
+
+uint16_t mqtt_backlog_peek(MQTT_BACKLOG_SAMPLE_TYPE* samples, uint16_t max_count) {
+  uint16_t copied = 0;
+#ifdef MQTT_BACKLOG_SD
+  while (copied < max_count && copied < sd_ring.count) {
+    if (!read_sd_sample(ring_slot(sd_ring, copied), samples[copied])) {
+      return copied;  // Send what could be read, the rest is retried with the next batch
+    }
+    copied++;
+  }
+  if (copied < sd_ring.count) {
+    return copied;
+  }
+#endif  // MQTT_BACKLOG_SD
+  for (uint32_t i = 0; copied < max_count && i < ram_ring.count; i++) {
+    samples[copied++] = ram_samples[ring_slot(ram_ring, i)];
+  }
+  return copied;
+}
+
+void mqtt_backlog_pop(uint16_t count) {
+#ifdef MQTT_BACKLOG_SD
+  uint16_t from_sd = min((uint32_t)count, sd_ring.count);
+  ring_pop(sd_ring, from_sd);
+  count -= from_sd;
+#endif  // MQTT_BACKLOG_SD
+  ring_pop(ram_ring, min((uint32_t)count, ram_ring.count));
+}
+
+uint32_t mqtt_backlog_size(void) {
+#ifdef MQTT_BACKLOG_SD
+  return ram_ring.count + sd_ring.count;
+#else
+  return ram_ring.count;
+#endif  // MQTT_BACKLOG_SD
+}
+
+uint32_t mqtt_backlog_dropped(void) {
+  return dropped;
+}
+#endif  // MQTT_BACKLOG
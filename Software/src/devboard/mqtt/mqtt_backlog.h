@@ -0,0 +1,43 @@
+#ifndef __MQTT_BACKLOG_H__
+#define __MQTT_BACKLOG_H__
+
+#include "../../include.h"
+
+#ifdef MQTT_BACKLOG
+
+/** Telemetry kept while the broker is unreachable, in the raw datalayer units */
+typedef struct {
+  uint32_t millis;
+  int32_t power_W;
+  uint32_t remaining_capacity_Wh;
+  int32_t total_charged_Wh;
+  int32_t total_discharged_Wh;
+  uint16_t soc_pptt;
+  uint16_t voltage_dV;
+  int16_t current_dA;
+  int16_t temperature_min_dC;
+  int16_t temperature_max_dC;
+} MQTT_BACKLOG_SAMPLE_TYPE;
+
+void init_mqtt_backlog(void);
+
+/** Queue a sample, dropping the oldest one when the backlog is full */
+void mqtt_backlog_push(const MQTT_BACKLOG_SAMPLE_TYPE& sample);
+
+/**
+ * @brief Copy the oldest samples without removing them
+ *
+ * @return Number of samples copied, at most max_count
+ */
+uint16_t mqtt_backlog_peek(MQTT_BACKLOG_SAMPLE_TYPE* samples, uint16_t max_count);
+
+/** Remove the oldest count samples, once they have been sent */
+void mqtt_backlog_pop(uint16_t count);
+
+uint32_t mqtt_backlog_size(void);
+
+/** Samples lost because the backlog was full, since boot */
+uint32_t mqtt_backlog_dropped(void);
+
+#endif  // MQTT_BACKLOG
+#endif  // __MQTT_BACKLOG_H__
@@ -0,0 +1,112 @@
+#include "mqtt_batch.h"
+#include <atomic>
+#include "../utils/timer.h"
+
+#ifdef MQTT_BATCH
+
+typedef struct {
+  uint32_t bit;
+  const char* name;
+} MQTT_BATCH_FIELD_TYPE;
+
+// Same order as the MQTT_BATCH_* bits in mqtt.h
+static const MQTT_BATCH_FIELD_TYPE batch_fields[] = {
+    {MQTT_BATCH_POWER, "power_W"},
+    {MQTT_BATCH_CURRENT, "current_dA"},
+    {MQTT_BATCH_VOLTAGE, "voltage_dV"},
+    {MQTT_BATCH_SOC, "soc_pptt"},
+    {MQTT_BATCH_CELL_MIN, "cell_min_mV"},
+    {MQTT_BATCH_CELL_MAX, "cell_max_mV"},
+    {MQTT_BATCH_TEMPERATURE, "temperature_max_dC"},
+};
+
+// Single producer (core task), single consumer (MQTT task). One slot stays empty to tell full from empty.
+#define MQTT_BATCH_SLOTS (MQTT_BATCH_SAMPLES + 1)
+static uint32_t sample_millis[MQTT_BATCH_SLOTS];
+static int32_t sample_values[MQTT_BATCH_SLOTS][MQTT_BATCH_FIELD_COUNT];
+static std::atomic<uint16_t> head(0);  // Oldest sample, only written by the MQTT task
+static std::atomic<uint16_t> tail(0);  // Next free slot, only written by the core task
+static std::atomic<uint32_t> dropped(0);
+static MyTimer sample_timer(MQTT_BATCH_SAMPLE_INTERVAL_MS);
+
+static int32_t read_field(uint32_t bit, const DATALAYER_BATTERY_STATUS_TYPE& status) {
+  switch (bit) {
+    case MQTT_BATCH_POWER:
+      return status.active_power_W;
+    case MQTT_BATCH_CURRENT:
+      return status.current_dA;
+    case MQTT_BATCH_VOLTAGE:
+      return status.voltage_dV;
+    case MQTT_BATCH_SOC:
+      return status.reported_soc;
+    case MQTT_BATCH_CELL_MIN:
+      return status.cell_min_voltage_mV;
+    case MQTT_BATCH_CELL_MAX:
+      return status.cell_max_voltage_mV;
+    case MQTT_BATCH_TEMPERATURE:
+      return status.temperature_max_dC;
+    default:
+      return 0;
+  }
+}
+
+static uint16_t slot(uint16_t index) {
+  return (head.load(std::memory_order_relaxed) + index) % MQTT_BATCH_SLOTS;
+}
+
+void mqtt_batch_sample(void) {
+  if (!sample_timer.elapsed()) {
+    return;
+  }
+  const DATALAYER_BATTERY_STATUS_TYPE& status = datalayer.battery.status;
+  if (!status.CAN_battery_still_alive) {
+    return;  // A gap is better than repeating stale values
+  }
+  const uint16_t next = tail.load(std::memory_order_relaxed);
+  const uint16_t after = (next + 1) % MQTT_BATCH_SLOTS;
+  if (after == head.load(std::memory_order_acquire)) {
+    // Only the MQTT task may drop the oldest samples, so the newest one is lost instead
+    dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  sample_millis[next] = millis();
+  uint8_t field = 0;
+  for (const MQTT_BATCH_FIELD_TYPE& batch_field : batch_fields) {
+    if (MQTT_BATCH_FIELDS & batch_field.bit) {
+      sample_values[next][field++] = read_field(batch_field.bit, status);
+    }
+  }
+  tail.store(after, std::memory_order_release);
+}
+
+uint16_t mqtt_batch_size(void) {
+  const uint16_t first = head.load(std::memory_order_relaxed);
+  return (tail.load(std::memory_order_acquire) + MQTT_BATCH_SLOTS - first) % MQTT_BATCH_SLOTS;
+}
+
+uint32_t mqtt_batch_millis(uint16_t index) {
+  return sample_millis[slot(index)];
+}
+
+int32_t mqtt_batch_value(uint16_t index, uint8_t field) {
+  return sample_values[slot(index)][field];
+}
+
+const char* mqtt_batch_field_name(uint8_t field) {
+  for (const MQTT_BATCH_FIELD_TYPE& batch_field : batch_fields) {
+    if ((MQTT_BATCH_FIELDS & batch_field.bit) && field-- == 0) {
+      return batch_field.name;
+    }
+  }
+  return "";
+}
+
+void mqtt_batch_pop(uint16_t pop_count) {
+  pop_count = min(pop_count, mqtt_batch_size());
+  head.store(slot(pop_count), std::memory_order_release);
+}
+
+uint32_t mqtt_batch_dropped(void) {
+  return dropped.load(std::memory_order_relaxed);
+}
+#endif  // MQTT_BATCH
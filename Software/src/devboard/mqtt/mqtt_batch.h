@@ -0,0 +1,39 @@
+#ifndef __MQTT_BATCH_H__
+#define __MQTT_BATCH_H__
+
+#include "../../datalayer/datalayer.h"
+#include "mqtt.h"
+
+#ifdef MQTT_BATCH
+
+// Every MQTT_BATCH_SAMPLE_INTERVAL_MS a sample of the MQTT_BATCH_FIELDS is taken, this many are kept until sent
+#define MQTT_BATCH_SAMPLES (2 * MQTT_BATCH_INTERVAL_MS / MQTT_BATCH_SAMPLE_INTERVAL_MS)
+#define MQTT_BATCH_FIELD_COUNT __builtin_popcount(MQTT_BATCH_FIELDS)
+
+/**
+ * @brief Sample the selected fields of the first battery every MQTT_BATCH_SAMPLE_INTERVAL_MS, skipped while it
+ *        does not answer. Called from the core task, which owns the live datalayer values; the MQTT task reads the
+ *        samples with the functions below.
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void mqtt_batch_sample(void);
+
+/** Number of samples waiting, index 0 below is the oldest. Only for the MQTT task, like the rest below */
+uint16_t mqtt_batch_size(void);
+uint32_t mqtt_batch_millis(uint16_t index);
+/** Value of a field in raw datalayer units, fields are numbered in the order of the selected MQTT_BATCH_* bits */
+int32_t mqtt_batch_value(uint16_t index, uint8_t field);
+/** Name for the payload, with the unit, for example "current_dA" */
+const char* mqtt_batch_field_name(uint8_t field);
+
+/** Remove the oldest count samples, once they have been sent */
+void mqtt_batch_pop(uint16_t count);
+
+/** Samples not taken because the buffer was full, since boot */
+uint32_t mqtt_batch_dropped(void);
+
+#endif  // MQTT_BATCH
+#endif  // __MQTT_BATCH_H__
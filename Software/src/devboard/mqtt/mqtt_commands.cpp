@@ -0,0 +1,93 @@
+#include "mqtt_commands.h"
+#include <atomic>
+#include "../../communication/contactorcontrol/comm_contactorcontrol.h"
+#include "../../communication/nvm/comm_nvm.h"
+#include "../../datalayer/datalayer.h"
+#include "../utils/value_mapping.h"
+#include "esp_timer.h"
+
+#define MQTT_COMMAND_QUEUE_SIZE 8
+#define MQTT_RESTART_DELAY_MS 1000  // Time for the pause to reach the inverter before restarting
+
+typedef struct {
+  MQTT_COMMAND command;
+  int64_t received_us;
+} MQTT_COMMAND_MESSAGE_TYPE;
+
+// Single producer (MQTT event task), single consumer (core task). One slot stays empty to tell full from empty.
+static MQTT_COMMAND_MESSAGE_TYPE queue[MQTT_COMMAND_QUEUE_SIZE];
+static std::atomic<uint8_t> queue_head(0);  // Next message to execute, only written by the core task
+static std::atomic<uint8_t> queue_tail(0);  // Next free slot, only written by the MQTT task
+
+static bool restart_pending = false;
+static unsigned long restart_requested_ms = 0;
+
+bool queue_mqtt_command(MQTT_COMMAND command) {
+  uint8_t tail = queue_tail.load(std::memory_order_relaxed);
+  uint8_t next = (tail + 1) % MQTT_COMMAND_QUEUE_SIZE;
+  if (next == queue_head.load(std::memory_order_acquire)) {
+    return false;
+  }
+  queue[tail].command = command;
+  queue[tail].received_us = esp_timer_get_time();
+  queue_tail.store(next, std::memory_order_release);
+  return true;
+}
+
+static void execute_mqtt_command(MQTT_COMMAND command) {
+  switch (command) {
+    case MQTT_COMMAND_BMSRESET:
+#ifdef REMOTE_BMS_RESET
+#ifdef DEBUG_LOG
+      logging.println("Triggering BMS reset");
+#endif  // DEBUG_LOG
+      start_bms_reset();
+#endif  // REMOTE_BMS_RESET
+      break;
+    case MQTT_COMMAND_PAUSE:
+      setBatteryPause(true, false);
+      break;
+    case MQTT_COMMAND_RESUME:
+      setBatteryPause(false, false, false);
+      break;
+    case MQTT_COMMAND_RESTART:
+      setBatteryPause(true, true, true, false);
+      // Restart from a later tick instead of blocking the core task while the pause goes out
+      restart_pending = true;
+      restart_requested_ms = millis();
+      break;
+    case MQTT_COMMAND_STOP:
+      setBatteryPause(true, false, true);
+      break;
+  }
+}
+
+void handle_mqtt_commands(void) {
+  if (restart_pending && millis() - restart_requested_ms >= MQTT_RESTART_DELAY_MS) {
+    // Commit any settings still waiting for the debounce time
+    store_settings();
+    ESP.restart();
+  }
+
+  uint8_t head = queue_head.load(std::memory_order_relaxed);
+  while (head != queue_tail.load(std::memory_order_acquire)) {
+    const MQTT_COMMAND_MESSAGE_TYPE& message = queue[head];
+    execute_mqtt_command(message.command);
+
+#if defined(FUNCTION_TIME_MEASUREMENT) || defined(DEBUG_LOG)
+    // From arrival on the MQTT task until the command has taken effect on the core task
+    int64_t latency_us = esp_timer_get_time() - message.received_us;
+#ifdef FUNCTION_TIME_MEASUREMENT
+    datalayer.system.status.mqtt_command_latency_us = latency_us;
+    datalayer.system.status.mqtt_command_latency_max_us =
+        max(datalayer.system.status.mqtt_command_latency_max_us, latency_us);
+#endif  // FUNCTION_TIME_MEASUREMENT
+#ifdef DEBUG_LOG
+    logging.printf("MQTT command %d executed after %d us\n", (int)message.command, (int)latency_us);
+#endif  // DEBUG_LOG
+#endif  // FUNCTION_TIME_MEASUREMENT || DEBUG_LOG
+
+    head = (head + 1) % MQTT_COMMAND_QUEUE_SIZE;
+    queue_head.store(head, std::memory_order_release);
+  }
+}
@@ -0,0 +1,28 @@
+#ifndef __MQTT_COMMANDS_H__
+#define __MQTT_COMMANDS_H__
+
+#include "../../include.h"
+
+/** Commands received on <topic>/command/<name> */
+enum MQTT_COMMAND {
+  MQTT_COMMAND_BMSRESET,
+  MQTT_COMMAND_PAUSE,
+  MQTT_COMMAND_RESUME,
+  MQTT_COMMAND_RESTART,
+  MQTT_COMMAND_STOP
+};
+
+/**
+ * @brief Hand a command over to the core task, called from the MQTT event task
+ *
+ * Nothing is executed here, the command waits in a lock-free queue until the next core_loop() tick picks it up with
+ * handle_mqtt_commands(), so all state changes happen on the core task.
+ *
+ * @return false if the queue is full and the command was dropped
+ */
+bool queue_mqtt_command(MQTT_COMMAND command);
+
+/** Execute queued commands in the order they arrived, called at the start of every core_loop() tick */
+void handle_mqtt_commands(void);
+
+#endif  // __MQTT_COMMANDS_H__
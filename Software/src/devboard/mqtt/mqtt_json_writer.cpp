@@ -0,0 +1,145 @@
+#include "mqtt_json_writer.h"
+
+MqttJsonWriter::MqttJsonWriter(char* buffer, size_t size) : buffer(buffer), size(size) {
+  reset();
+}
+
+void MqttJsonWriter::reset(void) {
+  used = 0;
+  overflow = false;
+  has_element = 0;
+  depth = 0;
+  after_key = false;
+  if (size > 0) {
+    buffer[0] = '\0';
+  }
+}
+
+void MqttJsonWriter::append(char c) {
+  if (overflow || used + 1 >= size) {
+    overflow = true;
+    return;
+  }
+  buffer[used++] = c;
+  buffer[used] = '\0';
+}
+
+void MqttJsonWriter::append(const char* text) {
+  while (*text != '\0') {
+    append(*text++);
+  }
+}
+
+void MqttJsonWriter::separate(void) {
+  if (after_key) {
+    after_key = false;  // Value of a key, the comma was written before the key
+    return;
+  }
+  uint32_t bit = 1UL << depth;
+  if (has_element & bit) {
+    append(',');
+  }
+  has_element |= bit;
+}
+
+void MqttJsonWriter::begin_object(void) {
+  separate();
+  append('{');
+  depth++;
+  has_element &= ~(1UL << depth);
+}
+
+void MqttJsonWriter::end_object(void) {
+  depth--;
+  append('}');
+}
+
+void MqttJsonWriter::begin_array(void) {
+  separate();
+  append('[');
+  depth++;
+  has_element &= ~(1UL << depth);
+}
+
+void MqttJsonWriter::end_array(void) {
+  depth--;
+  append(']');
+}
+
+void MqttJsonWriter::key(const char* name, const char* suffix) {
+  separate();
+  append('"');
+  append(name);
+  append(suffix);
+  append("\":");
+  after_key = true;
+}
+
+void MqttJsonWriter::value(int32_t raw, uint8_t decimals) {
+  separate();
+  char digits[12];
+  uint8_t count = 0;
+  uint32_t magnitude = raw < 0 ? 0u - (uint32_t)raw : (uint32_t)raw;
+  // Collect the digits in reverse, at least one more than the decimals so there is a leading zero
+  do {
+    digits[count++] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0 || count <= decimals);
+
+  // Drop trailing zeros of the fraction
+  uint8_t skip = 0;
+  while (skip < decimals && digits[skip] == '0') {
+    skip++;
+  }
+  if (raw < 0) {
+    append('-');
+  }
+  for (uint8_t i = count; i > skip; i--) {
+    if (i == decimals) {
+      append('.');
+    }
+    append(digits[i - 1]);
+  }
+}
+
+void MqttJsonWriter::value_base64(const uint8_t* data, size_t length) {
+  static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+  separate();
+  append('"');
+  for (size_t i = 0; i < length; i += 3) {
+    uint32_t chunk = (uint32_t)data[i] << 16;
+    if (i + 1 < length) {
+      chunk |= (uint32_t)data[i + 1] << 8;
+    }
+    if (i + 2 < length) {
+      chunk |= data[i + 2];
+    }
+    append(alphabet[(chunk >> 18) & 0x3F]);
+    append(alphabet[(chunk >> 12) & 0x3F]);
+    append(i + 1 < length ? alphabet[(chunk >> 6) & 0x3F] : '=');
+    append(i + 2 < length ? alphabet[chunk & 0x3F] : '=');
+  }
+  append('"');
+}
+
+void MqttJsonWriter::value(const char* text) {
+  separate();
+  append('"');
+  for (; *text != '\0'; text++) {
+    char c = *text;
+    if (c == '"' || c == '\\') {
+      append('\\');
+      append(c);
+    } else if ((uint8_t)c < 0x20) {
+      append(' ');  // Control characters never belong in our payloads
+    } else {
+      append(c);
+    }
+  }
+  append('"');
+}
+
+void MqttJsonWriter::raw(const char* text) {
+  separate();
+  append(text);
+}
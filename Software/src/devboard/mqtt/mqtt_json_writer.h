@@ -0,0 +1,58 @@
+#ifndef __MQTT_JSON_WRITER_H__
+#define __MQTT_JSON_WRITER_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Writes JSON straight into a caller owned buffer, so building a payload never touches the heap.
+ *
+ * Numbers are written from fixed point integers (for example 3712 with 3 decimals is 3.712), which
+ * matches the raw units kept in the datalayer and avoids float formatting. Trailing zeros are
+ * dropped, so 3700 with 3 decimals is written as 3.7.
+ *
+ * If the buffer runs out the writer stops writing and overflowed() returns true, the partial
+ * payload must not be published.
+ */
+class MqttJsonWriter {
+ public:
+  MqttJsonWriter(char* buffer, size_t size);
+
+  /** Start over with an empty buffer */
+  void reset(void);
+
+  void begin_object(void);
+  void end_object(void);
+  void begin_array(void);
+  void end_array(void);
+
+  /** Write "name suffix": , the value or container must follow */
+  void key(const char* name, const char* suffix = "");
+
+  void value(int32_t raw, uint8_t decimals = 0);
+  void value(const char* text);
+  /** Write the bytes as a base64 string */
+  void value_base64(const uint8_t* data, size_t length);
+  /** Write already formatted JSON as is, a value after key() or "key":value members inside an object */
+  void raw(const char* text);
+
+  bool overflowed(void) const { return overflow; }
+  size_t length(void) const { return used; }
+  const char* c_str(void) const { return buffer; }
+
+ private:
+  void separate(void);
+  void append(char c);
+  void append(const char* text);
+
+  char* buffer;
+  size_t size;
+  size_t used;
+  bool overflow;
+  /** One bit per nesting level, set once the level has an element and the next one needs a comma */
+  uint32_t has_element;
+  uint8_t depth;
+  bool after_key;
+};
+
+#endif  // __MQTT_JSON_WRITER_H__
@@ -1,5 +1,6 @@
 #include "../../datalayer/datalayer.h"
 #include "../utils/events.h"
+#include "esp_timer.h"
 
 static uint16_t cell_deviation_mV = 0;
 static uint8_t charge_limit_failures = 0;
@@ -18,6 +19,16 @@ bool allowed_to_send_CAN = true;
 battery_pause_status emulator_pause_status = NORMAL;
 //battery pause status end
 
+/** A limit cut by writing 0 W also needs 0 A, for inverters that are sent currents. Shared by both safety paths */
+static void zero_current_limits_without_power(DATALAYER_BATTERY_STATUS_TYPE& status) {
+  if (status.max_discharge_power_W == 0) {
+    status.max_discharge_current_dA = 0;
+  }
+  if (status.max_charge_power_W == 0) {
+    status.max_charge_current_dA = 0;
+  }
+}
+
 void update_machineryprotection() {
   // Check if the CPU is too hot
   if (datalayer.system.info.CPU_temperature > 80.0f) {
@@ -293,12 +304,7 @@ void update_machineryprotection() {
 #endif  // DOUBLE_BATTERY
 
   //Safeties verified, Zero charge/discharge ampere values incase any safety wrote the W to 0
-  if (datalayer.battery.status.max_discharge_power_W == 0) {
-    datalayer.battery.status.max_discharge_current_dA = 0;
-  }
-  if (datalayer.battery.status.max_charge_power_W == 0) {
-    datalayer.battery.status.max_charge_current_dA = 0;
-  }
+  zero_current_limits_without_power(datalayer.battery.status);
 
   //Decrement the forced balancing timer incase user requested it
   if (datalayer.battery.settings.user_requests_balancing) {
@@ -321,6 +327,43 @@ void update_machineryprotection() {
   }
 }
 
+void update_fast_safety(int64_t frame_us) {
+  DATALAYER_BATTERY_STATUS_TYPE& status = datalayer.battery.status;
+  const DATALAYER_BATTERY_INFO_TYPE& info = datalayer.battery.info;
+
+  // Same conditions as update_machineryprotection(), where a battery overheat event is an error that faults the BMS
+  const bool stop =
+      emulator_pause_request_ON || (status.bms_status == FAULT) || (status.temperature_max_dC > BATTERY_MAXTEMPERATURE);
+  const bool stop_charge = stop || (status.voltage_dV > info.max_design_voltage_dV) ||
+                           (status.cell_max_voltage_mV >= info.max_cell_voltage_mV);
+  const bool stop_discharge = stop || (status.voltage_dV < info.min_design_voltage_dV) ||
+                              (status.cell_min_voltage_mV <= info.min_cell_voltage_mV);
+
+  // Only a limit that is not already zero needs the inverter mapping redone, so this is a few compares per call.
+  // Both paths cut the power and then the currents along with it, so the power alone tells whether anything changed
+  const bool cut_charge = stop_charge && (status.max_charge_power_W != 0);
+  const bool cut_discharge = stop_discharge && (status.max_discharge_power_W != 0);
+  if (!cut_charge && !cut_discharge) {
+    return;
+  }
+  if (cut_charge) {
+    status.max_charge_power_W = 0;
+  }
+  if (cut_discharge) {
+    status.max_discharge_power_W = 0;
+  }
+  zero_current_limits_without_power(status);
+  update_values_inverter();
+
+  datalayer.system.status.safety_fast_cuts++;
+  if (frame_us != 0) {
+    const int64_t latency_us = esp_timer_get_time() - frame_us;
+    datalayer.system.status.safety_cut_latency_us = latency_us;
+    datalayer.system.status.safety_cut_latency_max_us =
+        max(datalayer.system.status.safety_cut_latency_max_us, latency_us);
+  }
+}
+
 //battery pause status begin
 void setBatteryPause(bool pause_battery, bool pause_CAN, bool equipment_stop, bool store_settings) {
 
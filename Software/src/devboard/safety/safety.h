@@ -17,9 +17,24 @@ extern bool allowed_to_send_CAN;
 //battery pause status end
 
 extern void store_settings_equipment_stop();
+extern void update_values_inverter();
 
 void update_machineryprotection();
 
+/**
+ * @brief Critical subset of update_machineryprotection() for datalayer.battery: cell and pack over/undervoltage,
+ *        overtemperature, fault and pause. Zeroes the affected power and current limits and maps them to the
+ *        inverter right away, instead of waiting for the next values pass. Raises no events, those stay with
+ *        update_machineryprotection().
+ *        Called by the core task after every battery CAN frame and every 10 ms.
+ *
+ * @param[in] frame_us esp_timer_get_time() when the battery frame that may have brought a critical value was
+ *                     received, 0 for the periodic call. A cut following a frame updates the latency metrics.
+ *
+ * @return void
+ */
+void update_fast_safety(int64_t frame_us);
+
 //battery pause status begin
 void setBatteryPause(bool pause_battery, bool pause_CAN, bool equipment_stop = false, bool store_settings = true);
 void update_pause_state();
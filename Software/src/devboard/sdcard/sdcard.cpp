@@ -210,6 +210,10 @@ void init_sdcard() {
 #endif  // DEBUG_LOG
 }
 
+bool is_sdcard_active() {
+  return sd_card_active;
+}
+
 void log_sdcard_details() {
 
   logging.print("SD Card Type: ");
@@ -15,6 +15,7 @@ void init_logging_buffers();
 
 void init_sdcard();
 void log_sdcard_details();
+bool is_sdcard_active();
 
 void add_can_frame_to_buffer(CAN_frame frame, frameDirection msgDir);
 void write_can_frame_to_sdcard();
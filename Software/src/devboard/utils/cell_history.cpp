@@ -0,0 +1,244 @@
+#include "cell_history.h"
+
+#ifdef CELL_HISTORY
+
+#include <math.h>
+#include <algorithm>
+#include <atomic>
+#include "../../datalayer/datalayer.h"
+#include "esp_timer.h"
+#include "logging.h"
+#include "timer.h"
+
+static_assert(CELL_HISTORY_SAMPLES >= 2 && CELL_HISTORY_SAMPLES <= UINT16_MAX, "CELL_HISTORY_SAMPLES out of range");
+static_assert(CELL_HISTORY_SAMPLES_NO_PSRAM >= 2 && CELL_HISTORY_SAMPLES_NO_PSRAM <= UINT16_MAX,
+              "CELL_HISTORY_SAMPLES_NO_PSRAM out of range");
+
+/** Fixed ring per battery, sample n is in slot n % capacity with its deltas at slot * MAX_AMOUNT_CELLS */
+typedef struct {
+  CELL_HISTORY_SAMPLE_TYPE* samples;
+  uint8_t* cells;
+  int8_t* deltas_mV;
+  /** Samples taken since boot, only the core task writes it */
+  std::atomic<uint32_t> written;
+} CELL_HISTORY_RING_TYPE;
+
+static CELL_HISTORY_RING_TYPE rings[CELL_HISTORY_BATTERIES];
+static uint16_t capacity = 0;
+static MyTimer sample_timer(CELL_HISTORY_INTERVAL_MS);
+
+static const DATALAYER_BATTERY_TYPE& history_battery([[maybe_unused]] uint8_t battery) {
+#ifdef DOUBLE_BATTERY
+  if (battery == 1) {
+    return datalayer.battery2;
+  }
+#endif  // DOUBLE_BATTERY
+  return datalayer.battery;
+}
+
+/**
+ * Samples a reader may use, first is the oldest. The core task overwrites slot written % capacity next, which is
+ * left out so a reader on the other core never sees a sample that is being written.
+ */
+static uint16_t ring_window(const CELL_HISTORY_RING_TYPE& ring, uint32_t& first) {
+  if (capacity == 0) {
+    first = 0;
+    return 0;
+  }
+  const uint32_t written = ring.written.load(std::memory_order_acquire);
+  const uint16_t count = std::min<uint32_t>(written, capacity - 1);
+  first = written - count;
+  return count;
+}
+
+static int8_t ring_delta(const CELL_HISTORY_RING_TYPE& ring, uint32_t slot, uint16_t cell) {
+  return cell < ring.cells[slot] ? ring.deltas_mV[slot * MAX_AMOUNT_CELLS + cell] : CELL_HISTORY_NO_READING;
+}
+
+static void take_sample(CELL_HISTORY_RING_TYPE& ring, const DATALAYER_BATTERY_TYPE& battery, uint32_t time_s) {
+  if (battery.cell_stats.count == 0) {
+    return;  // Nothing read yet, a sample would only hold gaps
+  }
+  const uint32_t written = ring.written.load(std::memory_order_relaxed);
+  const uint32_t slot = written % capacity;
+  const uint16_t mean_mV = battery.cell_stats.mean_mV;
+  const uint8_t cells = std::min<uint16_t>(battery.info.number_of_cells, MAX_AMOUNT_CELLS);
+  int8_t* deltas_mV = ring.deltas_mV + slot * MAX_AMOUNT_CELLS;
+  for (uint8_t i = 0; i < cells; i++) {
+    const uint16_t mV = battery.status.cell_voltages_mV[i];
+    const int32_t delta_mV =
+        std::min(std::max((int32_t)mV - mean_mV, -CELL_HISTORY_DELTA_MAX_MV), (int32_t)CELL_HISTORY_DELTA_MAX_MV);
+    deltas_mV[i] = mV == 0 ? CELL_HISTORY_NO_READING : (int8_t)delta_mV;
+  }
+  ring.cells[slot] = cells;
+  ring.samples[slot] = {time_s, mean_mV, battery.status.current_dA};
+  ring.written.store(written + 1, std::memory_order_release);
+}
+
+void init_cell_history(void) {
+  capacity = psramFound() ? CELL_HISTORY_SAMPLES : CELL_HISTORY_SAMPLES_NO_PSRAM;
+  for (uint8_t i = 0; i < CELL_HISTORY_BATTERIES; i++) {
+    rings[i].samples = (CELL_HISTORY_SAMPLE_TYPE*)cell_history_alloc(capacity * sizeof(CELL_HISTORY_SAMPLE_TYPE));
+    rings[i].cells = (uint8_t*)cell_history_alloc(capacity);
+    rings[i].deltas_mV = (int8_t*)cell_history_alloc(capacity * MAX_AMOUNT_CELLS);
+    if (rings[i].samples == nullptr || rings[i].cells == nullptr || rings[i].deltas_mV == nullptr) {
+      logging.println("Cell history could not be allocated, it stays empty");
+      capacity = 0;
+      return;
+    }
+  }
+  logging.printf("Cell history: %u samples every %u s in %s\n", capacity, CELL_HISTORY_INTERVAL_MS / 1000,
+                 psramFound() ? "PSRAM" : "RAM");
+}
+
+void update_cell_history(void) {
+  if (capacity == 0 || !sample_timer.elapsed()) {
+    return;
+  }
+  const uint32_t time_s = esp_timer_get_time() / 1000000;
+  for (uint8_t i = 0; i < CELL_HISTORY_BATTERIES; i++) {
+    take_sample(rings[i], history_battery(i), time_s);
+  }
+}
+
+void* cell_history_alloc(size_t size) {
+  return psramFound() ? ps_malloc(size) : malloc(size);
+}
+
+uint16_t cell_history_capacity(void) {
+  return capacity;
+}
+
+uint16_t cell_history_read(uint8_t battery, uint16_t cell, CELL_HISTORY_SAMPLE_TYPE* samples, int8_t* deltas_mV,
+                           uint16_t max_count) {
+  const CELL_HISTORY_RING_TYPE& ring = rings[std::min<uint8_t>(battery, CELL_HISTORY_BATTERIES - 1)];
+  uint32_t first;
+  uint16_t count = ring_window(ring, first);
+  if (count > max_count) {
+    first += count - max_count;
+    count = max_count;
+  }
+  for (uint16_t i = 0; i < count; i++) {
+    const uint32_t slot = (first + i) % capacity;
+    samples[i] = ring.samples[slot];
+    if (deltas_mV != nullptr) {
+      deltas_mV[i] = ring_delta(ring, slot, cell);
+    }
+  }
+  return count;
+}
+
+/** Least squares slope, with the time in hours since the first sample to keep the sums small for a float */
+typedef struct {
+  uint16_t n;
+  float t;
+  float y;
+  float tt;
+  float ty;
+} CELL_HISTORY_FIT_TYPE;
+
+static void fit_add(CELL_HISTORY_FIT_TYPE& fit, float t_h, float y) {
+  fit.n++;
+  fit.t += t_h;
+  fit.y += y;
+  fit.tt += t_h * t_h;
+  fit.ty += t_h * y;
+}
+
+static float fit_slope(const CELL_HISTORY_FIT_TYPE& fit) {
+  const float denominator = fit.n * fit.tt - fit.t * fit.t;
+  return fit.n < 2 || denominator <= 0 ? NAN : (fit.n * fit.ty - fit.t * fit.y) / denominator;
+}
+
+static bool under_load(const CELL_HISTORY_SAMPLE_TYPE& sample) {
+  return sample.current_dA < -CELL_HISTORY_LOAD_DA;
+}
+
+static bool at_rest(const CELL_HISTORY_SAMPLE_TYPE& sample) {
+  return abs(sample.current_dA) < CELL_HISTORY_REST_DA;
+}
+
+void cell_history_analyze_cell(uint8_t battery, uint16_t cell, CELL_HISTORY_CELL_TYPE& result) {
+  const CELL_HISTORY_RING_TYPE& ring = rings[std::min<uint8_t>(battery, CELL_HISTORY_BATTERIES - 1)];
+  uint32_t first;
+  const uint16_t count = ring_window(ring, first);
+
+  CELL_HISTORY_FIT_TYPE fit = {};
+  int32_t load_sum = 0;
+  int32_t rest_sum = 0;
+  uint16_t load_count = 0;
+  uint16_t rest_count = 0;
+  result.delta_mV = CELL_HISTORY_NO_READING;
+  for (uint16_t i = 0; i < count; i++) {
+    const uint32_t slot = (first + i) % capacity;
+    const int8_t delta_mV = ring_delta(ring, slot, cell);
+    result.delta_mV = delta_mV;
+    if (delta_mV == CELL_HISTORY_NO_READING) {
+      continue;
+    }
+    const CELL_HISTORY_SAMPLE_TYPE& sample = ring.samples[slot];
+    fit_add(fit, (sample.time_s - ring.samples[first % capacity].time_s) / 3600.0f, delta_mV);
+    if (under_load(sample)) {
+      load_sum += delta_mV;
+      load_count++;
+    } else if (at_rest(sample)) {
+      rest_sum += delta_mV;
+      rest_count++;
+    }
+  }
+  result.trend_mV_per_h = fit_slope(fit);
+  result.sag_mV =
+      load_count == 0 || rest_count == 0 ? NAN : (float)load_sum / load_count - (float)rest_sum / rest_count;
+}
+
+void cell_history_analyze_pack(uint8_t battery, CELL_HISTORY_PACK_TYPE& result) {
+  const CELL_HISTORY_RING_TYPE& ring = rings[std::min<uint8_t>(battery, CELL_HISTORY_BATTERIES - 1)];
+  uint32_t first;
+  const uint16_t count = ring_window(ring, first);
+
+  result = {};
+  result.samples = count;
+  result.spread_trend_mV_per_h = NAN;
+  if (count == 0) {
+    return;
+  }
+  const uint32_t first_time_s = ring.samples[first % capacity].time_s;
+  result.span_s = ring.samples[(first + count - 1) % capacity].time_s - first_time_s;
+
+  // Load pulls the cells apart by their internal resistance, so balancing is judged at rest. A pack that never
+  // rests is judged on all samples instead
+  bool any_rest = false;
+  for (uint16_t i = 0; i < count && !any_rest; i++) {
+    any_rest = at_rest(ring.samples[(first + i) % capacity]);
+  }
+
+  CELL_HISTORY_FIT_TYPE fit = {};
+  for (uint16_t i = 0; i < count; i++) {
+    const uint32_t slot = (first + i) % capacity;
+    const CELL_HISTORY_SAMPLE_TYPE& sample = ring.samples[slot];
+    if (any_rest && !at_rest(sample)) {
+      continue;
+    }
+    int8_t low_mV = INT8_MAX;
+    int8_t high_mV = INT8_MIN;
+    for (uint8_t cell = 0; cell < ring.cells[slot]; cell++) {
+      const int8_t delta_mV = ring.deltas_mV[slot * MAX_AMOUNT_CELLS + cell];
+      if (delta_mV != CELL_HISTORY_NO_READING) {
+        low_mV = std::min(low_mV, delta_mV);
+        high_mV = std::max(high_mV, delta_mV);
+      }
+    }
+    if (high_mV < low_mV) {
+      continue;
+    }
+    const uint16_t spread_mV = high_mV - low_mV;
+    if (fit.n == 0) {
+      result.spread_first_mV = spread_mV;
+    }
+    result.spread_last_mV = spread_mV;
+    fit_add(fit, (sample.time_s - first_time_s) / 3600.0f, spread_mV);
+  }
+  result.spread_trend_mV_per_h = fit_slope(fit);
+}
+
+#endif  // CELL_HISTORY
@@ -0,0 +1,96 @@
+#ifndef __CELL_HISTORY_H__
+#define __CELL_HISTORY_H__
+
+#include "../../include.h"
+
+#ifdef CELL_HISTORY
+
+#ifdef DOUBLE_BATTERY
+#define CELL_HISTORY_BATTERIES 2
+#else
+#define CELL_HISTORY_BATTERIES 1
+#endif  // DOUBLE_BATTERY
+
+#define CELL_HISTORY_NO_READING INT8_MIN  // Stored for a cell that had no reading, 0 mV
+#define CELL_HISTORY_DELTA_MAX_MV 127     // Deltas from the pack mean are clamped to +-127 mV
+#define CELL_HISTORY_LOAD_DA 100          // Discharge current above 10.0A counts as under load
+#define CELL_HISTORY_REST_DA 10           // Current below 1.0A either way counts as at rest
+
+/** Pack level values of one sample, the cells themselves are kept as 8-bit deltas from mean_mV */
+typedef struct {
+  uint32_t time_s;
+  uint16_t mean_mV;
+  int16_t current_dA;
+} CELL_HISTORY_SAMPLE_TYPE;
+
+/** Analysis of one cell over all samples in the history */
+typedef struct {
+  /** Most recent deviation from the pack mean */
+  int8_t delta_mV;
+  /** Drift of the deviation from the pack mean, negative for a cell falling behind the rest */
+  float trend_mV_per_h;
+  /** Deviation under load minus deviation at rest, negative for a cell that sags more than the pack */
+  float sag_mV;
+} CELL_HISTORY_CELL_TYPE;
+
+/** Analysis of the whole pack over all samples in the history */
+typedef struct {
+  uint16_t samples;
+  uint32_t span_s;
+  /** Highest minus lowest cell delta, in the oldest and newest sample taken at rest */
+  uint16_t spread_first_mV;
+  uint16_t spread_last_mV;
+  /** Change of that spread over the samples at rest, negative while balancing is pulling the cells together */
+  float spread_trend_mV_per_h;
+} CELL_HISTORY_PACK_TYPE;
+
+/** Allocate the history, in PSRAM when the board has it. Call once from setup */
+void init_cell_history(void);
+
+/** Take a sample of every battery when CELL_HISTORY_INTERVAL_MS has passed. Called by the core task once
+ *  battery.cell_stats is current */
+void update_cell_history(void);
+
+/** Samples each battery can keep, CELL_HISTORY_SAMPLES with PSRAM or CELL_HISTORY_SAMPLES_NO_PSRAM without */
+uint16_t cell_history_capacity(void);
+
+/** malloc() from PSRAM when the board has it, for the history and for copies of it. Release with free() */
+void* cell_history_alloc(size_t size);
+
+/**
+ * @brief Copy the newest samples of a battery, oldest first. Safe to call from another task than the core task
+ *
+ * @param[in] battery 0 for datalayer.battery, 1 for datalayer.battery2
+ * @param[in] cell Cell whose deltas are copied to deltas_mV, may be nullptr if only the pack values are needed
+ * @param[out] samples
+ * @param[out] deltas_mV CELL_HISTORY_NO_READING where the cell had no reading
+ * @param[in] max_count
+ *
+ * @return Number of samples copied
+ */
+uint16_t cell_history_read(uint8_t battery, uint16_t cell, CELL_HISTORY_SAMPLE_TYPE* samples, int8_t* deltas_mV,
+                           uint16_t max_count);
+
+/**
+ * @brief Trend, sag and latest delta of one cell
+ *
+ * @param[in] battery
+ * @param[in] cell
+ * @param[out] result
+ *
+ * @return void
+ */
+void cell_history_analyze_cell(uint8_t battery, uint16_t cell, CELL_HISTORY_CELL_TYPE& result);
+
+/**
+ * @brief Cell spread and how balancing moves it
+ *
+ * @param[in] battery
+ * @param[out] result
+ *
+ * @return void
+ */
+void cell_history_analyze_pack(uint8_t battery, CELL_HISTORY_PACK_TYPE& result);
+
+#endif  // CELL_HISTORY
+#endif  // __CELL_HISTORY_H__
@@ -0,0 +1,83 @@
+#include "cell_stats.h"
+#include <math.h>
+#include <algorithm>
+
+static void compute_cell_stats(DATALAYER_BATTERY_TYPE& battery) {
+  DATALAYER_CELL_STATS_TYPE& stats = battery.cell_stats;
+  const uint16_t* voltages_mV = battery.status.cell_voltages_mV;
+  const uint16_t cells = std::min<uint16_t>(battery.info.number_of_cells, MAX_AMOUNT_CELLS);
+
+  // First pass, extremes and sum. Cells without a reading are masked with selects instead of skipped with a
+  // branch, so the loop runs the same instructions for every cell
+  uint16_t min_mV = UINT16_MAX;
+  uint16_t max_mV = 0;
+  uint16_t min_cell = 0;
+  uint16_t max_cell = 0;
+  uint16_t count = 0;
+  uint32_t sum_mV = 0;
+  for (uint16_t i = 0; i < cells; i++) {
+    const uint16_t mV = voltages_mV[i];
+    const uint16_t read = mV != 0;
+    const uint16_t low_mV = read ? mV : UINT16_MAX;
+    const bool lower = low_mV < min_mV;
+    const bool higher = mV > max_mV;  // A cell without reading is 0 and never raises the maximum
+    min_mV = lower ? low_mV : min_mV;
+    min_cell = lower ? i : min_cell;
+    max_mV = higher ? mV : max_mV;
+    max_cell = higher ? i : max_cell;
+    count += read;
+    sum_mV += mV;
+  }
+
+  std::fill(stats.histogram, stats.histogram + CELL_STATS_HISTOGRAM_BINS, 0);
+  stats.count = count;
+  stats.total_mV = sum_mV;
+  if (count == 0) {
+    stats.min_mV = battery.status.cell_min_voltage_mV;
+    stats.max_mV = battery.status.cell_max_voltage_mV;
+    stats.min_cell = 0;
+    stats.max_cell = 0;
+    stats.deviation_mV = std::abs(stats.max_mV - stats.min_mV);
+    stats.mean_mV = 0;
+    stats.stddev_uV = 0;
+    stats.outliers = 0;
+    return;
+  }
+  const uint16_t mean_mV = (sum_mV + count / 2) / count;
+
+  // Second pass, spread around the mean and around the lowest cell
+  uint32_t squares = 0;
+  uint16_t outliers = 0;
+  for (uint16_t i = 0; i < cells; i++) {
+    const uint16_t mV = voltages_mV[i];
+    const uint16_t read = mV != 0;
+    const uint32_t from_mean = std::abs((int32_t)mV - (int32_t)mean_mV);
+    // Each square is capped so the sum over a full pack cannot overflow, only a broken reading gets there
+    squares += read ? std::min<uint32_t>(from_mean * from_mean, UINT32_MAX / MAX_AMOUNT_CELLS) : 0;
+    outliers += read & (from_mean > CELL_STATS_OUTLIER_MV);
+    const uint16_t bin =
+        std::min<uint16_t>((uint16_t)(mV - min_mV) / CELL_STATS_HISTOGRAM_BIN_MV, CELL_STATS_HISTOGRAM_BINS - 1);
+    stats.histogram[read ? bin : 0] += read;
+  }
+
+  stats.min_mV = min_mV;
+  stats.max_mV = max_mV;
+  stats.min_cell = min_cell;
+  stats.max_cell = max_cell;
+  stats.deviation_mV = max_mV - min_mV;
+  stats.mean_mV = mean_mV;
+  stats.stddev_uV = std::min(sqrtf((float)squares / count) * 1000.0f, (float)UINT16_MAX);
+  stats.outliers = outliers;
+}
+
+void update_cell_stats(DATALAYER_BATTERY_TYPE& battery) {
+  compute_cell_stats(battery);
+  battery.cell_stats.updated_by_driver = true;
+}
+
+void finish_cell_stats(DATALAYER_BATTERY_TYPE& battery) {
+  if (!battery.cell_stats.updated_by_driver) {
+    compute_cell_stats(battery);
+  }
+  battery.cell_stats.updated_by_driver = false;
+}
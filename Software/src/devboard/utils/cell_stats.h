@@ -0,0 +1,30 @@
+#ifndef __CELL_STATS_H__
+#define __CELL_STATS_H__
+
+#include "../../datalayer/datalayer.h"
+
+/**
+ * @brief Recompute battery.cell_stats from the cell voltages right away
+ *
+ * For battery drivers that need the statistics as soon as they have written the cells, e.g. to report the
+ * lowest and highest cell. The core task then keeps them for the rest of the update cycle.
+ *
+ * @param[in,out] battery
+ *
+ * @return void
+ */
+void update_cell_stats(DATALAYER_BATTERY_TYPE& battery);
+
+/**
+ * @brief Make battery.cell_stats current for this update cycle, once the battery values have been updated
+ *
+ * Recomputes the statistics unless the battery driver already did so in this cycle, so the cells are scanned
+ * once per cycle and safety, MQTT, /metrics and the web pages all read the same result.
+ *
+ * @param[in,out] battery
+ *
+ * @return void
+ */
+void finish_cell_stats(DATALAYER_BATTERY_TYPE& battery);
+
+#endif
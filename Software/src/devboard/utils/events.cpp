@@ -10,20 +10,40 @@ typedef struct {
   uint8_t data;
 } EVENT_LOG_ENTRY_TYPE;
 
+#define EVENT_NOF_LEVELS (EVENT_LEVEL_UPDATE + 1)
+
+/** Flap detection bookkeeping of one event */
+typedef struct {
+  uint32_t window_start;  // millis() of the first rise in the current window
+  uint8_t rises;          // Rises since window_start
+  bool clear_held;        // Cleared while flapping, released by release_held_events() once quiet
+} EVENT_FLAP_TYPE;
+
 typedef struct {
   EVENTS_STRUCT_TYPE entries[EVENT_NOF_EVENTS];
   EVENTS_LEVEL_TYPE level;
+  /** Active events per level, kept up to date on every state change so the level never needs a full scan */
+  uint8_t active_count[EVENT_NOF_LEVELS];
+  EVENT_FLAP_TYPE flap[EVENT_NOF_EVENTS];
+  uint8_t held_count;   // Events with clear_held set, so release_held_events() only scans when there are some
+  uint32_t generation;  // Incremented whenever the event list shown to users changes
 } EVENT_TYPE;
 
 /* Local variables */
 static EVENT_TYPE events;
 static const char* EVENTS_ENUM_TYPE_STRING[] = {EVENTS_ENUM_TYPE(GENERATE_STRING)};
 static const char* EVENTS_LEVEL_TYPE_STRING[] = {EVENTS_LEVEL_TYPE(GENERATE_STRING)};
+static_assert(sizeof(EVENTS_LEVEL_TYPE_STRING) / sizeof(EVENTS_LEVEL_TYPE_STRING[0]) == EVENT_NOF_LEVELS,
+              "EVENT_NOF_LEVELS must cover every event level");
 
 /* Local function prototypes */
 static void set_event(EVENTS_ENUM_TYPE event, uint8_t data, bool latched);
+static void set_event_state(EVENTS_ENUM_TYPE event, EVENTS_STATE_TYPE state);
 static void update_event_level(void);
 static void update_bms_status(void);
+static void update_event_flapping(EVENTS_ENUM_TYPE event, uint32_t now);
+static void set_clear_held(EVENTS_ENUM_TYPE event, bool held);
+static void clear_active_event(EVENTS_ENUM_TYPE event);
 
 /* Initialization function */
 void init_events(void) {
@@ -33,7 +53,11 @@ void init_events(void) {
     events.entries[i].millisrolloverCount = 0;
     events.entries[i].occurences = 0;
     events.entries[i].MQTTpublished = false;  // Not published by default
+    events.entries[i].flapping = false;
+    events.entries[i].flaps = 0;
   }
+  memset(events.flap, 0, sizeof(events.flap));
+  events.held_count = 0;
 
   events.entries[EVENT_CANMCP2517FD_INIT_FAILURE].level = EVENT_LEVEL_WARNING;
   events.entries[EVENT_CANMCP2515_INIT_FAILURE].level = EVENT_LEVEL_WARNING;
@@ -139,10 +163,27 @@ void set_event_latched(EVENTS_ENUM_TYPE event, uint8_t data) {
 }
 
 void clear_event(EVENTS_ENUM_TYPE event) {
-  if (events.entries[event].state == EVENT_STATE_ACTIVE) {
-    events.entries[event].state = EVENT_STATE_INACTIVE;
-    update_event_level();
-    update_bms_status();
+  // Most calls clear an event that is not set, those return without touching anything else
+  if (events.entries[event].state != EVENT_STATE_ACTIVE) {
+    return;
+  }
+  // Hysteresis, a flapping event stays active until it has not been set for EVENT_FLAP_QUIET_MS
+  if (events.entries[event].flapping && millis() - events.entries[event].timestamp < EVENT_FLAP_QUIET_MS) {
+    set_clear_held(event, true);
+    return;
+  }
+  clear_active_event(event);
+}
+
+void release_held_events(void) {
+  if (events.held_count == 0) {
+    return;
+  }
+  const uint32_t now = millis();
+  for (uint16_t i = 0; i < EVENT_NOF_EVENTS; i++) {
+    if (events.flap[i].clear_held && now - events.entries[i].timestamp >= EVENT_FLAP_QUIET_MS) {
+      clear_active_event((EVENTS_ENUM_TYPE)i);
+    }
   }
 }
 
@@ -154,8 +195,14 @@ void reset_all_events() {
     events.entries[i].millisrolloverCount = 0;
     events.entries[i].occurences = 0;
     events.entries[i].MQTTpublished = false;  // Not published by default
+    events.entries[i].flapping = false;
+    events.entries[i].flaps = 0;
   }
+  memset(events.flap, 0, sizeof(events.flap));
+  events.held_count = 0;
+  memset(events.active_count, 0, sizeof(events.active_count));
   events.level = EVENT_LEVEL_INFO;
+  events.generation++;
   update_bms_status();
 #ifdef DEBUG_LOG
   logging.println("All events have been cleared.");
@@ -384,6 +431,10 @@ EVENTS_LEVEL_TYPE get_event_level(void) {
   return events.level;
 }
 
+uint32_t get_event_generation(void) {
+  return events.generation;
+}
+
 /* Local functions */
 
 static void set_event(EVENTS_ENUM_TYPE event, uint8_t data, bool latched) {
@@ -392,30 +443,110 @@ static void set_event(EVENTS_ENUM_TYPE event, uint8_t data, bool latched) {
     event = EVENT_UNKNOWN_EVENT_SET;
   }
 
+  const uint32_t now = millis();
+
   // If the event is already set, no reason to continue
   if ((events.entries[event].state != EVENT_STATE_ACTIVE) &&
       (events.entries[event].state != EVENT_STATE_ACTIVE_LATCHED)) {
     events.entries[event].occurences++;
     events.entries[event].MQTTpublished = false;
+    events.generation++;
 #ifdef DEBUG_LOG
     logging.print("Event: ");
     logging.println(get_event_message_string(event));
 #endif
+    if (!latched) {
+      update_event_flapping(event, now);
+    }
+  } else if (events.flap[event].clear_held) {
+    // Only counted, the rise a clear would have caused is not shown anywhere
+    set_clear_held(event, false);
+    if (events.entries[event].flaps < UINT16_MAX) {
+      events.entries[event].flaps++;
+    }
+  }
+
+  // The data of a flapping event, e.g. the overrun time, changes all the time and is not worth a page refresh
+  if (events.entries[event].data != data && !events.entries[event].flapping) {
+    events.generation++;
   }
 
   // We should set the event, update event info
-  events.entries[event].timestamp = millis();
+  events.entries[event].timestamp = now;
   events.entries[event].millisrolloverCount = datalayer.system.status.millisrolloverCount;
   events.entries[event].data = data;
   // Check if the event is latching
-  events.entries[event].state = latched ? EVENT_STATE_ACTIVE_LATCHED : EVENT_STATE_ACTIVE;
+  set_event_state(event, latched ? EVENT_STATE_ACTIVE_LATCHED : EVENT_STATE_ACTIVE);
 
-  // Update event level, only upwards. Downward changes are done in Software.ino:loop()
+  // Update event level, only upwards. Downward changes are done in clear_event()
   events.level = max(events.level, events.entries[event].level);
 
   update_bms_status();
 }
 
+/** Count a rise of the event, and mark it as flapping once it rises too often. Only INFO and WARNING events are held
+ *  active, an ERROR must reach the level and bms_status as soon as it clears */
+static void update_event_flapping(EVENTS_ENUM_TYPE event, uint32_t now) {
+  if (events.entries[event].level != EVENT_LEVEL_INFO && events.entries[event].level != EVENT_LEVEL_WARNING) {
+    return;
+  }
+  EVENT_FLAP_TYPE& flap = events.flap[event];
+  if (flap.rises == 0 || now - flap.window_start >= EVENT_FLAP_WINDOW_MS) {
+    flap.window_start = now;
+    flap.rises = 0;
+  }
+  flap.rises++;
+  if (flap.rises >= EVENT_FLAP_TRANSITIONS) {
+    flap.rises = 0;
+    events.entries[event].flapping = true;
+#ifdef DEBUG_LOG
+    logging.print("Event flapping: ");
+    logging.println(get_event_enum_string(event));
+#endif
+  }
+}
+
+static void set_clear_held(EVENTS_ENUM_TYPE event, bool held) {
+  if (events.flap[event].clear_held != held) {
+    events.flap[event].clear_held = held;
+    if (held) {
+      events.held_count++;
+    } else {
+      events.held_count--;
+    }
+  }
+}
+
+/** The clear itself, for clear_event() and for held events once they have been quiet long enough */
+static void clear_active_event(EVENTS_ENUM_TYPE event) {
+  if (events.entries[event].flapping) {
+    events.entries[event].flapping = false;
+    set_clear_held(event, false);
+    events.entries[event].MQTTpublished = false;  // Publish the flap summary once more
+  }
+  set_event_state(event, EVENT_STATE_INACTIVE);
+  events.generation++;
+  update_event_level();
+  update_bms_status();
+}
+
+static bool is_event_active(EVENTS_STATE_TYPE state) {
+  return (state == EVENT_STATE_ACTIVE) || (state == EVENT_STATE_ACTIVE_LATCHED);
+}
+
+/** State changes of single events all go through here, so the active counters stay in step with the states */
+static void set_event_state(EVENTS_ENUM_TYPE event, EVENTS_STATE_TYPE state) {
+  EVENTS_STRUCT_TYPE& entry = events.entries[event];
+  const bool was_active = is_event_active(entry.state);
+  const bool active = is_event_active(state);
+  if (active && !was_active) {
+    events.active_count[entry.level]++;
+  } else if (was_active && !active) {
+    events.active_count[entry.level]--;
+  }
+  entry.state = state;
+}
+
 static void update_bms_status(void) {
   switch (events.level) {
     case EVENT_LEVEL_INFO:
@@ -451,11 +582,10 @@ bool compareEventsByTimestampAsc(const EventData& a, const EventData& b) {
 }
 
 static void update_event_level(void) {
-  EVENTS_LEVEL_TYPE temporary_level = EVENT_LEVEL_INFO;
-  for (uint8_t i = 0u; i < EVENT_NOF_EVENTS; i++) {
-    if ((events.entries[i].state == EVENT_STATE_ACTIVE) || (events.entries[i].state == EVENT_STATE_ACTIVE_LATCHED)) {
-      temporary_level = max(events.entries[i].level, temporary_level);
-    }
+  // Highest level that still has an active event, INFO when none has
+  uint8_t level = EVENT_NOF_LEVELS - 1;
+  while (level > EVENT_LEVEL_INFO && events.active_count[level] == 0) {
+    level--;
   }
-  events.level = temporary_level;
+  events.level = (EVENTS_LEVEL_TYPE)level;
 }
@@ -4,6 +4,13 @@
 #include "../../include.h"
 #endif
 
+/* Flap detection: an INFO or WARNING event that rises this often within the window is held active until it has not been
+ * set for the quiet time, instead of going through a level update, a web page refresh and an MQTT message on every
+ * toggle. Held clears are done by release_held_events() */
+#define EVENT_FLAP_TRANSITIONS 5
+#define EVENT_FLAP_WINDOW_MS 60000
+#define EVENT_FLAP_QUIET_MS 60000
+
 #define GENERATE_ENUM(ENUM) ENUM,
 #define GENERATE_STRING(STRING) #STRING,
 
@@ -132,6 +139,8 @@ typedef struct {
   EVENTS_LEVEL_TYPE level;      // Event level, i.e. ERROR/WARNING...
   EVENTS_STATE_TYPE state;      // Event state, i.e. ACTIVE/INACTIVE...
   bool MQTTpublished;
+  bool flapping;   // Held active, see EVENT_FLAP_TRANSITIONS
+  uint16_t flaps;  // Clear and set pairs absorbed while flapping, since startup
 } EVENTS_STRUCT_TYPE;
 
 // Define a struct to hold event data
@@ -145,11 +154,13 @@ const char* get_event_message_string(EVENTS_ENUM_TYPE event);
 const char* get_event_level_string(EVENTS_ENUM_TYPE event);
 
 EVENTS_LEVEL_TYPE get_event_level(void);
+uint32_t get_event_generation(void);
 
 void init_events(void);
 void set_event_latched(EVENTS_ENUM_TYPE event, uint8_t data);
 void set_event(EVENTS_ENUM_TYPE event, uint8_t data);
 void clear_event(EVENTS_ENUM_TYPE event);
+void release_held_events(void);
 void reset_all_events();
 void set_event_MQTTpublished(EVENTS_ENUM_TYPE event);
 
@@ -0,0 +1,154 @@
+#include "latency_trace.h"
+
+#ifdef FUNCTION_TIME_MEASUREMENT
+
+#include "esp_timer.h"
+
+const uint16_t latency_trace_bucket_ms[LATENCY_TRACE_BUCKETS - 1] = {1, 2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000};
+const char* const latency_trace_stage_names[LATENCY_STAGE_COUNT] = {"rx_to_write", "write_to_map", "map_to_tx",
+                                                                    "write_to_tx"};
+
+typedef enum { TRACE_IDLE = 0, TRACE_WRITTEN, TRACE_MAPPED } TRACE_STATE_TYPE;
+
+/** The one trace in flight per field. A change while the previous one waits for its inverter frame is not traced */
+typedef struct {
+  int32_t seen;
+  TRACE_STATE_TYPE state;
+  /** 0 when the change was not noticed right after a battery frame */
+  int64_t rx_us;
+  int64_t write_us;
+  int64_t map_us;
+} TRACE_TYPE;
+
+typedef struct {
+  uint32_t ID;
+  uint8_t DLC;
+  uint8_t data[8];
+} TRACE_TX_FRAME_TYPE;
+
+static LATENCY_TRACE_FIELD_TYPE fields[] = {
+#define LATENCY_TRACE_ENTRY(id) {DATALAYER_FIELD_##id, 0, 0, 0, {}, {}},
+    LATENCY_TRACE_FIELDS(LATENCY_TRACE_ENTRY)
+#undef LATENCY_TRACE_ENTRY
+};
+
+#define LATENCY_TRACE_FIELD_COUNT (sizeof(fields) / sizeof(fields[0]))
+
+static TRACE_TYPE traces[LATENCY_TRACE_FIELD_COUNT];
+static uint8_t mapped_traces = 0;
+static TRACE_TX_FRAME_TYPE tx_frames[LATENCY_TRACE_TX_IDS];
+static uint8_t tx_frame_count = 0;
+
+static void record(LATENCY_TRACE_FIELD_TYPE& field, LATENCY_STAGE_TYPE stage, int64_t duration_us) {
+  const uint32_t us = duration_us > 0 ? (uint32_t)duration_us : 0;
+  uint8_t bucket = 0;
+  while (bucket < LATENCY_TRACE_BUCKETS - 1 && us >= latency_trace_bucket_ms[bucket] * 1000UL) {
+    bucket++;
+  }
+  field.histogram[stage][bucket]++;
+  field.max_us[stage] = max(field.max_us[stage], us);
+}
+
+/** Start a trace for every field that differs from what was seen before */
+static void check_writes(int64_t now_us, int64_t rx_us) {
+  for (uint8_t i = 0; i < LATENCY_TRACE_FIELD_COUNT; i++) {
+    const int32_t value = read_datalayer_field(datalayer.battery, fields[i].field);
+    TRACE_TYPE& trace = traces[i];
+    if (value == trace.seen) {
+      continue;
+    }
+    trace.seen = value;
+    if (rx_us != 0) {
+      fields[i].frame_writes++;
+    } else {
+      fields[i].task_writes++;
+    }
+    if (trace.state != TRACE_MAPPED) {
+      // A newer value before the mapping replaces the older one, only the newest reaches the inverter
+      trace.state = TRACE_WRITTEN;
+      trace.rx_us = rx_us;
+      trace.write_us = now_us;
+    }
+  }
+}
+
+void latency_trace_battery_frame(int64_t rx_us) {
+  const int64_t now_us = esp_timer_get_time();
+  check_writes(now_us, rx_us);
+  for (uint8_t i = 0; i < LATENCY_TRACE_FIELD_COUNT; i++) {
+    if (traces[i].state == TRACE_WRITTEN && traces[i].rx_us == rx_us) {
+      record(fields[i], LATENCY_STAGE_RX_TO_WRITE, now_us - rx_us);
+    }
+  }
+}
+
+void latency_trace_map(void) {
+  const int64_t now_us = esp_timer_get_time();
+  // Whatever the core task changed since the last frame, e.g. the values pass or a safety cut, is written now
+  check_writes(now_us, 0);
+  for (uint8_t i = 0; i < LATENCY_TRACE_FIELD_COUNT; i++) {
+    TRACE_TYPE& trace = traces[i];
+    if (trace.state == TRACE_MAPPED && now_us - trace.map_us > LATENCY_TRACE_TIMEOUT_US) {
+      // Nothing the inverter sends changed, e.g. the value is below the resolution of its frames
+      fields[i].untransmitted++;
+      trace.state = TRACE_IDLE;
+      mapped_traces--;
+    }
+    if (trace.state == TRACE_WRITTEN) {
+      record(fields[i], LATENCY_STAGE_WRITE_TO_MAP, now_us - trace.write_us);
+      trace.state = TRACE_MAPPED;
+      trace.map_us = now_us;
+      mapped_traces++;
+    }
+  }
+}
+
+/** True if the payload differs from the last frame sent with the same ID, which is then replaced */
+static bool tx_frame_changed(const CAN_frame& frame) {
+  const uint8_t length = min(frame.DLC, (uint8_t)8);
+  for (uint8_t i = 0; i < tx_frame_count; i++) {
+    TRACE_TX_FRAME_TYPE& stored = tx_frames[i];
+    if (stored.ID == frame.ID) {
+      const bool changed = stored.DLC != length || memcmp(stored.data, frame.data.u8, length) != 0;
+      stored.DLC = length;
+      memcpy(stored.data, frame.data.u8, length);
+      return changed;
+    }
+  }
+  if (tx_frame_count < LATENCY_TRACE_TX_IDS) {
+    TRACE_TX_FRAME_TYPE& stored = tx_frames[tx_frame_count++];
+    stored.ID = frame.ID;
+    stored.DLC = length;
+    memcpy(stored.data, frame.data.u8, length);
+  }
+  return false;  // The first time an ID is sent there is nothing to compare with
+}
+
+void latency_trace_inverter_tx(const CAN_frame& frame) {
+  // Kept up to date even with no trace in flight, otherwise an older change would look like the dependent frame
+  if (!tx_frame_changed(frame) || mapped_traces == 0) {
+    return;
+  }
+  // Which frame carries which value is up to each inverter protocol, so the first frame that changed after the
+  // mapping is taken as the dependent frame of every value that mapping carried
+  const int64_t now_us = esp_timer_get_time();
+  for (uint8_t i = 0; i < LATENCY_TRACE_FIELD_COUNT; i++) {
+    TRACE_TYPE& trace = traces[i];
+    if (trace.state == TRACE_MAPPED) {
+      record(fields[i], LATENCY_STAGE_MAP_TO_TX, now_us - trace.map_us);
+      record(fields[i], LATENCY_STAGE_WRITE_TO_TX, now_us - trace.write_us);
+      trace.state = TRACE_IDLE;
+    }
+  }
+  mapped_traces = 0;
+}
+
+uint8_t latency_trace_field_count(void) {
+  return LATENCY_TRACE_FIELD_COUNT;
+}
+
+const LATENCY_TRACE_FIELD_TYPE& get_latency_trace(uint8_t index) {
+  return fields[min(index, (uint8_t)(LATENCY_TRACE_FIELD_COUNT - 1))];
+}
+
+#endif  // FUNCTION_TIME_MEASUREMENT
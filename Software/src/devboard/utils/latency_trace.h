@@ -0,0 +1,68 @@
+#ifndef __LATENCY_TRACE_H__
+#define __LATENCY_TRACE_H__
+
+#include "../../include.h"
+
+#ifdef FUNCTION_TIME_MEASUREMENT
+
+#include "../../datalayer/datalayer_fields.h"
+
+#define LATENCY_TRACE_BUCKETS 12          // Histogram buckets, see latency_trace_bucket_ms
+#define LATENCY_TRACE_TX_IDS 16           // Inverter frame IDs whose last payload is kept to spot the dependent frame
+#define LATENCY_TRACE_TIMEOUT_US 5000000  // A mapped value that changes no inverter frame in 5s is not traced further
+
+/** Battery values followed from the CAN frame that brought them to the inverter frame that carries them */
+// clang-format off
+#define LATENCY_TRACE_FIELDS(X) \
+  X(MAX_CHARGE_POWER)           \
+  X(MAX_DISCHARGE_POWER)        \
+  X(MAX_CHARGE_CURRENT)         \
+  X(MAX_DISCHARGE_CURRENT)      \
+  X(SOC)                        \
+  X(VOLTAGE)                    \
+  X(CURRENT)
+// clang-format on
+
+typedef enum {
+  /** Battery CAN frame received until the value changed in the datalayer, only when a frame handler wrote it */
+  LATENCY_STAGE_RX_TO_WRITE = 0,
+  /** Datalayer change until update_values_inverter() mapped it */
+  LATENCY_STAGE_WRITE_TO_MAP,
+  /** Mapping until the first inverter frame whose payload changed was sent */
+  LATENCY_STAGE_MAP_TO_TX,
+  /** Datalayer change until that inverter frame was sent */
+  LATENCY_STAGE_WRITE_TO_TX,
+  LATENCY_STAGE_COUNT
+} LATENCY_STAGE_TYPE;
+
+typedef struct {
+  /** DATALAYER_BATTERY_FIELD_TYPE */
+  uint8_t field;
+  /** Changes noticed right after a battery frame, and by the core task (e.g. in the values pass) */
+  uint32_t frame_writes;
+  uint32_t task_writes;
+  /** Traces that never reached an inverter frame within LATENCY_TRACE_TIMEOUT_US */
+  uint32_t untransmitted;
+  uint32_t histogram[LATENCY_STAGE_COUNT][LATENCY_TRACE_BUCKETS];
+  uint32_t max_us[LATENCY_STAGE_COUNT];
+} LATENCY_TRACE_FIELD_TYPE;
+
+/** Upper bound of each histogram bucket in ms, the last bucket has no upper bound */
+extern const uint16_t latency_trace_bucket_ms[LATENCY_TRACE_BUCKETS - 1];
+extern const char* const latency_trace_stage_names[LATENCY_STAGE_COUNT];
+
+/** Trace point after a battery frame was handled. rx_us is esp_timer_get_time() at reception */
+void latency_trace_battery_frame(int64_t rx_us);
+
+/** Trace point at the start of update_values_inverter() */
+void latency_trace_map(void);
+
+/** Trace point for every frame the inverter integration sends */
+void latency_trace_inverter_tx(const CAN_frame& frame);
+
+uint8_t latency_trace_field_count(void);
+
+const LATENCY_TRACE_FIELD_TYPE& get_latency_trace(uint8_t index);
+
+#endif  // FUNCTION_TIME_MEASUREMENT
+#endif  // __LATENCY_TRACE_H__
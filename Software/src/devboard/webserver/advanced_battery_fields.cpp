@@ -0,0 +1,1092 @@
+#include "advanced_battery_fields.h"
+#include "../../datalayer/datalayer.h"
+#include "../../datalayer/datalayer_extended.h"
+
+#ifdef BOLT_AMPERA_BATTERY
+static const BATTERY_FIELD_TYPE boltampera_fields[] = {
+    FIELD_RAW("5V Reference", datalayer_extended.boltampera.battery_5V_ref, ""),
+    FIELD_RAW("Module 1 temp", datalayer_extended.boltampera.battery_module_temp_1, ""),
+    FIELD_RAW("Module 2 temp", datalayer_extended.boltampera.battery_module_temp_2, ""),
+    FIELD_RAW("Module 3 temp", datalayer_extended.boltampera.battery_module_temp_3, ""),
+    FIELD_RAW("Module 4 temp", datalayer_extended.boltampera.battery_module_temp_4, ""),
+    FIELD_RAW("Module 5 temp", datalayer_extended.boltampera.battery_module_temp_5, ""),
+    FIELD_RAW("Module 6 temp", datalayer_extended.boltampera.battery_module_temp_6, ""),
+    FIELD_RAW("Cell average voltage", datalayer_extended.boltampera.battery_cell_average_voltage, ""),
+    FIELD_RAW("Cell average voltage 2", datalayer_extended.boltampera.battery_cell_average_voltage_2, ""),
+    FIELD_RAW("Terminal voltage", datalayer_extended.boltampera.battery_terminal_voltage, ""),
+    FIELD_RAW("Ignition power mode", datalayer_extended.boltampera.battery_ignition_power_mode, ""),
+    FIELD_RAW("Battery current (7E7)", datalayer_extended.boltampera.battery_current_7E7, ""),
+    FIELD_RAW("Capacity MY17-18", datalayer_extended.boltampera.battery_capacity_my17_18, ""),
+    FIELD_RAW("Capacity MY19+", datalayer_extended.boltampera.battery_capacity_my19plus, ""),
+    FIELD_RAW("SOC Display", datalayer_extended.boltampera.battery_SOC_display, ""),
+    FIELD_RAW("SOC Raw highprec", datalayer_extended.boltampera.battery_SOC_raw_highprec, ""),
+    FIELD_RAW("Max temp", datalayer_extended.boltampera.battery_max_temperature, ""),
+    FIELD_RAW("Min temp", datalayer_extended.boltampera.battery_min_temperature, ""),
+    FIELD_RAW("Cell max mV", datalayer_extended.boltampera.battery_max_cell_voltage, ""),
+    FIELD_RAW("Cell min mV", datalayer_extended.boltampera.battery_min_cell_voltage, ""),
+    FIELD_RAW("Lowest cell", datalayer_extended.boltampera.battery_lowest_cell, ""),
+    FIELD_RAW("Highest cell", datalayer_extended.boltampera.battery_highest_cell, ""),
+    FIELD_RAW("Internal resistance", datalayer_extended.boltampera.battery_internal_resistance, ""),
+    FIELD_RAW("Voltage", datalayer_extended.boltampera.battery_voltage_polled, ""),
+    FIELD_RAW("Isolation Ohm", datalayer_extended.boltampera.battery_vehicle_isolation, ""),
+    FIELD_RAW("Isolation kOhm", datalayer_extended.boltampera.battery_isolation_kohm, ""),
+    FIELD_RAW("HV locked", datalayer_extended.boltampera.battery_HV_locked, ""),
+    FIELD_RAW("Crash event", datalayer_extended.boltampera.battery_crash_event, ""),
+    FIELD_RAW("HVIL", datalayer_extended.boltampera.battery_HVIL, ""),
+    FIELD_RAW("HVIL status", datalayer_extended.boltampera.battery_HVIL_status, ""),
+    FIELD_RAW("Current (7E4)", datalayer_extended.boltampera.battery_current_7E4, ""),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"PID polling", boltampera_fields, FIELD_ARRAY_SIZE(boltampera_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //BOLT_AMPERA_BATTERY
+
+#ifdef TESLA_BATTERY
+static const char* contactorText[] = {"UNKNOWN(0)",  "OPEN",        "CLOSING",    "BLOCKED", "OPENING",
+                                      "CLOSED",      "UNKNOWN(6)",  "WELDED",     "POS_CL",  "NEG_CL",
+                                      "UNKNOWN(10)", "UNKNOWN(11)", "UNKNOWN(12)"};
+static const char* hvilStatusState[] = {"NOT Ok",
+                                        "STATUS_OK",
+                                        "CURRENT_SOURCE_FAULT",
+                                        "INTERNAL_OPEN_FAULT",
+                                        "VEHICLE_OPEN_FAULT",
+                                        "PENTHOUSE_LID_OPEN_FAULT",
+                                        "UNKNOWN_LOCATION_OPEN_FAULT",
+                                        "VEHICLE_NODE_FAULT",
+                                        "NO_12V_SUPPLY",
+                                        "VEHICLE_OR_PENTHOUSE_LID_OPENFAULT",
+                                        "UNKNOWN(10)",
+                                        "UNKNOWN(11)",
+                                        "UNKNOWN(12)",
+                                        "UNKNOWN(13)",
+                                        "UNKNOWN(14)",
+                                        "UNKNOWN(15)"};
+static const char* contactorState[] = {"SNA",        "OPEN",       "PRECHARGE",   "BLOCKED",
+                                       "PULLED_IN",  "OPENING",    "ECONOMIZED",  "WELDED",
+                                       "UNKNOWN(8)", "UNKNOWN(9)", "UNKNOWN(10)", "UNKNOWN(11)"};
+static const char* BMS_state[] = {"STANDBY",     "DRIVE", "SUPPORT", "CHARGE", "FEIM",
+                                  "CLEAR_FAULT", "FAULT", "WELD",    "TEST",   "SNA"};
+static const char* BMS_contactorState[] = {"SNA", "OPEN", "OPENING", "CLOSING", "CLOSED", "WELDED", "BLOCKED"};
+static const char* BMS_hvState[] = {"DOWN",          "COMING_UP",        "GOING_DOWN", "UP_FOR_DRIVE",
+                                    "UP_FOR_CHARGE", "UP_FOR_DC_CHARGE", "UP"};
+static const char* BMS_uiChargeStatus[] = {"DISCONNECTED", "NO_POWER",        "ABOUT_TO_CHARGE",
+                                           "CHARGING",     "CHARGE_COMPLETE", "CHARGE_STOPPED"};
+static const char* PCS_dcdcStatus[] = {"IDLE", "ACTIVE", "FAULTED"};
+static const char* PCS_dcdcMainState[] = {"STANDBY",          "12V_SUPPORT_ACTIVE", "PRECHARGE_STARTUP",
+                                          "PRECHARGE_ACTIVE", "DIS_HVBUS_ACTIVE",   "SHUTDOWN",
+                                          "FAULTED"};
+static const char* PCS_dcdcSubState[] = {"PWR_UP_INIT",
+                                         "STANDBY",
+                                         "12V_SUPPORT_ACTIVE",
+                                         "DIS_HVBUS",
+                                         "PCHG_FAST_DIS_HVBUS",
+                                         "PCHG_SLOW_DIS_HVBUS",
+                                         "PCHG_DWELL_CHARGE",
+                                         "PCHG_DWELL_WAIT",
+                                         "PCHG_DI_RECOVERY_WAIT",
+                                         "PCHG_ACTIVE",
+                                         "PCHG_FLT_FAST_DIS_HVBUS",
+                                         "SHUTDOWN",
+                                         "12V_SUPPORT_FAULTED",
+                                         "DIS_HVBUS_FAULTED",
+                                         "PCHG_FAULTED",
+                                         "CLEAR_FAULTS",
+                                         "FAULTED",
+                                         "NUM"};
+static const char* BMS_powerLimitState[] = {"NOT_CALCULATED_FOR_DRIVE", "CALCULATED_FOR_DRIVE"};
+static const char* HVP_contactor[] = {"NOT_ACTIVE", "ACTIVE", "COMPLETED"};
+static const char* falseTrue[] = {"False", "True"};
+static const char* noYes[] = {"No", "Yes"};
+static const char* Fault[] = {"NOT_ACTIVE", "ACTIVE"};
+
+static String tesla_calculated_soh() {
+  if (datalayer_extended.tesla.battery_beginning_of_life == 0) {
+    return String("-");
+  }
+  float full_pack_energy = datalayer_extended.tesla.BMS352_mux
+                               ? datalayer_extended.tesla.battery_nominal_full_pack_energy_m0 * 0.02
+                               : datalayer_extended.tesla.battery_nominal_full_pack_energy * 0.1;
+  return String(full_pack_energy * 100 / datalayer_extended.tesla.battery_beginning_of_life);
+}
+
+static bool tesla_bms352_without_mux() {
+  return !datalayer_extended.tesla.BMS352_mux;
+}
+
+static bool tesla_bms352_with_mux() {
+  return datalayer_extended.tesla.BMS352_mux;
+}
+
+//0x20A 522 HVP_contatorState
+static const BATTERY_FIELD_TYPE tesla_contactor_fields[] = {
+    FIELD_STATE("Contactor Status", datalayer_extended.tesla.status_contactor, contactorText),
+    FIELD_STATE("HVIL", datalayer_extended.tesla.hvil_status, hvilStatusState),
+    FIELD_STATE("Negative contactor", datalayer_extended.tesla.packContNegativeState, contactorState),
+    FIELD_STATE("Positive contactor", datalayer_extended.tesla.packContPositiveState, contactorState),
+    FIELD_STATE("Closing allowed?", datalayer_extended.tesla.packCtrsClosingAllowed, noYes),
+    FIELD_STATE("Pyrotest in Progress", datalayer_extended.tesla.pyroTestInProgress, noYes),
+    FIELD_STATE("Contactors Open Now Requested", datalayer_extended.tesla.battery_packCtrsOpenNowRequested, noYes),
+    FIELD_STATE("Contactors Open Requested", datalayer_extended.tesla.battery_packCtrsOpenRequested, noYes),
+    FIELD_STATE("Contactors Request Status", datalayer_extended.tesla.battery_packCtrsRequestStatus, HVP_contactor),
+    FIELD_STATE("Contactors Reset Request Required", datalayer_extended.tesla.battery_packCtrsResetRequestRequired,
+                noYes),
+    FIELD_STATE("DC Link Allowed to Energize", datalayer_extended.tesla.battery_dcLinkAllowedToEnergize, noYes),
+    FIELD_ASCII("BMS Serial number", datalayer_extended.tesla.BMS_SerialNumber),
+};
+
+//0x352 850 BMS_energyStatus, older BMS <2021 without mux
+static const BATTERY_FIELD_TYPE tesla_energy_fields[] = {
+    FIELD_FUNCTION("Calculated SOH", tesla_calculated_soh, ""),
+    FIELD_SCALED("Nominal Full Pack Energy", datalayer_extended.tesla.battery_nominal_full_pack_energy, 0.1, 0, "KWh"),
+    FIELD_SCALED("Nominal Energy Remaining", datalayer_extended.tesla.battery_nominal_energy_remaining, 0.1, 0, "KWh"),
+    FIELD_SCALED("Ideal Energy Remaining", datalayer_extended.tesla.battery_ideal_energy_remaining, 0.1, 0, "KWh"),
+    FIELD_SCALED("Energy to Charge Complete", datalayer_extended.tesla.battery_energy_to_charge_complete, 0.1, 0,
+                 "KWh"),
+    FIELD_SCALED("Energy Buffer", datalayer_extended.tesla.battery_energy_buffer, 0.1, 0, "KWh"),
+    FIELD_STATE("Full Charge Complete", datalayer_extended.tesla.battery_full_charge_complete, noYes),
+};
+
+//0x352 850 BMS_energyStatus, newer BMS >2021 with mux
+static const BATTERY_FIELD_TYPE tesla_energy_mux_fields[] = {
+    FIELD_FUNCTION("Calculated SOH", tesla_calculated_soh, ""),
+    FIELD_SCALED("Nominal Full Pack Energy", datalayer_extended.tesla.battery_nominal_full_pack_energy_m0, 0.02, 0,
+                 "KWh"),
+    FIELD_SCALED("Nominal Energy Remaining", datalayer_extended.tesla.battery_nominal_energy_remaining_m0, 0.02, 0,
+                 "KWh"),
+    FIELD_SCALED("Ideal Energy Remaining", datalayer_extended.tesla.battery_ideal_energy_remaining_m0, 0.02, 0, "KWh"),
+    FIELD_SCALED("Energy to Charge Complete", datalayer_extended.tesla.battery_energy_to_charge_complete_m1, 0.02, 0,
+                 "KWh"),
+    FIELD_SCALED("Energy Buffer", datalayer_extended.tesla.battery_energy_buffer_m1, 0.01, 0, "KWh"),
+    FIELD_SCALED("Expected Energy Remaining", datalayer_extended.tesla.battery_expected_energy_remaining_m1, 0.02, 0,
+                 "KWh"),
+    FIELD_STATE("Fully Charged", datalayer_extended.tesla.battery_fully_charged, noYes),
+};
+
+static const BATTERY_FIELD_TYPE tesla_soc_fields[] = {
+    //0x3D2 978 BMS_kwhCounter
+    FIELD_SCALED("Total Discharge", datalayer.battery.status.total_discharged_battery_Wh, 0.001, 0, "KWh"),
+    FIELD_SCALED("Total Charge", datalayer.battery.status.total_charged_battery_Wh, 0.001, 0, "KWh"),
+    //0x292 658 BMS_socStates
+    FIELD_RAW("Battery Beginning of Life", datalayer_extended.tesla.battery_beginning_of_life, "KWh"),
+    FIELD_SCALED("Battery SOC UI", datalayer_extended.tesla.battery_soc_ui, 0.1, 0, ""),
+    FIELD_SCALED("Battery SOC Ave", datalayer_extended.tesla.battery_soc_ave, 0.1, 0, ""),
+    FIELD_SCALED("Battery SOC Max", datalayer_extended.tesla.battery_soc_max, 0.1, 0, ""),
+    FIELD_SCALED("Battery SOC Min", datalayer_extended.tesla.battery_soc_min, 0.1, 0, ""),
+    FIELD_SCALED("Battery Temp Percent", datalayer_extended.tesla.battery_battTempPct, 0.4, 0, ""),
+};
+
+static const BATTERY_FIELD_TYPE tesla_limit_fields[] = {
+    //0x392 BMS_packConfig
+    FIELD_RAW("Battery Pack Mass", datalayer_extended.tesla.battery_packMass, "KG"),
+    FIELD_SCALED("Platform Max Bus Voltage", datalayer_extended.tesla.battery_platformMaxBusVoltage, 0.1, 375, "V"),
+    //0x2D2 722 BMSVAlimits
+    FIELD_SCALED("BMS Min Voltage", datalayer_extended.tesla.battery_bms_min_voltage, 0.02, 0, "V"),
+    FIELD_SCALED("BMS Max Voltage", datalayer_extended.tesla.battery_bms_max_voltage, 0.02, 0, "V"),
+    FIELD_RAW("Max Charge Current", datalayer_extended.tesla.battery_max_charge_current, "A"),
+    FIELD_RAW("Max Discharge Current", datalayer_extended.tesla.battery_max_discharge_current, "A"),
+    //0x332 818 BMS_bmbMinMax
+    FIELD_SCALED("Brick Voltage Max", datalayer_extended.tesla.battery_BrickVoltageMax, 0.002, 0, "V"),
+    FIELD_SCALED("Brick Voltage Min", datalayer_extended.tesla.battery_BrickVoltageMin, 0.002, 0, "V"),
+    FIELD_RAW("Brick Temp Max Num", datalayer_extended.tesla.battery_BrickTempMaxNum, ""),
+    FIELD_RAW("Brick Temp Min Num", datalayer_extended.tesla.battery_BrickTempMinNum, ""),
+    //0x252 594 BMS_powerAvailable
+    FIELD_SCALED("Max Regen Power", datalayer_extended.tesla.BMS_maxRegenPower, 0.01, 0, "KW"),
+    FIELD_SCALED("Max Discharge Power", datalayer_extended.tesla.BMS_maxDischargePower, 0.013, 0, "KW"),
+    FIELD_STATE("Power Limit State", datalayer_extended.tesla.BMS_powerLimitState, BMS_powerLimitState),
+};
+
+static const BATTERY_FIELD_TYPE tesla_status_fields[] = {
+    //0x212 530 BMS_status
+    FIELD_SCALED("Isolation Resistance", datalayer_extended.tesla.battery_BMS_isolationResistance, 10, 0, "kOhms"),
+    FIELD_STATE("BMS Contactor State", datalayer_extended.tesla.battery_BMS_contactorState, BMS_contactorState),
+    FIELD_STATE("BMS State", datalayer_extended.tesla.battery_BMS_state, BMS_state),
+    FIELD_STATE("BMS HV State", datalayer_extended.tesla.battery_BMS_hvState, BMS_hvState),
+    FIELD_STATE("BMS UI Charge Status", datalayer_extended.tesla.battery_BMS_uiChargeStatus, BMS_uiChargeStatus),
+    FIELD_STATE("BMS PCS PWM Enabled", datalayer_extended.tesla.battery_BMS_pcsPwmEnabled, Fault),
+};
+
+static const BATTERY_FIELD_TYPE tesla_thermal_fields[] = {
+    //0x2A4 676 PCS_thermalStatus
+    FIELD_SCALED("PCS dcdc Temp", datalayer_extended.tesla.PCS_dcdcTemp, 0.1, 40, "DegC"),
+    FIELD_SCALED("PCS Ambient Temp", datalayer_extended.tesla.PCS_ambientTemp, 0.1, 40, "DegC"),
+    FIELD_SCALED("PCS Chg PhA Temp", datalayer_extended.tesla.PCS_chgPhATemp, 0.1, 40, "DegC"),
+    FIELD_SCALED("PCS Chg PhB Temp", datalayer_extended.tesla.PCS_chgPhBTemp, 0.1, 40, "DegC"),
+    FIELD_SCALED("PCS Chg PhC Temp", datalayer_extended.tesla.PCS_chgPhCTemp, 0.1, 40, "DegC"),
+    //0x312 786 BMS_thermalStatus
+    FIELD_SCALED("Power Dissipation", datalayer_extended.tesla.BMS_powerDissipation, 0.02, 0, "kW"),
+    FIELD_SCALED("Flow Request", datalayer_extended.tesla.BMS_flowRequest, 0.3, 0, "LPM"),
+    FIELD_SCALED("Inlet Active Cool Target Temp", datalayer_extended.tesla.BMS_inletActiveCoolTargetT, 0.25, -25,
+                 "DegC"),
+    FIELD_SCALED("Inlet Passive Target Temp", datalayer_extended.tesla.BMS_inletPassiveTargetT, 0.25, -25, "DegC"),
+    FIELD_SCALED("Inlet Active Heat Target Temp", datalayer_extended.tesla.BMS_inletActiveHeatTargetT, 0.25, -25,
+                 "DegC"),
+    FIELD_SCALED("Pack Temp Min", datalayer_extended.tesla.BMS_packTMin, 0.25, -25, "DegC"),
+    FIELD_SCALED("Pack Temp Max", datalayer_extended.tesla.BMS_packTMax, 0.25, -25, "DegC"),
+    FIELD_STATE("PCS No Flow Request", datalayer_extended.tesla.BMS_pcsNoFlowRequest, Fault),
+    FIELD_STATE("BMS No Flow Request", datalayer_extended.tesla.BMS_noFlowRequest, Fault),
+};
+
+static const BATTERY_FIELD_TYPE tesla_dcdc_fields[] = {
+    //0x2B4 PCS_dcdcRailStatus
+    FIELD_SCALED("PCS Lv Output", datalayer_extended.tesla.battery_dcdcLvOutputCurrent, 0.1, 0, "A"),
+    FIELD_SCALED("PCS Lv Bus", datalayer_extended.tesla.battery_dcdcLvBusVolt, 0.0390625, 0, "V"),
+    FIELD_SCALED("PCS Hv Bus", datalayer_extended.tesla.battery_dcdcHvBusVolt, 0.146484, 0, "V"),
+    //0x224 548 PCS_dcdcStatus
+    FIELD_STATE("Precharge Status", datalayer_extended.tesla.battery_PCS_dcdcPrechargeStatus, PCS_dcdcStatus),
+    FIELD_STATE("12V Support Status", datalayer_extended.tesla.battery_PCS_dcdc12VSupportStatus, PCS_dcdcStatus),
+    FIELD_STATE("HV Bus Discharge Status", datalayer_extended.tesla.battery_PCS_dcdcHvBusDischargeStatus,
+                PCS_dcdcStatus),
+    FIELD_STATE("Main State", datalayer_extended.tesla.battery_PCS_dcdcMainState, PCS_dcdcMainState),
+    FIELD_STATE("Sub State", datalayer_extended.tesla.battery_PCS_dcdcSubState, PCS_dcdcSubState),
+    FIELD_STATE("PCS Faulted", datalayer_extended.tesla.battery_PCS_dcdcFaulted, Fault),
+    FIELD_STATE("Output Is Limited", datalayer_extended.tesla.battery_PCS_dcdcOutputIsLimited, Fault),
+    FIELD_SCALED("Max Output Current Allowed", datalayer_extended.tesla.battery_PCS_dcdcMaxOutputCurrentAllowed, 0.1, 0,
+                 "A"),
+    FIELD_STATE("Precharge Rty Cnt", datalayer_extended.tesla.battery_PCS_dcdcPrechargeRtyCnt, falseTrue),
+    FIELD_STATE("12V Support Rty Cnt", datalayer_extended.tesla.battery_PCS_dcdc12VSupportRtyCnt, falseTrue),
+    FIELD_STATE("Discharge Rty Cnt", datalayer_extended.tesla.battery_PCS_dcdcDischargeRtyCnt, falseTrue),
+    FIELD_STATE("PWM Enable Line", datalayer_extended.tesla.battery_PCS_dcdcPwmEnableLine, Fault),
+    FIELD_STATE("Supporting Fixed LV Target", datalayer_extended.tesla.battery_PCS_dcdcSupportingFixedLvTarget, Fault),
+    FIELD_STATE("Precharge Restart Cnt", datalayer_extended.tesla.battery_PCS_dcdcPrechargeRestartCnt, falseTrue),
+    FIELD_STATE("Initial Precharge Substate", datalayer_extended.tesla.battery_PCS_dcdcInitialPrechargeSubState,
+                PCS_dcdcSubState),
+};
+
+//0x2C4 708 PCS_logging
+static const BATTERY_FIELD_TYPE tesla_pcs_logging_fields[] = {
+    FIELD_SCALED("PCS_dcdcMaxLvOutputCurrent", datalayer_extended.tesla.PCS_dcdcMaxLvOutputCurrent, 0.1, 0, "A"),
+    FIELD_SCALED("PCS_dcdcCurrentLimit", datalayer_extended.tesla.PCS_dcdcCurrentLimit, 0.1, 0, "A"),
+    FIELD_SCALED("PCS_dcdcLvOutputCurrentTempLimit", datalayer_extended.tesla.PCS_dcdcLvOutputCurrentTempLimit, 0.1, 0,
+                 "A"),
+    FIELD_SCALED("PCS_dcdcUnifiedCommand", datalayer_extended.tesla.PCS_dcdcUnifiedCommand, 0.001, 0, ""),
+    FIELD_SCALED("PCS_dcdcCLAControllerOutput", datalayer_extended.tesla.PCS_dcdcCLAControllerOutput, 0.001, 0, ""),
+    FIELD_RAW("PCS_dcdcTankVoltage", datalayer_extended.tesla.PCS_dcdcTankVoltage, "V"),
+    FIELD_RAW("PCS_dcdcTankVoltageTarget", datalayer_extended.tesla.PCS_dcdcTankVoltageTarget, "V"),
+    FIELD_SCALED("PCS_dcdcClaCurrentFreq", datalayer_extended.tesla.PCS_dcdcClaCurrentFreq, 0.0976563, 0, "kHz"),
+    FIELD_SCALED("PCS_dcdcTCommMeasured", datalayer_extended.tesla.PCS_dcdcTCommMeasured, 0.00195313, 0, "us"),
+    FIELD_SCALED("PCS_dcdcShortTimeUs", datalayer_extended.tesla.PCS_dcdcShortTimeUs, 0.000488281, 0, "us"),
+    FIELD_SCALED("PCS_dcdcHalfPeriodUs", datalayer_extended.tesla.PCS_dcdcHalfPeriodUs, 0.000488281, 0, "us"),
+    FIELD_RAW("PCS_dcdcIntervalMaxFrequency", datalayer_extended.tesla.PCS_dcdcIntervalMaxFrequency, "kHz"),
+    FIELD_SCALED("PCS_dcdcIntervalMaxHvBusVolt", datalayer_extended.tesla.PCS_dcdcIntervalMaxHvBusVolt, 0.1, 0, "V"),
+    FIELD_SCALED("PCS_dcdcIntervalMaxLvBusVolt", datalayer_extended.tesla.PCS_dcdcIntervalMaxLvBusVolt, 0.1, 0, "V"),
+    FIELD_RAW("PCS_dcdcIntervalMaxLvOutputCurr", datalayer_extended.tesla.PCS_dcdcIntervalMaxLvOutputCurr, "A"),
+    FIELD_RAW("PCS_dcdcIntervalMinFrequency", datalayer_extended.tesla.PCS_dcdcIntervalMinFrequency, "kHz"),
+    FIELD_SCALED("PCS_dcdcIntervalMinHvBusVolt", datalayer_extended.tesla.PCS_dcdcIntervalMinHvBusVolt, 0.1, 0, "V"),
+    FIELD_SCALED("PCS_dcdcIntervalMinLvBusVolt", datalayer_extended.tesla.PCS_dcdcIntervalMinLvBusVolt, 0.1, 0, "V"),
+    FIELD_RAW("PCS_dcdcIntervalMinLvOutputCurr", datalayer_extended.tesla.PCS_dcdcIntervalMinLvOutputCurr, "A"),
+    FIELD_SCALED("PCS_dcdc12vSupportLifetimekWh", datalayer_extended.tesla.PCS_dcdc12vSupportLifetimekWh, 0.01, 0,
+                 "kWh"),
+};
+
+//0x7AA 1962 HVP_debugMessage
+static const BATTERY_FIELD_TYPE tesla_hvp_fields[] = {
+    FIELD_SCALED("HVP_battery12V", datalayer_extended.tesla.HVP_battery12V, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_dcLinkVoltage", datalayer_extended.tesla.HVP_dcLinkVoltage, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_packVoltage", datalayer_extended.tesla.HVP_packVoltage, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_packContVoltage", datalayer_extended.tesla.HVP_packContVoltage, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_packContCoilCurrent", datalayer_extended.tesla.HVP_packContCoilCurrent, 0.1, 0, "A"),
+    FIELD_SCALED("HVP_pyroAnalog", datalayer_extended.tesla.HVP_pyroAnalog, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_hvp1v5Ref", datalayer_extended.tesla.HVP_hvp1v5Ref, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_hvilInVoltage", datalayer_extended.tesla.HVP_hvilInVoltage, 0.1, 0, "V"),
+    FIELD_SCALED("HVP_hvilOutVoltage", datalayer_extended.tesla.HVP_hvilOutVoltage, 0.1, 0, "V"),
+    FIELD_STATE("HVP_gpioPassivePyroDepl", datalayer_extended.tesla.HVP_gpioPassivePyroDepl, Fault),
+    FIELD_STATE("HVP_gpioPyroIsoEn", datalayer_extended.tesla.HVP_gpioPyroIsoEn, Fault),
+    FIELD_STATE("HVP_gpioCpFaultIn", datalayer_extended.tesla.HVP_gpioCpFaultIn, Fault),
+    FIELD_STATE("HVP_gpioPackContPowerEn", datalayer_extended.tesla.HVP_gpioPackContPowerEn, Fault),
+    FIELD_STATE("HVP_gpioHvCablesOk", datalayer_extended.tesla.HVP_gpioHvCablesOk, Fault),
+    FIELD_STATE("HVP_gpioHvpSelfEnable", datalayer_extended.tesla.HVP_gpioHvpSelfEnable, Fault),
+    FIELD_STATE("HVP_gpioLed", datalayer_extended.tesla.HVP_gpioLed, Fault),
+    FIELD_STATE("HVP_gpioCrashSignal", datalayer_extended.tesla.HVP_gpioCrashSignal, Fault),
+    FIELD_STATE("HVP_gpioShuntDataReady", datalayer_extended.tesla.HVP_gpioShuntDataReady, Fault),
+    FIELD_STATE("HVP_gpioFcContPosAux", datalayer_extended.tesla.HVP_gpioFcContPosAux, Fault),
+    FIELD_STATE("HVP_gpioFcContNegAux", datalayer_extended.tesla.HVP_gpioFcContNegAux, Fault),
+    FIELD_STATE("HVP_gpioBmsEout", datalayer_extended.tesla.HVP_gpioBmsEout, Fault),
+    FIELD_STATE("HVP_gpioCpFaultOut", datalayer_extended.tesla.HVP_gpioCpFaultOut, Fault),
+    FIELD_STATE("HVP_gpioPyroPor", datalayer_extended.tesla.HVP_gpioPyroPor, Fault),
+    FIELD_STATE("HVP_gpioShuntEn", datalayer_extended.tesla.HVP_gpioShuntEn, Fault),
+    FIELD_STATE("HVP_gpioHvpVerEn", datalayer_extended.tesla.HVP_gpioHvpVerEn, Fault),
+    FIELD_STATE("HVP_gpioPackCoontPosFlywheel", datalayer_extended.tesla.HVP_gpioPackCoontPosFlywheel, Fault),
+    FIELD_STATE("HVP_gpioCpLatchEnable", datalayer_extended.tesla.HVP_gpioCpLatchEnable, Fault),
+    FIELD_STATE("HVP_gpioPcsEnable", datalayer_extended.tesla.HVP_gpioPcsEnable, Fault),
+    FIELD_STATE("HVP_gpioPcsDcdcPwmEnable", datalayer_extended.tesla.HVP_gpioPcsDcdcPwmEnable, Fault),
+    FIELD_STATE("HVP_gpioPcsChargePwmEnable", datalayer_extended.tesla.HVP_gpioPcsChargePwmEnable, Fault),
+    FIELD_STATE("HVP_gpioFcContPowerEnable", datalayer_extended.tesla.HVP_gpioFcContPowerEnable, Fault),
+    FIELD_STATE("HVP_gpioHvilEnable", datalayer_extended.tesla.HVP_gpioHvilEnable, Fault),
+    FIELD_STATE("HVP_gpioSecDrdy", datalayer_extended.tesla.HVP_gpioSecDrdy, Fault),
+    FIELD_SCALED("HVP_shuntCurrentDebug", datalayer_extended.tesla.HVP_shuntCurrentDebug, 0.1, 0, "A"),
+    FIELD_STATE("HVP_packCurrentMia", datalayer_extended.tesla.HVP_packCurrentMia, noYes),
+    FIELD_STATE("HVP_auxCurrentMia", datalayer_extended.tesla.HVP_auxCurrentMia, noYes),
+    FIELD_STATE("HVP_currentSenseMia", datalayer_extended.tesla.HVP_currentSenseMia, noYes),
+    FIELD_STATE("HVP_shuntRefVoltageMismatch", datalayer_extended.tesla.HVP_shuntRefVoltageMismatch, noYes),
+    FIELD_STATE("HVP_shuntThermistorMia", datalayer_extended.tesla.HVP_shuntThermistorMia, noYes),
+    FIELD_STATE("HVP_shuntHwMia", datalayer_extended.tesla.HVP_shuntHwMia, noYes),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Contactors", tesla_contactor_fields, FIELD_ARRAY_SIZE(tesla_contactor_fields), nullptr},
+    {"BMS 0x352 w/o mux", tesla_energy_fields, FIELD_ARRAY_SIZE(tesla_energy_fields), tesla_bms352_without_mux},
+    {"BMS 0x352 w/ mux", tesla_energy_mux_fields, FIELD_ARRAY_SIZE(tesla_energy_mux_fields), tesla_bms352_with_mux},
+    {"Energy counters and SOC", tesla_soc_fields, FIELD_ARRAY_SIZE(tesla_soc_fields), nullptr},
+    {"Pack limits", tesla_limit_fields, FIELD_ARRAY_SIZE(tesla_limit_fields), nullptr},
+    {"BMS status", tesla_status_fields, FIELD_ARRAY_SIZE(tesla_status_fields), nullptr},
+    {"Thermal", tesla_thermal_fields, FIELD_ARRAY_SIZE(tesla_thermal_fields), nullptr},
+    {"PCS DCDC", tesla_dcdc_fields, FIELD_ARRAY_SIZE(tesla_dcdc_fields), nullptr},
+    {"PCS logging", tesla_pcs_logging_fields, FIELD_ARRAY_SIZE(tesla_pcs_logging_fields), nullptr},
+    {"HVP debug", tesla_hvp_fields, FIELD_ARRAY_SIZE(tesla_hvp_fields), nullptr},
+};
+const char* battery_section_actions =
+    "<button onclick='askTeslaClearIsolation()'>Clear isolation fault</button>"
+    "<button onclick='askTeslaResetBMS()'>BMS reset</button>";
+#endif  //TESLA_BATTERY
+
+#ifdef NISSAN_LEAF_BATTERY
+static const char* LEAFgen[] = {"ZE0", "AZE0", "ZE1"};
+
+static String nissanleaf_solved_challenge() {
+  return String(datalayer_extended.nissanleaf.SolvedChallengeMSB) +
+         String(datalayer_extended.nissanleaf.SolvedChallengeLSB);
+}
+
+static const BATTERY_FIELD_TYPE nissanleaf_fields[] = {
+    FIELD_STATE("LEAF generation", datalayer_extended.nissanleaf.LEAF_gen, LEAFgen),
+    FIELD_ASCII("Serial number", datalayer_extended.nissanleaf.BatterySerialNumber),
+    FIELD_ASCII("Part number", datalayer_extended.nissanleaf.BatteryPartNumber),
+    FIELD_ASCII("BMS ID", datalayer_extended.nissanleaf.BMSIDcode),
+    FIELD_RAW("GIDS", datalayer_extended.nissanleaf.GIDS, ""),
+    FIELD_RAW("Regen kW", datalayer_extended.nissanleaf.ChargePowerLimit, ""),
+    FIELD_RAW("Charge kW", datalayer_extended.nissanleaf.MaxPowerForCharger, ""),
+    FIELD_RAW("Interlock", datalayer_extended.nissanleaf.Interlock, ""),
+    FIELD_RAW("Insulation", datalayer_extended.nissanleaf.Insulation, ""),
+    FIELD_RAW("Relay cut request", datalayer_extended.nissanleaf.RelayCutRequest, ""),
+    FIELD_RAW("Failsafe status", datalayer_extended.nissanleaf.FailsafeStatus, ""),
+    FIELD_RAW("Fully charged", datalayer_extended.nissanleaf.Full, ""),
+    FIELD_RAW("Battery empty", datalayer_extended.nissanleaf.Empty, ""),
+    FIELD_RAW("Main relay ON", datalayer_extended.nissanleaf.MainRelayOn, ""),
+    FIELD_RAW("Heater present", datalayer_extended.nissanleaf.HeatExist, ""),
+    FIELD_RAW("Heating stopped", datalayer_extended.nissanleaf.HeatingStop, ""),
+    FIELD_RAW("Heating started", datalayer_extended.nissanleaf.HeatingStart, ""),
+    FIELD_RAW("Heating requested", datalayer_extended.nissanleaf.HeaterSendRequest, ""),
+};
+
+static const BATTERY_FIELD_TYPE nissanleaf_crypto_fields[] = {
+    FIELD_RAW("CryptoChallenge", datalayer_extended.nissanleaf.CryptoChallenge, ""),
+    FIELD_FUNCTION("SolvedChallenge", nissanleaf_solved_challenge, ""),
+    FIELD_RAW("Challenge failed", datalayer_extended.nissanleaf.challengeFailed, ""),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", nissanleaf_fields, FIELD_ARRAY_SIZE(nissanleaf_fields), nullptr},
+    {"Degradation reset", nissanleaf_crypto_fields, FIELD_ARRAY_SIZE(nissanleaf_crypto_fields), nullptr},
+};
+const char* battery_section_actions = "<button onclick='askResetSOH()'>Reset degradation data</button>";
+#endif  //NISSAN_LEAF_BATTERY
+
+#ifdef MEB_BATTERY
+static const char* okMissing[] = {"OK", "Missing!"};
+static const char* okOpen[] = {"OK", "Open!"};
+static const char* okLocked[] = {"OK", "Locked!"};
+static const char* noActive[] = {"No", "Active!"};
+static const char* offActive[] = {"Off", "Active!"};
+static const char* inactiveActive[] = {"Inactive", "Active!"};
+static const char* offOn[] = {"Off", "ON!"};
+static const char* notActiveActive[] = {"not active", "active"};
+static const char* notRequestedRequested[] = {"not requested", "requested"};
+static const char* circuitStatus[] = {"Init", "Closed", "Open!", "Fault"};
+static const char* BMS_mode[] = {"HV inactive", "HV active",     "Balancing",   "Extern charging",
+                                 "AC charging", "Battery error", "DC charging", "Init"};
+static const char* balancingStatus[] = {"init", "active", "inactive"};
+static const char* diagnosticStatus[] = {"Init", "Battery display",       "?",    "?", "Battery display OK",
+                                         "?",    "Battery display check", "Fault"};
+static const char* HVlineStatus[] = {"Init", "No open HV line detected", "Open HV line", "Fault"};
+static const char* weldedStatus[] = {"Init", "No contactor welded", "At least 1 contactor welded",
+                                     "Protection status detection error"};
+static const char* warningSupport[] = {"OK", "Not OK", "?", "?", "?", "?", "Init", "Fault"};
+static const char* voltageFreeStatus[] = {"Init", "BMS interm circuit voltage free (U<20V)",
+                                          "BMS interm circuit not voltage free (U >= 25V)", "Error"};
+static const char* BMS_errorStatus[] = {"Component IO", "Iso Error 1",     "Iso Error 2",           "Interlock",
+                                        "SD",           "Performance red", "No component function", "Init"};
+static const char* rtErrorLevel[] = {"No", "Error level 1", "Error level 2", "Error level 3"};
+
+static String meb_temperature_points() {
+  String text;
+  for (uint8_t i = 0; i < FIELD_ARRAY_SIZE(datalayer_extended.meb.temp_points); i++) {
+    text += String(datalayer_extended.meb.temp_points[i], 1) + " ";
+  }
+  return text;
+}
+
+static String meb_cell_temperatures() {
+  String text;
+  for (uint8_t i = 0; i < FIELD_ARRAY_SIZE(datalayer_extended.meb.celltemperature_dC); i++) {
+    if (datalayer_extended.meb.celltemperature_dC[i] == 865) {
+      break;  // First unused sensor
+    }
+    text += String(datalayer_extended.meb.celltemperature_dC[i] / 10.f, 1) + " ";
+  }
+  return text;
+}
+
+static const BATTERY_FIELD_TYPE meb_status_fields[] = {
+    FIELD_STATE("Service disconnect switch", datalayer_extended.meb.SDSW, okMissing),
+    FIELD_STATE("Pilotline", datalayer_extended.meb.pilotline, okOpen),
+    FIELD_STATE("Transportmode", datalayer_extended.meb.transportmode, okLocked),
+    FIELD_STATE("Shutdown", datalayer_extended.meb.shutdown_active, noActive),
+    FIELD_STATE("Component protection", datalayer_extended.meb.componentprotection, noActive),
+    FIELD_STATE("HVIL status", datalayer_extended.meb.HVIL, circuitStatus),
+    FIELD_STATE("KL30C status", datalayer_extended.meb.BMS_Kl30c_Status, circuitStatus),
+    FIELD_STATE("BMS mode", datalayer_extended.meb.BMS_mode, BMS_mode),
+    FIELD_STATE("Charging", datalayer_extended.meb.charging_active, notActiveActive),
+    FIELD_STATE("Balancing", datalayer_extended.meb.balancing_active, balancingStatus),
+    FIELD_STATE("Slow charging", datalayer_extended.meb.balancing_request, notRequestedRequested),
+    FIELD_STATE("Diagnostic", datalayer_extended.meb.battery_diagnostic, diagnosticStatus),
+    FIELD_STATE("HV line status", datalayer_extended.meb.status_HV_line, HVlineStatus),
+    FIELD_STATE("Welded contactors", datalayer_extended.meb.BMS_welded_contactors_status, weldedStatus),
+    FIELD_STATE("Warning support", datalayer_extended.meb.warning_support, warningSupport),
+    FIELD_SCALED("Interm. voltage", datalayer_extended.meb.BMS_voltage_intermediate_dV, 0.1, 0, "V"),
+    FIELD_STATE("Interm. voltage status", datalayer_extended.meb.BMS_status_voltage_free, voltageFreeStatus),
+    FIELD_SCALED("BMS voltage", datalayer_extended.meb.BMS_voltage_dV, 0.1, 0, "V"),
+    FIELD_RAW("Isolation resistance", datalayer_extended.meb.isolation_resistance, "kOhm"),
+    FIELD_STATE("Battery heating", datalayer_extended.meb.battery_heating, offActive),
+};
+
+static const BATTERY_FIELD_TYPE meb_fault_fields[] = {
+    FIELD_STATE("BMS fault performance", datalayer_extended.meb.BMS_fault_performance, offActive),
+    FIELD_STATE("BMS fault emergency shutdown crash", datalayer_extended.meb.BMS_fault_emergency_shutdown_crash,
+                offActive),
+    FIELD_STATE("BMS error shutdown request", datalayer_extended.meb.BMS_error_shutdown_request, inactiveActive),
+    FIELD_STATE("BMS error shutdown", datalayer_extended.meb.BMS_error_shutdown, offActive),
+    FIELD_STATE("BMS error status", datalayer_extended.meb.BMS_error_status, BMS_errorStatus),
+    FIELD_STATE("OBD MIL", datalayer_extended.meb.BMS_OBD_MIL, offOn),
+    FIELD_STATE("Red error lamp", datalayer_extended.meb.BMS_error_lamp_req, offOn),
+    FIELD_STATE("Yellow warning lamp", datalayer_extended.meb.BMS_warning_lamp_req, offOn),
+    FIELD_STATE("Overcurrent", datalayer_extended.meb.rt_overcurrent, rtErrorLevel),
+    FIELD_STATE("CAN fault", datalayer_extended.meb.rt_CAN_fault, rtErrorLevel),
+    FIELD_STATE("Overcharged", datalayer_extended.meb.rt_overcharge, rtErrorLevel),
+    FIELD_STATE("SOC too high", datalayer_extended.meb.rt_SOC_high, rtErrorLevel),
+    FIELD_STATE("SOC too low", datalayer_extended.meb.rt_SOC_low, rtErrorLevel),
+    FIELD_STATE("SOC jumping", datalayer_extended.meb.rt_SOC_jumping, rtErrorLevel),
+    FIELD_STATE("Temp difference", datalayer_extended.meb.rt_temp_difference, rtErrorLevel),
+    FIELD_STATE("Cell overtemp", datalayer_extended.meb.rt_cell_overtemp, rtErrorLevel),
+    FIELD_STATE("Cell undertemp", datalayer_extended.meb.rt_cell_undertemp, rtErrorLevel),
+    FIELD_STATE("Battery overvoltage", datalayer_extended.meb.rt_battery_overvolt, rtErrorLevel),
+    FIELD_STATE("Battery undervoltage", datalayer_extended.meb.rt_battery_undervol, rtErrorLevel),
+    FIELD_STATE("Cell overvoltage", datalayer_extended.meb.rt_cell_overvolt, rtErrorLevel),
+    FIELD_STATE("Cell undervoltage", datalayer_extended.meb.rt_cell_undervol, rtErrorLevel),
+    FIELD_STATE("Cell imbalance", datalayer_extended.meb.rt_cell_imbalance, rtErrorLevel),
+    FIELD_STATE("Battery unathorized", datalayer_extended.meb.rt_battery_unathorized, rtErrorLevel),
+};
+
+static const BATTERY_FIELD_TYPE meb_temperature_fields[] = {
+    FIELD_SCALED("Battery temperature", datalayer_extended.meb.battery_temperature_dC, 0.1, 0, "DegC"),
+    FIELD_FUNCTION("Temperature points", meb_temperature_points, "DegC"),
+    FIELD_FUNCTION("Cell temperatures", meb_cell_temperatures, "DegC"),
+};
+
+static const BATTERY_FIELD_TYPE meb_energy_fields[] = {
+    FIELD_SCALED("Total charged", datalayer.battery.status.total_charged_battery_Wh, 0.001, 0, "kWh"),
+    FIELD_SCALED("Total discharged", datalayer.battery.status.total_discharged_battery_Wh, 0.001, 0, "kWh"),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Status", meb_status_fields, FIELD_ARRAY_SIZE(meb_status_fields), nullptr},
+    {"Faults", meb_fault_fields, FIELD_ARRAY_SIZE(meb_fault_fields), nullptr},
+    {"Temperatures", meb_temperature_fields, FIELD_ARRAY_SIZE(meb_temperature_fields), nullptr},
+    {"Energy counters", meb_energy_fields, FIELD_ARRAY_SIZE(meb_energy_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //MEB_BATTERY
+
+#ifdef BMW_IX_BATTERY
+static const char* balanceText[] = {"0 No balancing mode active", "1 Voltage-Controlled Balancing Mode",
+                                    "2 Time-Controlled Balancing Mode with Demand Calculation at End of Charging",
+                                    "3 Time-Controlled Balancing Mode with Demand Calculation at Resting Voltage",
+                                    "4 No balancing mode active, qualifier invalid"};
+static const char* hvilText[] = {"Error (Loop Open)", "OK (Loop Closed)"};
+static const char* pyroText[] = {"0 Value Invalid", "1 Successfully Blown", "2 Disconnected",
+                                 "3 Not Activated - Pyro Intact", "4 Unknown"};
+
+static const BATTERY_FIELD_TYPE bmwix_fields[] = {
+    FIELD_RAW("Battery Voltage after Contactor", datalayer_extended.bmwix.battery_voltage_after_contactor, "dV"),
+    FIELD_RAW("Max Design Voltage", datalayer.battery.info.max_design_voltage_dV, "dV"),
+    FIELD_RAW("Min Design Voltage", datalayer.battery.info.min_design_voltage_dV, "dV"),
+    FIELD_RAW("Max Cell Design Voltage", datalayer.battery.info.max_cell_voltage_mV, "mV"),
+    FIELD_RAW("Min Cell Design Voltage", datalayer.battery.info.min_cell_voltage_mV, "mV"),
+    FIELD_RAW("Min Cell Voltage Data Age", datalayer_extended.bmwix.min_cell_voltage_data_age, "ms"),
+    FIELD_RAW("Max Cell Voltage Data Age", datalayer_extended.bmwix.max_cell_voltage_data_age, "ms"),
+    FIELD_RAW("Allowed Discharge Power", datalayer.battery.status.max_discharge_power_W, "W"),
+    FIELD_RAW("Allowed Charge Power", datalayer.battery.status.max_charge_power_W, "W"),
+    FIELD_RAW("T30 Terminal Voltage", datalayer_extended.bmwix.T30_Voltage, "mV"),
+    FIELD_RAW("Detected Cell Count", datalayer.battery.info.number_of_cells, ""),
+    FIELD_STATE("Balancing", datalayer_extended.bmwix.balancing_status, balanceText),
+    FIELD_STATE("HVIL Status", datalayer_extended.bmwix.hvil_status, hvilText),
+    FIELD_RAW("BMS Uptime", datalayer_extended.bmwix.bms_uptime, "seconds"),
+    FIELD_RAW("BMS Allowed Charge Amps", datalayer_extended.bmwix.allowable_charge_amps, "A"),
+    FIELD_RAW("BMS Allowed Disharge Amps", datalayer_extended.bmwix.allowable_discharge_amps, "A"),
+};
+
+static const BATTERY_FIELD_TYPE bmwix_isolation_fields[] = {
+    FIELD_RAW("Isolation Positive", datalayer_extended.bmwix.iso_safety_positive, "kOhm"),
+    FIELD_RAW("Isolation Negative", datalayer_extended.bmwix.iso_safety_negative, "kOhm"),
+    FIELD_RAW("Isolation Parallel", datalayer_extended.bmwix.iso_safety_parallel, "kOhm"),
+    FIELD_STATE("Pyro Status PSS1", datalayer_extended.bmwix.pyro_status_pss1, pyroText),
+    FIELD_STATE("Pyro Status PSS4", datalayer_extended.bmwix.pyro_status_pss4, pyroText),
+    FIELD_STATE("Pyro Status PSS6", datalayer_extended.bmwix.pyro_status_pss6, pyroText),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", bmwix_fields, FIELD_ARRAY_SIZE(bmwix_fields), nullptr},
+    {"HV Isolation (2147483647kOhm = maximum/invalid)", bmwix_isolation_fields,
+     FIELD_ARRAY_SIZE(bmwix_isolation_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //BMW_IX_BATTERY
+
+#if defined(BMW_PHEV_BATTERY) || defined(BMW_I3_BATTERY)
+// Status signals shared by the BMW i3 and PHEV packs, unlisted values are shown as numbers
+static const char* statusText[] = {"Not evaluated", "OK", "Error!", "Invalid signal"};
+static const char* prechargeText[] = {"Not evaluated", "Not active, closing not blocked", "Error precharge blocked",
+                                      "Invalid signal"};  //Still unclear of enum
+static const char* DCSWText[] = {"Contactors open", "Precharge ongoing", "Contactors engaged", "Invalid signal"};
+static const char* contText[] = {"Contactors OK", "One contactor welded!", "Two contactors welded!", "Invalid signal"};
+static const char* valveText[] = {"OK",
+                                  "Short circuit to GND",
+                                  "Short circuit to 12V",
+                                  "Line break",
+                                  "",
+                                  "",
+                                  "Driver error",
+                                  "",
+                                  "",
+                                  "",
+                                  "",
+                                  "",
+                                  "Stuck",
+                                  "Stuck",
+                                  "",
+                                  "Invalid Signal"};
+#endif  // BMW_PHEV_BATTERY || BMW_I3_BATTERY
+
+#ifdef BMW_PHEV_BATTERY
+static const char* balanceText[] = {"0 Balancing Inactive - Balancing not needed", "1 Balancing Active",
+                                    "2 Balancing Inactive - Cells not in rest break wait 10mins",
+                                    "3 Balancing Inactive", "4 Unknown"};
+
+static const BATTERY_FIELD_TYPE bmwphev_fields[] = {
+    FIELD_RAW("Battery Voltage after Contactor", datalayer_extended.bmwphev.battery_voltage_after_contactor, "dV"),
+    FIELD_RAW("Allowed Discharge Power", datalayer.battery.status.max_discharge_power_W, "W"),
+    FIELD_RAW("Allowed Charge Power", datalayer.battery.status.max_charge_power_W, "W"),
+    FIELD_STATE("Balancing", datalayer_extended.bmwphev.balancing_status, balanceText),
+    FIELD_STATE("Interlock", datalayer_extended.bmwphev.ST_interlock, statusText),
+    FIELD_STATE("Isolation external", datalayer_extended.bmwphev.ST_iso_ext, statusText),
+    FIELD_STATE("Isolation internal", datalayer_extended.bmwphev.ST_iso_int, statusText),
+    FIELD_STATE("Isolation", datalayer_extended.bmwphev.ST_isolation, statusText),
+    FIELD_STATE("Cooling valve", datalayer_extended.bmwphev.ST_valve_cooling, statusText),
+    FIELD_STATE("Emergency", datalayer_extended.bmwphev.ST_EMG, statusText),
+    FIELD_STATE("Precharge", datalayer_extended.bmwphev.ST_precharge, prechargeText),
+    FIELD_STATE("Contactor status", datalayer_extended.bmwphev.ST_DCSW, DCSWText),
+    FIELD_STATE("Contactor weld", datalayer_extended.bmwphev.ST_WELD, contText),
+    FIELD_STATE("Cold shutoff valve", datalayer_extended.bmwphev.ST_cold_shutoff_valve, valveText),
+    FIELD_RAW("Min Cell Voltage Data Age", datalayer_extended.bmwphev.min_cell_voltage_data_age, "ms"),
+    FIELD_RAW("Max Cell Voltage Data Age", datalayer_extended.bmwphev.max_cell_voltage_data_age, "ms"),
+    FIELD_RAW("Max Design Voltage", datalayer.battery.info.max_design_voltage_dV, "dV"),
+    FIELD_RAW("Min Design Voltage", datalayer.battery.info.min_design_voltage_dV, "dV"),
+    FIELD_RAW("BMS Allowed Charge Amps", datalayer_extended.bmwphev.allowable_charge_amps, "A"),
+    FIELD_RAW("BMS Allowed Disharge Amps", datalayer_extended.bmwphev.allowable_discharge_amps, "A"),
+    FIELD_RAW("Detected Cell Count", datalayer.battery.info.number_of_cells, ""),
+};
+
+static const BATTERY_FIELD_TYPE bmwphev_isolation_fields[] = {
+    FIELD_RAW("iso_safety_int_kohm", datalayer_extended.bmwphev.iso_safety_int_kohm, ""),
+    FIELD_RAW("iso_safety_ext_kohm", datalayer_extended.bmwphev.iso_safety_ext_kohm, ""),
+    FIELD_RAW("iso_safety_trg_kohm", datalayer_extended.bmwphev.iso_safety_trg_kohm, ""),
+    FIELD_RAW("iso_safety_ext_plausible", datalayer_extended.bmwphev.iso_safety_ext_plausible, ""),
+    FIELD_RAW("iso_safety_int_plausible", datalayer_extended.bmwphev.iso_safety_int_plausible, ""),
+    FIELD_RAW("iso_safety_trg_plausible", datalayer_extended.bmwphev.iso_safety_trg_plausible, ""),
+    FIELD_RAW("iso_safety_kohm", datalayer_extended.bmwphev.iso_safety_kohm, ""),
+    FIELD_RAW("iso_safety_kohm_quality", datalayer_extended.bmwphev.iso_safety_kohm_quality, ""),
+};
+
+static const BATTERY_FIELD_TYPE bmwphev_todo_fields[] = {
+    FIELD_RAW("Max Cell Design Voltage", datalayer.battery.info.max_cell_voltage_mV, "mV"),
+    FIELD_RAW("Min Cell Design Voltage", datalayer.battery.info.min_cell_voltage_mV, "mV"),
+    FIELD_RAW("T30 Terminal Voltage", datalayer_extended.bmwphev.T30_Voltage, "mV"),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", bmwphev_fields, FIELD_ARRAY_SIZE(bmwphev_fields), nullptr},
+    {"Isolation", bmwphev_isolation_fields, FIELD_ARRAY_SIZE(bmwphev_isolation_fields), nullptr},
+    {"Todo", bmwphev_todo_fields, FIELD_ARRAY_SIZE(bmwphev_todo_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //BMW_PHEV_BATTERY
+
+#ifdef BMW_I3_BATTERY
+static const BATTERY_FIELD_TYPE bmwi3_fields[] = {
+    FIELD_RAW("SOC raw", datalayer_extended.bmwi3.SOC_raw, ""),
+    FIELD_RAW("SOC dash", datalayer_extended.bmwi3.SOC_dash, ""),
+    FIELD_RAW("SOC OBD2", datalayer_extended.bmwi3.SOC_OBD2, ""),
+    FIELD_STATE("Interlock", datalayer_extended.bmwi3.ST_interlock, statusText),
+    FIELD_STATE("Isolation external", datalayer_extended.bmwi3.ST_iso_ext, statusText),
+    FIELD_STATE("Isolation internal", datalayer_extended.bmwi3.ST_iso_int, statusText),
+    FIELD_STATE("Isolation", datalayer_extended.bmwi3.ST_isolation, statusText),
+    FIELD_STATE("Cooling valve", datalayer_extended.bmwi3.ST_valve_cooling, statusText),
+    FIELD_STATE("Emergency", datalayer_extended.bmwi3.ST_EMG, statusText),
+    FIELD_STATE("Precharge", datalayer_extended.bmwi3.ST_precharge, prechargeText),
+    FIELD_STATE("Contactor status", datalayer_extended.bmwi3.ST_DCSW, DCSWText),
+    FIELD_STATE("Contactor weld", datalayer_extended.bmwi3.ST_WELD, contText),
+    FIELD_STATE("Cold shutoff valve", datalayer_extended.bmwi3.ST_cold_shutoff_valve, valveText),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", bmwi3_fields, FIELD_ARRAY_SIZE(bmwi3_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //BMW_I3_BATTERY
+
+#ifdef CELLPOWER_BMS
+static const char* falseTrue[] = {"False", "True"};
+
+static const BATTERY_FIELD_TYPE cellpower_state_fields[] = {
+    FIELD_STATE("Discharge", datalayer_extended.cellpower.system_state_discharge, falseTrue),
+    FIELD_STATE("Charge", datalayer_extended.cellpower.system_state_charge, falseTrue),
+    FIELD_STATE("Cellbalancing", datalayer_extended.cellpower.system_state_cellbalancing, falseTrue),
+    FIELD_STATE("Tricklecharging", datalayer_extended.cellpower.system_state_tricklecharge, falseTrue),
+    FIELD_STATE("Idle", datalayer_extended.cellpower.system_state_idle, falseTrue),
+    FIELD_STATE("Charge completed", datalayer_extended.cellpower.system_state_chargecompleted, falseTrue),
+    FIELD_STATE("Maintenance charge", datalayer_extended.cellpower.system_state_maintenancecharge, falseTrue),
+};
+
+static const BATTERY_FIELD_TYPE cellpower_io_fields[] = {
+    FIELD_STATE("Main positive relay", datalayer_extended.cellpower.IO_state_main_positive_relay, falseTrue),
+    FIELD_STATE("Main negative relay", datalayer_extended.cellpower.IO_state_main_negative_relay, falseTrue),
+    FIELD_STATE("Charge enabled", datalayer_extended.cellpower.IO_state_charge_enable, falseTrue),
+    FIELD_STATE("Precharge relay", datalayer_extended.cellpower.IO_state_precharge_relay, falseTrue),
+    FIELD_STATE("Discharge enable", datalayer_extended.cellpower.IO_state_discharge_enable, falseTrue),
+    FIELD_STATE("IO 6", datalayer_extended.cellpower.IO_state_IO_6, falseTrue),
+    FIELD_STATE("IO 7", datalayer_extended.cellpower.IO_state_IO_7, falseTrue),
+    FIELD_STATE("IO 8", datalayer_extended.cellpower.IO_state_IO_8, falseTrue),
+};
+
+static const BATTERY_FIELD_TYPE cellpower_error_fields[] = {
+    FIELD_STATE("Cell overvoltage", datalayer_extended.cellpower.error_Cell_overvoltage, falseTrue),
+    FIELD_STATE("Cell undervoltage", datalayer_extended.cellpower.error_Cell_undervoltage, falseTrue),
+    FIELD_STATE("Cell end of life voltage", datalayer_extended.cellpower.error_Cell_end_of_life_voltage, falseTrue),
+    FIELD_STATE("Cell voltage misread", datalayer_extended.cellpower.error_Cell_voltage_misread, falseTrue),
+    FIELD_STATE("Cell over temperature", datalayer_extended.cellpower.error_Cell_over_temperature, falseTrue),
+    FIELD_STATE("Cell under temperature", datalayer_extended.cellpower.error_Cell_under_temperature, falseTrue),
+    FIELD_STATE("Cell unmanaged", datalayer_extended.cellpower.error_Cell_unmanaged, falseTrue),
+    FIELD_STATE("LMU over temperature", datalayer_extended.cellpower.error_LMU_over_temperature, falseTrue),
+    FIELD_STATE("LMU under temperature", datalayer_extended.cellpower.error_LMU_under_temperature, falseTrue),
+    FIELD_STATE("Temp sensor open circuit", datalayer_extended.cellpower.error_Temp_sensor_open_circuit, falseTrue),
+    FIELD_STATE("Temp sensor short circuit", datalayer_extended.cellpower.error_Temp_sensor_short_circuit, falseTrue),
+    FIELD_STATE("SUB comm", datalayer_extended.cellpower.error_SUB_communication, falseTrue),
+    FIELD_STATE("LMU comm", datalayer_extended.cellpower.error_LMU_communication, falseTrue),
+    FIELD_STATE("Over current In", datalayer_extended.cellpower.error_Over_current_IN, falseTrue),
+    FIELD_STATE("Over current Out", datalayer_extended.cellpower.error_Over_current_OUT, falseTrue),
+    FIELD_STATE("Short circuit", datalayer_extended.cellpower.error_Short_circuit, falseTrue),
+    FIELD_STATE("Leak detected", datalayer_extended.cellpower.error_Leak_detected, falseTrue),
+    FIELD_STATE("Leak detection failed", datalayer_extended.cellpower.error_Leak_detection_failed, falseTrue),
+    FIELD_STATE("Voltage diff", datalayer_extended.cellpower.error_Voltage_difference, falseTrue),
+    FIELD_STATE("BMCU supply overvoltage", datalayer_extended.cellpower.error_BMCU_supply_over_voltage, falseTrue),
+    FIELD_STATE("BMCU supply undervoltage", datalayer_extended.cellpower.error_BMCU_supply_under_voltage, falseTrue),
+    FIELD_STATE("Main positive contactor", datalayer_extended.cellpower.error_Main_positive_contactor, falseTrue),
+    FIELD_STATE("Main negative contactor", datalayer_extended.cellpower.error_Main_negative_contactor, falseTrue),
+    FIELD_STATE("Precharge contactor", datalayer_extended.cellpower.error_Precharge_contactor, falseTrue),
+    FIELD_STATE("Midpack contactor", datalayer_extended.cellpower.error_Midpack_contactor, falseTrue),
+    FIELD_STATE("Precharge timeout", datalayer_extended.cellpower.error_Precharge_timeout, falseTrue),
+    FIELD_STATE("EMG connector override", datalayer_extended.cellpower.error_Emergency_connector_override, falseTrue),
+};
+
+static const BATTERY_FIELD_TYPE cellpower_warning_fields[] = {
+    FIELD_STATE("High cell voltage", datalayer_extended.cellpower.warning_High_cell_voltage, falseTrue),
+    FIELD_STATE("Low cell voltage", datalayer_extended.cellpower.warning_Low_cell_voltage, falseTrue),
+    FIELD_STATE("High cell temperature", datalayer_extended.cellpower.warning_High_cell_temperature, falseTrue),
+    FIELD_STATE("Low cell temperature", datalayer_extended.cellpower.warning_Low_cell_temperature, falseTrue),
+    FIELD_STATE("High LMU temperature", datalayer_extended.cellpower.warning_High_LMU_temperature, falseTrue),
+    FIELD_STATE("Low LMU temperature", datalayer_extended.cellpower.warning_Low_LMU_temperature, falseTrue),
+    FIELD_STATE("SUB comm interf", datalayer_extended.cellpower.warning_SUB_communication_interfered, falseTrue),
+    FIELD_STATE("LMU comm interf", datalayer_extended.cellpower.warning_LMU_communication_interfered, falseTrue),
+    FIELD_STATE("High current In", datalayer_extended.cellpower.warning_High_current_IN, falseTrue),
+    FIELD_STATE("High current Out", datalayer_extended.cellpower.warning_High_current_OUT, falseTrue),
+    FIELD_STATE("Pack resistance diff", datalayer_extended.cellpower.warning_Pack_resistance_difference, falseTrue),
+    FIELD_STATE("High pack resistance", datalayer_extended.cellpower.warning_High_pack_resistance, falseTrue),
+    FIELD_STATE("Cell resistance diff", datalayer_extended.cellpower.warning_Cell_resistance_difference, falseTrue),
+    FIELD_STATE("High cell resistance", datalayer_extended.cellpower.warning_High_cell_resistance, falseTrue),
+    FIELD_STATE("High BMCU supply voltage", datalayer_extended.cellpower.warning_High_BMCU_supply_voltage, falseTrue),
+    FIELD_STATE("Low BMCU supply voltage", datalayer_extended.cellpower.warning_Low_BMCU_supply_voltage, falseTrue),
+    FIELD_STATE("Low SOC", datalayer_extended.cellpower.warning_Low_SOC, falseTrue),
+    FIELD_STATE("Balancing required", datalayer_extended.cellpower.warning_Balancing_required_OCV_model, falseTrue),
+    FIELD_STATE("Charger not responding", datalayer_extended.cellpower.warning_Charger_not_responding, falseTrue),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"States", cellpower_state_fields, FIELD_ARRAY_SIZE(cellpower_state_fields), nullptr},
+    {"IO", cellpower_io_fields, FIELD_ARRAY_SIZE(cellpower_io_fields), nullptr},
+    {"Errors", cellpower_error_fields, FIELD_ARRAY_SIZE(cellpower_error_fields), nullptr},
+    {"Warnings", cellpower_warning_fields, FIELD_ARRAY_SIZE(cellpower_warning_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //CELLPOWER_BMS
+
+#ifdef CMFA_EV_BATTERY
+static const BATTERY_FIELD_TYPE cmfaev_fields[] = {
+    FIELD_RAW("SOC U", datalayer_extended.CMFAEV.soc_u, "percent"),
+    FIELD_RAW("SOC Z", datalayer_extended.CMFAEV.soc_z, "percent"),
+    FIELD_RAW("SOH Average", datalayer_extended.CMFAEV.soh_average, "pptt"),
+    FIELD_RAW("12V voltage", datalayer_extended.CMFAEV.lead_acid_voltage, "mV"),
+    FIELD_RAW("Highest cell number", datalayer_extended.CMFAEV.highest_cell_voltage_number, ""),
+    FIELD_RAW("Lowest cell number", datalayer_extended.CMFAEV.lowest_cell_voltage_number, ""),
+    FIELD_RAW("Max regen power", datalayer_extended.CMFAEV.max_regen_power, ""),
+    FIELD_RAW("Max discharge power", datalayer_extended.CMFAEV.max_discharge_power, ""),
+    FIELD_RAW("Max charge power", datalayer_extended.CMFAEV.maximum_charge_power, ""),
+    FIELD_RAW("SOH available power", datalayer_extended.CMFAEV.SOH_available_power, ""),
+    FIELD_RAW("SOH generated power", datalayer_extended.CMFAEV.SOH_generated_power, ""),
+    FIELD_RAW("Average temperature", datalayer_extended.CMFAEV.average_temperature, "dC"),
+    FIELD_RAW("Maximum temperature", datalayer_extended.CMFAEV.maximum_temperature, "dC"),
+    FIELD_RAW("Minimum temperature", datalayer_extended.CMFAEV.minimum_temperature, "dC"),
+};
+
+static const BATTERY_FIELD_TYPE cmfaev_energy_fields[] = {
+    FIELD_RAW("Cumulative energy discharged", datalayer_extended.CMFAEV.cumulative_energy_when_discharging, "Wh"),
+    FIELD_RAW("Cumulative energy charged", datalayer_extended.CMFAEV.cumulative_energy_when_charging, "Wh"),
+    FIELD_RAW("Cumulative energy regen", datalayer_extended.CMFAEV.cumulative_energy_in_regen, "Wh"),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", cmfaev_fields, FIELD_ARRAY_SIZE(cmfaev_fields), nullptr},
+    {"Energy counters", cmfaev_energy_fields, FIELD_ARRAY_SIZE(cmfaev_energy_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //CMFA_EV_BATTERY
+
+#ifdef KIA_HYUNDAI_64_BATTERY
+static const BATTERY_FIELD_TYPE kiahyundai64_fields[] = {
+    FIELD_RAW("Cells", datalayer_extended.KiaHyundai64.total_cell_count, "S"),
+    FIELD_SCALED("12V voltage", datalayer_extended.KiaHyundai64.battery_12V, 0.1, 0, "V"),
+    FIELD_RAW("Waterleakage", datalayer_extended.KiaHyundai64.waterleakageSensor, ""),
+    FIELD_RAW("Temperature, water inlet", datalayer_extended.KiaHyundai64.temperature_water_inlet, ""),
+    FIELD_RAW("Temperature, power relay", datalayer_extended.KiaHyundai64.powerRelayTemperature, ""),
+    FIELD_RAW("Batterymanagement mode", datalayer_extended.KiaHyundai64.batteryManagementMode, ""),
+    FIELD_RAW("BMS ignition", datalayer_extended.KiaHyundai64.BMS_ign, ""),
+    FIELD_RAW("Battery relay", datalayer_extended.KiaHyundai64.batteryRelay, ""),
+};
+
+#ifdef DOUBLE_BATTERY
+static const BATTERY_FIELD_TYPE kiahyundai64_battery2_fields[] = {
+    FIELD_RAW("Cells", datalayer_extended.KiaHyundai64.battery2_total_cell_count, "S"),
+    FIELD_SCALED("12V voltage", datalayer_extended.KiaHyundai64.battery2_battery_12V, 0.1, 0, "V"),
+    FIELD_RAW("Waterleakage", datalayer_extended.KiaHyundai64.battery2_waterleakageSensor, ""),
+    FIELD_RAW("Temperature, water inlet", datalayer_extended.KiaHyundai64.battery2_temperature_water_inlet, ""),
+    FIELD_RAW("Temperature, power relay", datalayer_extended.KiaHyundai64.battery2_powerRelayTemperature, ""),
+    FIELD_RAW("Batterymanagement mode", datalayer_extended.KiaHyundai64.battery2_batteryManagementMode, ""),
+    FIELD_RAW("BMS ignition", datalayer_extended.KiaHyundai64.battery2_BMS_ign, ""),
+    FIELD_RAW("Battery relay", datalayer_extended.KiaHyundai64.battery2_batteryRelay, ""),
+};
+#endif  //DOUBLE_BATTERY
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", kiahyundai64_fields, FIELD_ARRAY_SIZE(kiahyundai64_fields), nullptr},
+#ifdef DOUBLE_BATTERY
+    {"Values from battery 2", kiahyundai64_battery2_fields, FIELD_ARRAY_SIZE(kiahyundai64_battery2_fields), nullptr},
+#endif  //DOUBLE_BATTERY
+};
+const char* battery_section_actions = "";
+#endif  //KIA_HYUNDAI_64_BATTERY
+
+#ifdef BYD_ATTO_3_BATTERY
+static const char* SOCmethod[] = {"Estimated from voltage", "Measured by BMS"};
+
+static const BATTERY_FIELD_TYPE bydatto3_fields[] = {
+    FIELD_STATE("SOC method used", datalayer_extended.bydAtto3.SOC_method, SOCmethod),
+    FIELD_RAW("SOC estimated", datalayer_extended.bydAtto3.SOC_estimated, ""),
+    FIELD_RAW("SOC highprec", datalayer_extended.bydAtto3.SOC_highprec, ""),
+    FIELD_RAW("SOC OBD2", datalayer_extended.bydAtto3.SOC_polled, ""),
+    FIELD_RAW("Voltage periodic", datalayer_extended.bydAtto3.voltage_periodic, ""),
+    FIELD_RAW("Voltage OBD2", datalayer_extended.bydAtto3.voltage_polled, ""),
+};
+
+static const BATTERY_FIELD_TYPE bydatto3_temperature_fields[] = {
+    FIELD_RAW("Temperature sensor 1", datalayer_extended.bydAtto3.battery_temperatures[0], ""),
+    FIELD_RAW("Temperature sensor 2", datalayer_extended.bydAtto3.battery_temperatures[1], ""),
+    FIELD_RAW("Temperature sensor 3", datalayer_extended.bydAtto3.battery_temperatures[2], ""),
+    FIELD_RAW("Temperature sensor 4", datalayer_extended.bydAtto3.battery_temperatures[3], ""),
+    FIELD_RAW("Temperature sensor 5", datalayer_extended.bydAtto3.battery_temperatures[4], ""),
+    FIELD_RAW("Temperature sensor 6", datalayer_extended.bydAtto3.battery_temperatures[5], ""),
+    FIELD_RAW("Temperature sensor 7", datalayer_extended.bydAtto3.battery_temperatures[6], ""),
+    FIELD_RAW("Temperature sensor 8", datalayer_extended.bydAtto3.battery_temperatures[7], ""),
+    FIELD_RAW("Temperature sensor 9", datalayer_extended.bydAtto3.battery_temperatures[8], ""),
+    FIELD_RAW("Temperature sensor 10", datalayer_extended.bydAtto3.battery_temperatures[9], ""),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"SOC and voltage", bydatto3_fields, FIELD_ARRAY_SIZE(bydatto3_fields), nullptr},
+    {"Temperatures", bydatto3_temperature_fields, FIELD_ARRAY_SIZE(bydatto3_temperature_fields), nullptr},
+};
+const char* battery_section_actions = "";
+#endif  //BYD_ATTO_3_BATTERY
+
+#ifdef RENAULT_ZOE_GEN2_BATTERY
+static const BATTERY_FIELD_TYPE zoeph2_fields[] = {
+    FIELD_RAW("soc", datalayer_extended.zoePH2.battery_soc, ""),
+    FIELD_RAW("usable soc", datalayer_extended.zoePH2.battery_usable_soc, ""),
+    FIELD_RAW("soh", datalayer_extended.zoePH2.battery_soh, ""),
+    FIELD_RAW("pack voltage", datalayer_extended.zoePH2.battery_pack_voltage, ""),
+    FIELD_RAW("max cell voltage", datalayer_extended.zoePH2.battery_max_cell_voltage, ""),
+    FIELD_RAW("min cell voltage", datalayer_extended.zoePH2.battery_min_cell_voltage, ""),
+    FIELD_RAW("12v", datalayer_extended.zoePH2.battery_12v, ""),
+    FIELD_RAW("avg temp", datalayer_extended.zoePH2.battery_avg_temp, ""),
+    FIELD_RAW("min temp", datalayer_extended.zoePH2.battery_min_temp, ""),
+    FIELD_RAW("max temp", datalayer_extended.zoePH2.battery_max_temp, ""),
+    FIELD_RAW("max power", datalayer_extended.zoePH2.battery_max_power, ""),
+    FIELD_RAW("interlock", datalayer_extended.zoePH2.battery_interlock, ""),
+    FIELD_RAW("kwh", datalayer_extended.zoePH2.battery_kwh, ""),
+    FIELD_RAW("current", datalayer_extended.zoePH2.battery_current, ""),
+    FIELD_RAW("current offset", datalayer_extended.zoePH2.battery_current_offset, ""),
+    FIELD_RAW("max generated", datalayer_extended.zoePH2.battery_max_generated, ""),
+    FIELD_RAW("max available", datalayer_extended.zoePH2.battery_max_available, ""),
+    FIELD_RAW("current voltage", datalayer_extended.zoePH2.battery_current_voltage, ""),
+    FIELD_RAW("charging status", datalayer_extended.zoePH2.battery_charging_status, ""),
+    FIELD_RAW("remaining charge", datalayer_extended.zoePH2.battery_remaining_charge, ""),
+    FIELD_RAW("soc min", datalayer_extended.zoePH2.battery_soc_min, ""),
+    FIELD_RAW("soc max", datalayer_extended.zoePH2.battery_soc_max, ""),
+};
+
+static const BATTERY_FIELD_TYPE zoeph2_balancing_fields[] = {
+    FIELD_RAW("balance capacity total", datalayer_extended.zoePH2.battery_balance_capacity_total, ""),
+    FIELD_RAW("balance time total", datalayer_extended.zoePH2.battery_balance_time_total, ""),
+    FIELD_RAW("balance capacity sleep", datalayer_extended.zoePH2.battery_balance_capacity_sleep, ""),
+    FIELD_RAW("balance time sleep", datalayer_extended.zoePH2.battery_balance_time_sleep, ""),
+    FIELD_RAW("balance capacity wake", datalayer_extended.zoePH2.battery_balance_capacity_wake, ""),
+    FIELD_RAW("balance time wake", datalayer_extended.zoePH2.battery_balance_time_wake, ""),
+    FIELD_RAW("bms state", datalayer_extended.zoePH2.battery_bms_state, ""),
+    FIELD_RAW("balance switches", datalayer_extended.zoePH2.battery_balance_switches, ""),
+    FIELD_RAW("energy complete", datalayer_extended.zoePH2.battery_energy_complete, ""),
+    FIELD_RAW("energy partial", datalayer_extended.zoePH2.battery_energy_partial, ""),
+    FIELD_RAW("slave failures", datalayer_extended.zoePH2.battery_slave_failures, ""),
+    FIELD_RAW("mileage", datalayer_extended.zoePH2.battery_mileage, ""),
+};
+
+static const BATTERY_FIELD_TYPE zoeph2_fan_fields[] = {
+    FIELD_RAW("fan speed", datalayer_extended.zoePH2.battery_fan_speed, ""),
+    FIELD_RAW("fan period", datalayer_extended.zoePH2.battery_fan_period, ""),
+    FIELD_RAW("fan control", datalayer_extended.zoePH2.battery_fan_control, ""),
+    FIELD_RAW("fan duty", datalayer_extended.zoePH2.battery_fan_duty, ""),
+    FIELD_RAW("temporisation", datalayer_extended.zoePH2.battery_temporisation, ""),
+    FIELD_RAW("time", datalayer_extended.zoePH2.battery_time, ""),
+    FIELD_RAW("pack time", datalayer_extended.zoePH2.battery_pack_time, ""),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"Battery", zoeph2_fields, FIELD_ARRAY_SIZE(zoeph2_fields), nullptr},
+    {"Balancing and BMS", zoeph2_balancing_fields, FIELD_ARRAY_SIZE(zoeph2_balancing_fields), nullptr},
+    {"Fan and timers", zoeph2_fan_fields, FIELD_ARRAY_SIZE(zoeph2_fan_fields), nullptr},
+};
+const char* battery_section_actions = "<button onclick='askTriggerNVROL()'>Perform NVROL reset</button>";
+#endif  //RENAULT_ZOE_GEN2_BATTERY
+
+#ifdef VOLVO_SPA_BATTERY
+static const char* HVSysRlySts[] = {"Open", "Closed", "KeepStatus", "OpenAndRequestActiveDischarge"};
+static const char* HVSysDCRlySts[] = {"Open", "Closed", "KeepStatus", "Fault"};
+static const char* HVSysIsoRMonrSts[] = {"Not valid 1", "False", "True", "Not valid 2"};
+
+static const BATTERY_FIELD_TYPE volvo_spa_fields[] = {
+    FIELD_RAW("BECM reported SOC", datalayer_extended.VolvoPolestar.soc_bms, ""),
+    FIELD_RAW("Calculated SOC", datalayer_extended.VolvoPolestar.soc_calc, ""),
+    FIELD_SCALED("Rescaled SOC", datalayer_extended.VolvoPolestar.soc_rescaled, 0.1, 0, ""),
+    FIELD_RAW("BECM reported SOH", datalayer_extended.VolvoPolestar.soh_bms, ""),
+    FIELD_RAW("BECM supply voltage", datalayer_extended.VolvoPolestar.BECMsupplyVoltage, "mV"),
+    FIELD_RAW("HV voltage", datalayer_extended.VolvoPolestar.BECMBatteryVoltage, "V"),
+    FIELD_RAW("HV current", datalayer_extended.VolvoPolestar.BECMBatteryCurrent, "A"),
+    FIELD_RAW("Dynamic max voltage", datalayer_extended.VolvoPolestar.BECMUDynMaxLim, "V"),
+    FIELD_RAW("Dynamic min voltage", datalayer_extended.VolvoPolestar.BECMUDynMinLim, "V"),
+};
+
+static const BATTERY_FIELD_TYPE volvo_spa_limit_fields[] = {
+    FIELD_RAW("Discharge power limit 1", datalayer_extended.VolvoPolestar.HvBattPwrLimDcha1, "kW"),
+    FIELD_RAW("Discharge soft power limit", datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSoft, "kW"),
+    FIELD_RAW("Discharge power limit slow aging", datalayer_extended.VolvoPolestar.HvBattPwrLimDchaSlowAgi, "kW"),
+    FIELD_RAW("Charge power limit slow aging", datalayer_extended.VolvoPolestar.HvBattPwrLimChrgSlowAgi, "kW"),
+};
+
+// Values outside the lists are shown as numbers
+static const BATTERY_FIELD_TYPE volvo_spa_relay_fields[] = {
+    FIELD_STATE("HV system relay status", datalayer_extended.VolvoPolestar.HVSysRlySts, HVSysRlySts),
+    FIELD_STATE("HV system relay status 1", datalayer_extended.VolvoPolestar.HVSysDCRlySts1, HVSysDCRlySts),
+    FIELD_STATE("HV system relay status 2", datalayer_extended.VolvoPolestar.HVSysDCRlySts2, HVSysDCRlySts),
+    FIELD_STATE("HV system isolation resistance monitoring status", datalayer_extended.VolvoPolestar.HVSysIsoRMonrSts,
+                HVSysIsoRMonrSts),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"BECM", volvo_spa_fields, FIELD_ARRAY_SIZE(volvo_spa_fields), nullptr},
+    {"Power limits", volvo_spa_limit_fields, FIELD_ARRAY_SIZE(volvo_spa_limit_fields), nullptr},
+    {"Relays and isolation", volvo_spa_relay_fields, FIELD_ARRAY_SIZE(volvo_spa_relay_fields), nullptr},
+};
+const char* battery_section_actions =
+    "<button onclick='Volvo_askEraseDTC()'>Erase DTC</button>"
+    "<button onclick='Volvo_askReadDTC()'>Read DTC (result must be checked in CANlog)</button>"
+    "<button onclick='Volvo_BECMecuReset()'>Restart BECM module</button>";
+#endif  // VOLVO_SPA_BATTERY
+
+#ifdef VOLVO_SPA_HYBRID_BATTERY
+static const char* HVSysRlySts[] = {"Open", "Closed", "KeepStatus", "OpenAndRequestActiveDischarge"};
+static const char* HVSysDCRlySts[] = {"Open", "Closed", "KeepStatus", "Fault"};
+static const char* HVSysIsoRMonrSts[] = {"Not valid 1", "False", "True", "Not valid 2"};
+
+static const BATTERY_FIELD_TYPE volvo_hybrid_fields[] = {
+    FIELD_RAW("BECM reported SOC", datalayer_extended.VolvoHybrid.soc_bms, ""),
+    FIELD_RAW("Calculated SOC", datalayer_extended.VolvoHybrid.soc_calc, ""),
+    FIELD_SCALED("Rescaled SOC", datalayer_extended.VolvoHybrid.soc_rescaled, 0.1, 0, ""),
+    FIELD_RAW("BECM reported SOH", datalayer_extended.VolvoHybrid.soh_bms, ""),
+    FIELD_RAW("BECM supply voltage", datalayer_extended.VolvoHybrid.BECMsupplyVoltage, "mV"),
+    FIELD_RAW("HV voltage", datalayer_extended.VolvoHybrid.BECMBatteryVoltage, "V"),
+    FIELD_RAW("HV current", datalayer_extended.VolvoHybrid.BECMBatteryCurrent, "A"),
+    FIELD_RAW("Dynamic max voltage", datalayer_extended.VolvoHybrid.BECMUDynMaxLim, "V"),
+    FIELD_RAW("Dynamic min voltage", datalayer_extended.VolvoHybrid.BECMUDynMinLim, "V"),
+};
+
+static const BATTERY_FIELD_TYPE volvo_hybrid_limit_fields[] = {
+    FIELD_RAW("Discharge power limit 1", datalayer_extended.VolvoHybrid.HvBattPwrLimDcha1, "kW"),
+    FIELD_RAW("Discharge soft power limit", datalayer_extended.VolvoHybrid.HvBattPwrLimDchaSoft, "kW"),
+};
+
+// Values outside the lists are shown as numbers
+static const BATTERY_FIELD_TYPE volvo_hybrid_relay_fields[] = {
+    FIELD_STATE("HV system relay status", datalayer_extended.VolvoHybrid.HVSysRlySts, HVSysRlySts),
+    FIELD_STATE("HV system relay status 1", datalayer_extended.VolvoHybrid.HVSysDCRlySts1, HVSysDCRlySts),
+    FIELD_STATE("HV system relay status 2", datalayer_extended.VolvoHybrid.HVSysDCRlySts2, HVSysDCRlySts),
+    FIELD_STATE("HV system isolation resistance monitoring status", datalayer_extended.VolvoHybrid.HVSysIsoRMonrSts,
+                HVSysIsoRMonrSts),
+};
+
+const BATTERY_SECTION_TYPE battery_sections[] = {
+    {"BECM", volvo_hybrid_fields, FIELD_ARRAY_SIZE(volvo_hybrid_fields), nullptr},
+    {"Power limits", volvo_hybrid_limit_fields, FIELD_ARRAY_SIZE(volvo_hybrid_limit_fields), nullptr},
+    {"Relays and isolation", volvo_hybrid_relay_fields, FIELD_ARRAY_SIZE(volvo_hybrid_relay_fields), nullptr},
+};
+const char* battery_section_actions =
+    "<button onclick='Volvo_askEraseDTC()'>Erase DTC</button>"
+    "<button onclick='Volvo_askReadDTC()'>Read DTC (result must be checked in CANlog)</button>"
+    "<button onclick='Volvo_BECMecuReset()'>Restart BECM module</button>";
+#endif  // VOLVO_SPA_HYBRID_BATTERY
+
+#ifdef BATTERY_HAS_FIELD_TABLE
+const uint8_t battery_section_count = FIELD_ARRAY_SIZE(battery_sections);
+#endif
+
+// Serial numbers are raw CAN bytes, so anything outside printable ASCII is dropped and markup characters escaped
+static void print_escaped(Print& out, const char* text, size_t length, bool json) {
+  for (size_t i = 0; i < length && text[i] != '\0'; i++) {
+    char c = text[i];
+    if (c < 0x20 || c > 0x7E) {
+      continue;
+    }
+    if (json && (c == '"' || c == '\\')) {
+      out.print('\\');
+    } else if (!json && c == '<') {
+      out.print("&lt;");
+      continue;
+    } else if (!json && c == '&') {
+      out.print("&amp;");
+      continue;
+    }
+    out.print(c);
+  }
+}
+
+static void print_string(Print& out, const char* text, size_t length, bool json) {
+  if (json) {
+    out.print('"');
+  }
+  print_escaped(out, text, length, json);
+  if (json) {
+    out.print('"');
+  }
+}
+
+static int64_t field_raw_value(const BATTERY_FIELD_TYPE& field) {
+  switch (field.kind) {
+    case FIELD_BOOL:
+      return *static_cast<const bool*>(field.value);
+    case FIELD_UINT8:
+      return *static_cast<const uint8_t*>(field.value);
+    case FIELD_INT8:
+      return *static_cast<const int8_t*>(field.value);
+    case FIELD_UINT16:
+      return *static_cast<const uint16_t*>(field.value);
+    case FIELD_INT16:
+      return *static_cast<const int16_t*>(field.value);
+    case FIELD_UINT32:
+      return *static_cast<const uint32_t*>(field.value);
+    case FIELD_INT32:
+      return *static_cast<const int32_t*>(field.value);
+    case FIELD_UINT64:
+      return (int64_t) * static_cast<const uint64_t*>(field.value);
+    default:
+      return 0;
+  }
+}
+
+static void print_field_value(Print& out, const BATTERY_FIELD_TYPE& field, bool json) {
+  if (field.kind == FIELD_CUSTOM) {
+    String text = field.text();
+    print_string(out, text.c_str(), text.length(), json);
+    return;
+  }
+  if (field.kind == FIELD_TEXT) {
+    print_string(out, static_cast<const char*>(field.value), field.length, json);
+    return;
+  }
+
+  int64_t raw = field_raw_value(field);
+  if (field.names != nullptr && raw >= 0 && raw < field.name_count) {
+    print_string(out, field.names[raw], strlen(field.names[raw]), json);
+  } else if (json && field.kind == FIELD_BOOL && field.names == nullptr) {
+    out.print(raw ? "true" : "false");
+  } else if (field.scale == 1 && field.offset == 0) {
+    out.print((long long)raw);
+  } else {
+    out.print(raw * field.scale + field.offset, 2);
+  }
+}
+
+bool battery_section_visible(const BATTERY_SECTION_TYPE& section) {
+  return section.visible == nullptr || section.visible();
+}
+
+void render_battery_section_html(Print& out, const BATTERY_SECTION_TYPE& section) {
+  for (uint8_t i = 0; i < section.field_count; i++) {
+    const BATTERY_FIELD_TYPE& field = section.fields[i];
+    out.print("<h4>");
+    out.print(field.label);
+    out.print(": ");
+    print_field_value(out, field, false);
+    if (field.unit[0] != '\0') {
+      out.print(' ');
+      out.print(field.unit);
+    }
+    out.print("</h4>");
+  }
+}
+
+void render_battery_section_json(Print& out, const BATTERY_SECTION_TYPE& section) {
+  out.print("{\"title\":\"");
+  out.print(section.title);
+  out.print("\",\"fields\":[");
+  for (uint8_t i = 0; i < section.field_count; i++) {
+    const BATTERY_FIELD_TYPE& field = section.fields[i];
+    if (i > 0) {
+      out.print(',');
+    }
+    out.print("{\"label\":\"");
+    out.print(field.label);
+    out.print("\",\"value\":");
+    print_field_value(out, field, true);
+    out.print(",\"unit\":\"");
+    out.print(field.unit);
+    out.print("\"}");
+  }
+  out.print("]}");
+}
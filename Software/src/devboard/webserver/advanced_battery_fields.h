@@ -0,0 +1,112 @@
+#ifndef ADVANCEDBATTERYFIELDS_H
+#define ADVANCEDBATTERYFIELDS_H
+
+#include <Arduino.h>
+#include <type_traits>
+#include "../../include.h"
+
+// Batteries with extra information on the advanced page, each described by a field table
+#if defined(BOLT_AMPERA_BATTERY) || defined(TESLA_BATTERY) || defined(NISSAN_LEAF_BATTERY) || defined(MEB_BATTERY) || \
+    defined(BMW_IX_BATTERY) || defined(BMW_PHEV_BATTERY) || defined(BMW_I3_BATTERY) || defined(CELLPOWER_BMS) ||      \
+    defined(CMFA_EV_BATTERY) || defined(KIA_HYUNDAI_64_BATTERY) || defined(BYD_ATTO_3_BATTERY) ||                     \
+    defined(RENAULT_ZOE_GEN2_BATTERY) || defined(VOLVO_SPA_BATTERY) || defined(VOLVO_SPA_HYBRID_BATTERY)
+#define BATTERY_HAS_FIELD_TABLE
+#endif
+
+enum BATTERY_FIELD_KIND : uint8_t {
+  FIELD_BOOL,
+  FIELD_UINT8,
+  FIELD_INT8,
+  FIELD_UINT16,
+  FIELD_INT16,
+  FIELD_UINT32,
+  FIELD_INT32,
+  FIELD_UINT64,
+  FIELD_TEXT,   // Fixed length array of ASCII bytes, not necessarily null terminated
+  FIELD_CUSTOM  // Value is produced by the text function
+};
+
+typedef struct {
+  const char* label;
+  BATTERY_FIELD_KIND kind;
+  const void* value;
+  /** Displayed value is raw * scale + offset. Integer kinds with scale 1 and offset 0 are shown without decimals */
+  float scale;
+  float offset;
+  const char* unit;
+  /** Optional lookup table turning an integer or bool value into a state name */
+  const char* const* names;
+  uint8_t name_count;
+  /** Array length for FIELD_TEXT */
+  uint8_t length;
+  String (*text)();
+} BATTERY_FIELD_TYPE;
+
+typedef struct {
+  const char* title;
+  const BATTERY_FIELD_TYPE* fields;
+  uint8_t field_count;
+  /** Optional, section is hidden while this returns false */
+  bool (*visible)();
+} BATTERY_SECTION_TYPE;
+
+// Integer members of the same width and signedness share a kind, unsigned long is as wide as uint32_t on the ESP32
+template <typename T>
+constexpr BATTERY_FIELD_KIND battery_field_kind(const T*) {
+  static_assert(std::is_integral<T>::value, "Battery fields are integers, use FIELD_FUNCTION for anything else");
+  return std::is_same<T, bool>::value ? FIELD_BOOL
+         : sizeof(T) == 1             ? (std::is_signed<T>::value ? FIELD_INT8 : FIELD_UINT8)
+         : sizeof(T) == 2             ? (std::is_signed<T>::value ? FIELD_INT16 : FIELD_UINT16)
+         : sizeof(T) == 4             ? (std::is_signed<T>::value ? FIELD_INT32 : FIELD_UINT32)
+                                      : FIELD_UINT64;
+}
+
+#define FIELD_ARRAY_SIZE(names) (sizeof(names) / sizeof(names[0]))
+
+// The kind is deduced from the member type, so the table cannot drift from datalayer_extended.h
+#define FIELD_RAW(label, member, unit) \
+  {label, battery_field_kind(&(member)), &(member), 1, 0, unit, nullptr, 0, 0, nullptr}
+#define FIELD_SCALED(label, member, scale, offset, unit) \
+  {label, battery_field_kind(&(member)), &(member), scale, offset, unit, nullptr, 0, 0, nullptr}
+#define FIELD_STATE(label, member, names) \
+  {label, battery_field_kind(&(member)), &(member), 1, 0, "", names, FIELD_ARRAY_SIZE(names), 0, nullptr}
+#define FIELD_ASCII(label, member) {label, FIELD_TEXT, (member), 1, 0, "", nullptr, 0, sizeof(member), nullptr}
+#define FIELD_FUNCTION(label, function, unit) {label, FIELD_CUSTOM, nullptr, 1, 0, unit, nullptr, 0, 0, function}
+
+#ifdef BATTERY_HAS_FIELD_TABLE
+extern const BATTERY_SECTION_TYPE battery_sections[];
+extern const uint8_t battery_section_count;
+/** Buttons shown above the sections, the matching scripts live in the advanced page */
+extern const char* battery_section_actions;
+#endif
+
+/**
+ * @brief False while the visible callback of the section hides it, both on the page and at /advancedSection
+ *
+ * @param[in] section
+ *
+ * @return bool
+ */
+bool battery_section_visible(const BATTERY_SECTION_TYPE& section);
+
+/**
+ * @brief Write one section as <h4>label: value unit</h4> lines
+ *
+ * @param[in] out
+ * @param[in] section
+ *
+ * @return void
+ */
+void render_battery_section_html(Print& out, const BATTERY_SECTION_TYPE& section);
+
+/**
+ * @brief Write one section as {"title":..,"fields":[{"label":..,"value":..,"unit":..}]}
+ *
+ * @param[in] out
+ * @param[in] section
+ *
+ * @return void
+ */
+void render_battery_section_json(Print& out, const BATTERY_SECTION_TYPE& section);
+
+#endif
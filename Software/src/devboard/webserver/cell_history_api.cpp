@@ -0,0 +1,158 @@
+#include "cell_history_api.h"
+#include <math.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <memory>
+#include "../../../USER_SECRETS.h"
+#include "../../datalayer/datalayer.h"
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../utils/cell_history.h"
+#include "webserver.h"
+
+#ifdef CELL_HISTORY
+
+/** Releases the copies of the history, they come from cell_history_alloc() */
+struct CellHistoryFree {
+  void operator()(void* copy) const { free(copy); }
+};
+
+/** Position in the CSV series of one cell, kept between chunk callbacks of one response */
+typedef struct {
+  uint16_t count;
+  /** 0 is the column header, then one line per sample */
+  uint16_t line;
+  char text[CELL_HISTORY_LINE_LENGTH];
+  size_t length;
+  /** Part of text already copied out, a line may be split over two chunks */
+  size_t sent;
+  /** Copied when the request arrives, so the series does not move while it is being sent */
+  std::unique_ptr<CELL_HISTORY_SAMPLE_TYPE[], CellHistoryFree> samples;
+  std::unique_ptr<int8_t[], CellHistoryFree> deltas_mV;
+} CELL_HISTORY_CURSOR_TYPE;
+
+/** Two decimals are plenty for mV, and keep the JSON short. NaN stays NaN and is sent as null */
+static float round_hundredths(float value) {
+  return roundf(value * 100) / 100;
+}
+
+static uint8_t history_cell_count([[maybe_unused]] uint8_t battery) {
+#ifdef DOUBLE_BATTERY
+  if (battery == 1) {
+    return datalayer.battery2.info.number_of_cells;
+  }
+#endif  // DOUBLE_BATTERY
+  return datalayer.battery.info.number_of_cells;
+}
+
+static void send_summary(AsyncWebServerRequest* request) {
+  JsonDocument doc;
+  doc["interval_s"] = CELL_HISTORY_INTERVAL_MS / 1000;
+  doc["capacity"] = cell_history_capacity();
+
+  JsonArray batteries = doc["batteries"].to<JsonArray>();
+  for (uint8_t battery = 0; battery < CELL_HISTORY_BATTERIES; battery++) {
+    CELL_HISTORY_PACK_TYPE pack;
+    cell_history_analyze_pack(battery, pack);
+    JsonObject entry = batteries.add<JsonObject>();
+    entry["samples"] = pack.samples;
+    entry["span_s"] = pack.span_s;
+    entry["spread_first_mV"] = pack.spread_first_mV;
+    entry["spread_last_mV"] = pack.spread_last_mV;
+    entry["spread_trend_mV_per_h"] = round_hundredths(pack.spread_trend_mV_per_h);
+
+    // One array per value instead of an object per cell, that is a third of the document for a large pack
+    JsonArray delta = entry["delta_mV"].to<JsonArray>();
+    JsonArray trend = entry["trend_mV_per_h"].to<JsonArray>();
+    JsonArray sag = entry["sag_mV"].to<JsonArray>();
+    const uint8_t cells = std::min<uint16_t>(history_cell_count(battery), MAX_AMOUNT_CELLS);
+    for (uint8_t cell = 0; cell < cells; cell++) {
+      CELL_HISTORY_CELL_TYPE result;
+      cell_history_analyze_cell(battery, cell, result);
+      if (result.delta_mV == CELL_HISTORY_NO_READING) {
+        delta.add(nullptr);
+      } else {
+        delta.add(result.delta_mV);
+      }
+      trend.add(round_hundredths(result.trend_mV_per_h));
+      sag.add(round_hundredths(result.sag_mV));
+    }
+  }
+
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  serializeJson(doc, *response);
+  request->send(response);
+}
+
+/** Render the next line into the cursor, false once the series is complete */
+static bool series_next_line(CELL_HISTORY_CURSOR_TYPE& cursor) {
+  cursor.sent = 0;
+  if (cursor.line == 0) {
+    cursor.length = snprintf(cursor.text, sizeof(cursor.text), "time_s,mean_mV,current_dA,delta_mV\n");
+  } else if (cursor.line <= cursor.count) {
+    const CELL_HISTORY_SAMPLE_TYPE& sample = cursor.samples[cursor.line - 1];
+    const int8_t delta_mV = cursor.deltas_mV[cursor.line - 1];
+    cursor.length = snprintf(cursor.text, sizeof(cursor.text), "%lu,%u,%d,", (unsigned long)sample.time_s,
+                             sample.mean_mV, sample.current_dA);
+    if (delta_mV != CELL_HISTORY_NO_READING) {  // An empty column where the cell had no reading
+      cursor.length += snprintf(cursor.text + cursor.length, sizeof(cursor.text) - cursor.length, "%d", delta_mV);
+    }
+    cursor.text[cursor.length++] = '\n';
+  } else {
+    cursor.length = 0;
+    return false;
+  }
+  cursor.line++;
+  return true;
+}
+
+static size_t series_fill(CELL_HISTORY_CURSOR_TYPE& cursor, uint8_t* buffer, size_t max_length) {
+  size_t written = 0;
+  while (written < max_length) {
+    if (cursor.sent == cursor.length && !series_next_line(cursor)) {
+      break;  // Returning 0 ends the chunked response
+    }
+    const size_t count = std::min(cursor.length - cursor.sent, max_length - written);
+    memcpy(buffer + written, cursor.text + cursor.sent, count);
+    cursor.sent += count;
+    written += count;
+  }
+  return written;
+}
+
+static void send_series(AsyncWebServerRequest* request, uint8_t battery, uint16_t cell) {
+  const uint16_t capacity = cell_history_capacity();
+  std::shared_ptr<CELL_HISTORY_CURSOR_TYPE> cursor = std::make_shared<CELL_HISTORY_CURSOR_TYPE>();
+  // In PSRAM like the history itself, so a request does not take a full series out of the internal heap
+  cursor->samples.reset((CELL_HISTORY_SAMPLE_TYPE*)cell_history_alloc(capacity * sizeof(CELL_HISTORY_SAMPLE_TYPE)));
+  cursor->deltas_mV.reset((int8_t*)cell_history_alloc(capacity));
+  if (!cursor->samples || !cursor->deltas_mV) {
+    request->send(503, "text/plain", "Not enough memory for the cell history");
+    return;
+  }
+  cursor->count = cell_history_read(battery, cell, cursor->samples.get(), cursor->deltas_mV.get(), capacity);
+  request->sendChunked("text/csv", [cursor](uint8_t* buffer, size_t max_length, size_t) -> size_t {
+    return series_fill(*cursor, buffer, max_length);
+  });
+}
+
+static void cell_history_handler(AsyncWebServerRequest* request) {
+  if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
+    return request->requestAuthentication();
+
+  if (!request->hasParam("cell")) {
+    send_summary(request);
+    return;
+  }
+  const long cell = request->getParam("cell")->value().toInt();
+  const long battery = request->hasParam("battery") ? request->getParam("battery")->value().toInt() : 0;
+  if (cell < 0 || cell >= MAX_AMOUNT_CELLS || battery < 0 || battery >= CELL_HISTORY_BATTERIES) {
+    request->send(400, "text/plain", "Invalid cell or battery");
+    return;
+  }
+  send_series(request, battery, cell);
+}
+
+void init_cell_history_api(AsyncWebServer& server) {
+  server.on("/api/cellhistory", HTTP_GET, cell_history_handler);
+}
+#endif  // CELL_HISTORY
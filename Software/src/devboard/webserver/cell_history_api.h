@@ -0,0 +1,21 @@
+#ifndef CELL_HISTORY_API_H
+#define CELL_HISTORY_API_H
+
+#include "../../include.h"
+#include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
+
+#define CELL_HISTORY_LINE_LENGTH 48  // Longest line of the CSV series of one cell
+
+/**
+ * @brief Register the /api/cellhistory route. Only built with CELL_HISTORY.
+ *        Without parameters it returns the per cell trend, sag and latest delta from the pack mean plus the
+ *        cell spread of each battery as JSON. With ?cell=N (and &battery=1 for battery2) it returns the
+ *        stored series of that cell as CSV.
+ *
+ * @param[in] server
+ *
+ * @return void
+ */
+void init_cell_history_api(AsyncWebServer& server);
+
+#endif
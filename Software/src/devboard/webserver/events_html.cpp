@@ -1,16 +1,17 @@
 #include "events_html.h"
 #include "../../datalayer/datalayer.h"
+#include "web_assets.h"
 
 const char EVENTS_HTML_START[] = R"=====(
-<style>body{background-color:#000;color:#fff}.event-log{display:flex;flex-direction:column}.event{display:flex;flex-wrap:wrap;border:1px solid #fff;padding:10px}.event>div{flex:1;min-width:100px;max-width:90%;word-break:break-word}</style><div style="background-color:#303e47;padding:10px;margin-bottom:10px;border-radius:25px"><div class="event-log"><div class="event" style="background-color:#1e2c33;font-weight:700"><div>Event Type</div><div>Severity</div><div>Last Event</div><div>Count</div><div>Data</div><div>Message</div></div>
+<link rel="stylesheet" href=")=====" WEB_ASSET_COMMON_CSS_URL R"=====(">
+<link rel="stylesheet" href=")=====" WEB_ASSET_EVENTS_CSS_URL R"=====(">
+<div style="background-color:#303e47;padding:10px;margin-bottom:10px;border-radius:25px"><div class="event-log"><div class="event" style="background-color:#1e2c33;font-weight:700"><div>Event Type</div><div>Severity</div><div>Last Event</div><div>Count</div><div>Data</div><div>Message</div></div>
 )=====";
 const char EVENTS_HTML_END[] = R"=====(
 </div></div>
-<style> button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; cursor: pointer; border-radius: 10px; }
-button:hover { background-color: #3A4A52; }</style>
 <button onclick="askClear()">Clear all events</button>
 <button onclick="home()">Back to main page</button>
-<style>.event:nth-child(even){background-color:#455a64}.event:nth-child(odd){background-color:#394b52}</style><script>function showEvent(){document.querySelectorAll(".event").forEach(function(e){var n=e.querySelector(".sec-ago");n&&(n.innerText=new Date(Date.now()-(4294967296*+n.innerText.split(";")[0]+ +n.innerText.split(";")[1])).toLocaleString())})}function askClear(){window.confirm("Are you sure you want to clear all events?")&&(window.location.href="/clearevents")}function home(){window.location.href="/"}window.onload=function(){showEvent()}</script>
+<script src=")=====" WEB_ASSET_EVENTS_JS_URL R"=====("></script>
 )=====";
 
 static std::vector<EventData> order_events;
@@ -51,7 +52,15 @@ String events_processor(const String& var) {
       content.concat("<div>" + String(get_event_level_string(event_handle)) + "</div>");
       content.concat("<div class='sec-ago'>" + String(datalayer.system.status.millisrolloverCount) + ";" +
                      String(timestamp_now - event_pointer->timestamp) + "</div>");
-      content.concat("<div>" + String(event_pointer->occurences) + "</div>");
+      // Flaps are summed up rather than counted as occurrences, see EVENT_FLAP_TRANSITIONS
+      content.concat("<div>" + String(event_pointer->occurences));
+      if (event_pointer->flaps > 0) {
+        content.concat(" + " + String(event_pointer->flaps) + " flaps");
+      }
+      if (event_pointer->flapping) {
+        content.concat(" (flapping)");
+      }
+      content.concat("</div>");
       content.concat("<div>" + String(event_pointer->data) + "</div>");
       content.concat("<div>" + String(get_event_message_string(event_handle)) + "</div>");
       content.concat("</div>");  // End of event row
@@ -64,35 +73,3 @@ String events_processor(const String& var) {
   }
   return String();
 }
-
-/* Script for displaying event log before it gets minified
-<button onclick="askClear()">Clear all events</button>
-<button onclick="home()">Back to main page</button>
-<style>
-    .event:nth-child(even) {
-        background-color: #455a64;
-    }
-    .event:nth-child(odd) {
-        background-color: #394b52;
-    }
-</style>
-<script>
-    function showEvent() {
-        document.querySelectorAll(".event").forEach(function (e) {
-            var n = e.querySelector(".sec-ago");
-            n && (n.innerText = new Date(Date.now() - (+n.innerText.split(";")[0] * 4294967296 + +n.innerText.split(";")[1])).toLocaleString());
-        });
-    }
-    function askClear() { 
-        if (window.confirm('Are you sure you want to clear all events?')) {
-            window.location.href = '/clearevents';
-        } 
-    }
-    function home() {
-        window.location.href = "/";
-    }
-    window.onload = function () {
-        showEvent();
-    };
-</script>
-*/
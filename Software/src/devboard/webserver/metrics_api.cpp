@@ -0,0 +1,346 @@
+#include "metrics_api.h"
+#include <algorithm>
+#include <memory>
+#include "../../../USER_SECRETS.h"
+#include "../../datalayer/datalayer.h"
+#include "../../datalayer/datalayer_fields.h"
+#include "../utils/events.h"
+#include "webserver.h"
+
+#ifdef DOUBLE_BATTERY
+#define METRICS_BATTERY_COUNT 2
+#else
+#define METRICS_BATTERY_COUNT 1
+#endif  // DOUBLE_BATTERY
+
+/** One value, the raw reading is fixed point so 3712 with 3 decimals is exported as 3.712 */
+typedef struct {
+  const char* name;
+  const char* help;
+  uint8_t decimals;
+  int64_t (*read)(void);
+} METRICS_SYSTEM_TYPE;
+
+// clang-format off
+static const METRICS_SYSTEM_TYPE system_metrics[] = {
+    {"uptime_seconds", "Time since boot", 3, []() -> int64_t {
+       return ((int64_t)datalayer.system.status.millisrolloverCount << 32) | millis();
+     }},
+    {"heap_free_bytes", "Free heap", 0, []() -> int64_t { return ESP.getFreeHeap(); }},
+    {"heap_min_free_bytes", "Lowest free heap since boot", 0, []() -> int64_t { return ESP.getMinFreeHeap(); }},
+    {"heap_max_alloc_bytes", "Largest allocatable heap block", 0, []() -> int64_t { return ESP.getMaxAllocHeap(); }},
+    {"cpu_temperature_celsius", "ESP32 CPU temperature", 1,
+     []() -> int64_t { return (int64_t)(datalayer.system.info.CPU_temperature * 10); }},
+    {"inverter_can_alive", "Inverter CAN still alive counter, 0 when the inverter is missing", 0,
+     []() -> int64_t { return datalayer.system.status.CAN_inverter_still_alive; }},
+    {"can_native_send_fail", "Native CAN failed to send", 0,
+     []() -> int64_t { return datalayer.system.info.can_native_send_fail; }},
+    {"can_2515_send_fail", "MCP2515 CAN failed to send", 0,
+     []() -> int64_t { return datalayer.system.info.can_2515_send_fail; }},
+    {"can_2518_send_fail", "MCP2518 CAN FD failed to send", 0,
+     []() -> int64_t { return datalayer.system.info.can_2518_send_fail; }},
+    {"event_level", "Highest active event level, 0 INFO to 4 UPDATE", 0,
+     []() -> int64_t { return get_event_level(); }},
+    {"equipment_stop_active", "Equipment stop is active", 0,
+     []() -> int64_t { return datalayer.system.settings.equipment_stop_active; }},
+    {"safety_fast_cuts", "Power limit cuts made between values passes since boot", 0,
+     []() -> int64_t { return datalayer.system.status.safety_fast_cuts; }},
+    {"safety_cut_latency_seconds", "Battery CAN frame to inverter limit cut time, last cut", 6,
+     []() -> int64_t { return datalayer.system.status.safety_cut_latency_us; }},
+    {"safety_cut_latency_max_seconds", "Battery CAN frame to inverter limit cut time, worst since boot", 6,
+     []() -> int64_t { return datalayer.system.status.safety_cut_latency_max_us; }},
+#ifdef FUNCTION_TIME_MEASUREMENT
+    {"core_task_max_seconds", "Worst core task loop since boot", 6,
+     []() -> int64_t { return datalayer.system.status.core_task_max_us; }},
+    {"core_task_10s_max_seconds", "Worst core task loop in the last 10 s", 6,
+     []() -> int64_t { return datalayer.system.status.core_task_10s_max_us; }},
+    {"mqtt_task_10s_max_seconds", "Worst MQTT loop in the last 10 s", 6,
+     []() -> int64_t { return datalayer.system.status.mqtt_task_10s_max_us; }},
+    {"wifi_task_10s_max_seconds", "Worst WiFi loop in the last 10 s", 6,
+     []() -> int64_t { return datalayer.system.status.wifi_task_10s_max_us; }},
+    {"time_ota_seconds", "OTA handling time in the worst core task loop", 6,
+     []() -> int64_t { return datalayer.system.status.time_snap_ota_us; }},
+    {"time_comm_seconds", "CAN RX or serial link time in the worst core task loop", 6,
+     []() -> int64_t { return datalayer.system.status.time_snap_comm_us; }},
+    {"time_10ms_seconds", "10 ms function time in the worst core task loop", 6,
+     []() -> int64_t { return datalayer.system.status.time_snap_10ms_us; }},
+    {"time_values_seconds", "Value update time in the worst core task loop", 6,
+     []() -> int64_t { return datalayer.system.status.time_snap_values_us; }},
+    {"time_cantx_seconds", "CAN TX time in the worst core task loop", 6,
+     []() -> int64_t { return datalayer.system.status.time_snap_cantx_us; }},
+    {"heap_fragmentation_ratio", "1 - largest free block / free heap", 2,
+     []() -> int64_t { return datalayer.system.status.heap_fragmentation_pct; }},
+    {"mqtt_command_latency_max_seconds", "Worst MQTT command arrival to execution time", 6,
+     []() -> int64_t { return datalayer.system.status.mqtt_command_latency_max_us; }},
+#endif  // FUNCTION_TIME_MEASUREMENT
+};
+// clang-format on
+
+#define METRICS_SYSTEM_COUNT (sizeof(system_metrics) / sizeof(system_metrics[0]))
+
+/** Battery values are the datalayer field registry, one family per field with a sample per battery */
+typedef struct {
+  const char* unit;
+  /** Decimals on top of the registry ones, to export in base units, e.g. 2 for percent as ratio */
+  uint8_t decimals;
+} METRICS_UNIT_TYPE;
+
+static const METRICS_UNIT_TYPE metrics_units[] = {
+    {"%", 2},
+    {"mV", 3},
+};
+
+static uint8_t metrics_field_decimals(const DATALAYER_FIELD_TYPE& field) {
+  for (const METRICS_UNIT_TYPE& unit : metrics_units) {
+    if (strcmp(unit.unit, field.unit) == 0) {
+      return field.decimals + unit.decimals;
+    }
+  }
+  return field.decimals;
+}
+
+typedef enum {
+  METRICS_STAGE_SYSTEM = 0,
+  METRICS_STAGE_BATTERY,
+  METRICS_STAGE_CELLS,
+  METRICS_STAGE_EVENTS,
+  METRICS_STAGE_EOF,
+  METRICS_STAGE_DONE,
+} METRICS_STAGE_TYPE;
+
+/** Position in the page, kept between chunk callbacks of one response */
+typedef struct {
+  uint8_t stage;
+  uint8_t family;
+  /** 0 is the # TYPE line, 1 the # HELP line, then one line per sample */
+  uint16_t line;
+  char text[METRICS_LINE_LENGTH];
+  size_t length;
+  /** Part of text already copied out, a line may be split over two chunks */
+  size_t sent;
+  /** Battery values of the whole scrape come from one core task update cycle */
+  DATALAYER_SNAPSHOT_TYPE snapshot;
+} METRICS_CURSOR_TYPE;
+
+static const DATALAYER_BATTERY_TYPE& metrics_battery(const METRICS_CURSOR_TYPE& cursor,
+                                                     [[maybe_unused]] uint8_t index) {
+#ifdef DOUBLE_BATTERY
+  if (index == 1) {
+    return cursor.snapshot.battery2;
+  }
+#endif  // DOUBLE_BATTERY
+  return cursor.snapshot.battery;
+}
+
+static uint16_t metrics_cell_count(const METRICS_CURSOR_TYPE& cursor, uint8_t battery) {
+  return std::min<uint16_t>(metrics_battery(cursor, battery).info.number_of_cells, MAX_AMOUNT_CELLS);
+}
+
+static void metrics_append(METRICS_CURSOR_TYPE& cursor, const char* text) {
+  // One byte is kept for the newline, so an over-long line is cut but never merges with the next one
+  while (*text != '\0' && cursor.length < METRICS_LINE_LENGTH - 1) {
+    cursor.text[cursor.length++] = *text++;
+  }
+}
+
+static void metrics_append_number(METRICS_CURSOR_TYPE& cursor, int64_t raw, uint8_t decimals = 0) {
+  char digits[24];
+  uint8_t count = 0;
+  uint64_t magnitude = raw < 0 ? 0u - (uint64_t)raw : (uint64_t)raw;
+  // Digits in reverse, at least one more than the decimals so there is a leading zero
+  do {
+    digits[count++] = '0' + (magnitude % 10);
+    magnitude /= 10;
+  } while (magnitude > 0 || count <= decimals);
+
+  char text[28];
+  uint8_t length = 0;
+  if (raw < 0) {
+    text[length++] = '-';
+  }
+  for (uint8_t i = count; i > 0; i--) {
+    if (i == decimals) {
+      text[length++] = '.';
+    }
+    text[length++] = digits[i - 1];
+  }
+  text[length] = '\0';
+  metrics_append(cursor, text);
+}
+
+static void metrics_append_label(METRICS_CURSOR_TYPE& cursor, const char* label, const char* value, bool first) {
+  metrics_append(cursor, first ? "{" : ",");
+  metrics_append(cursor, label);
+  metrics_append(cursor, "=\"");
+  metrics_append(cursor, value);
+  metrics_append(cursor, "\"");
+}
+
+static uint8_t metrics_families(uint8_t stage) {
+  switch (stage) {
+    case METRICS_STAGE_SYSTEM:
+      return METRICS_SYSTEM_COUNT;
+    case METRICS_STAGE_BATTERY:
+      return DATALAYER_BATTERY_FIELD_COUNT;
+    default:
+      return 1;
+  }
+}
+
+static uint16_t metrics_samples(const METRICS_CURSOR_TYPE& cursor) {
+  switch (cursor.stage) {
+    case METRICS_STAGE_SYSTEM:
+      return 1;
+    case METRICS_STAGE_BATTERY:
+      return METRICS_BATTERY_COUNT;
+    case METRICS_STAGE_CELLS: {
+      uint16_t cells = 0;
+      for (uint8_t battery = 0; battery < METRICS_BATTERY_COUNT; battery++) {
+        cells += metrics_cell_count(cursor, battery);
+      }
+      return cells;
+    }
+    case METRICS_STAGE_EVENTS:
+      return EVENT_NOF_EVENTS;
+    default:
+      return 0;
+  }
+}
+
+static void metrics_write_header(METRICS_CURSOR_TYPE& cursor, const char* name, const char* type, const char* help) {
+  metrics_append(cursor, cursor.line == 0 ? "# TYPE " METRICS_PREFIX : "# HELP " METRICS_PREFIX);
+  metrics_append(cursor, name);
+  metrics_append(cursor, " ");
+  metrics_append(cursor, cursor.line == 0 ? type : help);
+}
+
+static void metrics_write_sample(METRICS_CURSOR_TYPE& cursor, uint16_t sample) {
+  char number[6];
+  switch (cursor.stage) {
+    case METRICS_STAGE_SYSTEM: {
+      const METRICS_SYSTEM_TYPE& metric = system_metrics[cursor.family];
+      metrics_append(cursor, METRICS_PREFIX);
+      metrics_append(cursor, metric.name);
+      metrics_append(cursor, " ");
+      metrics_append_number(cursor, metric.read(), metric.decimals);
+      break;
+    }
+    case METRICS_STAGE_BATTERY: {
+      const DATALAYER_FIELD_TYPE& field = datalayer_battery_fields[cursor.family];
+      metrics_append(cursor, METRICS_PREFIX);
+      metrics_append(cursor, field.metric);
+      snprintf(number, sizeof(number), "%u", (unsigned)(sample + 1));
+      metrics_append_label(cursor, "battery", number, true);
+      metrics_append(cursor, "} ");
+      metrics_append_number(cursor, read_datalayer_field(metrics_battery(cursor, sample), cursor.family),
+                            metrics_field_decimals(field));
+      break;
+    }
+    case METRICS_STAGE_CELLS: {
+      uint8_t battery = 0;
+      while (battery < METRICS_BATTERY_COUNT - 1 && sample >= metrics_cell_count(cursor, battery)) {
+        sample -= metrics_cell_count(cursor, battery);
+        battery++;
+      }
+      metrics_append(cursor, METRICS_PREFIX "cell_voltage_volts");
+      snprintf(number, sizeof(number), "%u", (unsigned)(battery + 1));
+      metrics_append_label(cursor, "battery", number, true);
+      snprintf(number, sizeof(number), "%u", (unsigned)(sample + 1));
+      metrics_append_label(cursor, "cell", number, false);
+      metrics_append(cursor, "} ");
+      const uint16_t* voltages_mV = metrics_battery(cursor, battery).status.cell_voltages_mV;
+      metrics_append_number(cursor, voltages_mV[sample % MAX_AMOUNT_CELLS], 3);
+      break;
+    }
+    case METRICS_STAGE_EVENTS: {
+      const EVENTS_ENUM_TYPE event = (EVENTS_ENUM_TYPE)sample;
+      metrics_append(cursor, METRICS_PREFIX "events_total");
+      metrics_append_label(cursor, "event", get_event_enum_string(event), true);
+      metrics_append_label(cursor, "level", get_event_level_string(event), false);
+      metrics_append(cursor, "} ");
+      metrics_append_number(cursor, get_event_pointer(event)->occurences);
+      break;
+    }
+  }
+}
+
+static void metrics_write_line(METRICS_CURSOR_TYPE& cursor) {
+  if (cursor.line >= 2) {
+    metrics_write_sample(cursor, cursor.line - 2);
+    return;
+  }
+  switch (cursor.stage) {
+    case METRICS_STAGE_SYSTEM:
+      metrics_write_header(cursor, system_metrics[cursor.family].name, "gauge", system_metrics[cursor.family].help);
+      break;
+    case METRICS_STAGE_BATTERY:
+      metrics_write_header(cursor, datalayer_battery_fields[cursor.family].metric, "gauge",
+                           datalayer_battery_fields[cursor.family].title);
+      break;
+    case METRICS_STAGE_CELLS:
+      metrics_write_header(cursor, "cell_voltage_volts", "gauge", "Cell voltage");
+      break;
+    case METRICS_STAGE_EVENTS:
+      // Counter families are named without the _total suffix their samples carry
+      metrics_write_header(cursor, "events", "counter", "Event occurrences since boot");
+      break;
+  }
+}
+
+/** Render the next line into the cursor, false once the page is complete */
+static bool metrics_next_line(METRICS_CURSOR_TYPE& cursor) {
+  cursor.length = 0;
+  cursor.sent = 0;
+  while (cursor.stage < METRICS_STAGE_EOF) {
+    if (cursor.family >= metrics_families(cursor.stage)) {
+      cursor.stage++;
+      cursor.family = 0;
+      cursor.line = 0;
+    } else if (cursor.line >= 2 + metrics_samples(cursor)) {
+      cursor.family++;
+      cursor.line = 0;
+    } else {
+      metrics_write_line(cursor);
+      cursor.line++;
+      cursor.text[cursor.length++] = '\n';
+      return true;
+    }
+  }
+  if (cursor.stage == METRICS_STAGE_EOF) {
+    metrics_append(cursor, "# EOF\n");
+    cursor.stage = METRICS_STAGE_DONE;
+    return true;
+  }
+  return false;
+}
+
+static size_t metrics_fill(METRICS_CURSOR_TYPE& cursor, uint8_t* buffer, size_t max_length) {
+  size_t written = 0;
+  while (written < max_length) {
+    if (cursor.sent == cursor.length && !metrics_next_line(cursor)) {
+      break;  // Returning 0 ends the chunked response
+    }
+    const size_t count = std::min(cursor.length - cursor.sent, max_length - written);
+    memcpy(buffer + written, cursor.text + cursor.sent, count);
+    cursor.sent += count;
+    written += count;
+  }
+  return written;
+}
+
+static void metrics_handler(AsyncWebServerRequest* request) {
+  if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
+    return request->requestAuthentication();
+
+  // The cursor lives as long as the response holds the filler, the only allocation besides the chunk buffers
+  std::shared_ptr<METRICS_CURSOR_TYPE> cursor = std::make_shared<METRICS_CURSOR_TYPE>();
+  read_datalayer_snapshot(cursor->snapshot);
+  request->sendChunked("application/openmetrics-text; version=1.0.0; charset=utf-8",
+                       [cursor](uint8_t* buffer, size_t max_length, size_t) -> size_t {
+                         return metrics_fill(*cursor, buffer, max_length);
+                       });
+}
+
+void init_metrics_api(AsyncWebServer& server) {
+  server.on("/metrics", HTTP_GET, metrics_handler);
+}
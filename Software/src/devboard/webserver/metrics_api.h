@@ -0,0 +1,22 @@
+#ifndef METRICS_API_H
+#define METRICS_API_H
+
+#include "../../include.h"
+#include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
+
+#define METRICS_PREFIX "battery_emulator_"
+#define METRICS_LINE_LENGTH 160  // Longest single exposition line, labels included
+
+/**
+ * @brief Register the /metrics route, a Prometheus/OpenMetrics text exposition of the datalayer,
+ *        CAN health, event counters, heap and (with FUNCTION_TIME_MEASUREMENT) task timing.
+ *        The page is generated line by line into the chunk buffers of the response, so no copy
+ *        of the full page is ever held in RAM.
+ *
+ * @param[in] server
+ *
+ * @return void
+ */
+void init_metrics_api(AsyncWebServer& server);
+
+#endif
@@ -0,0 +1,80 @@
+#include "page_cache.h"
+#include <memory>
+#include <mutex>
+#include "../utils/timer.h"
+#include "index_html.h"
+
+typedef struct {
+  std::shared_ptr<const String> body;  // Shared with the responses still sending it, empty when not cached
+  String etag;
+  uint32_t generation;
+  unsigned long rendered_ms;
+  unsigned long requested_ms;
+} PAGE_CACHE_ENTRY_TYPE;
+
+// Rendered once per data change and shared by every client viewing the page
+static PAGE_CACHE_ENTRY_TYPE entries[PAGE_CACHE_COUNT];
+// Pages are served on the async_tcp task, expire_cached_pages() runs on the connectivity task
+static std::mutex cache_mutex;
+// Generations start over after a reboot, so the ETag of a page rendered before it must not match afterwards
+static uint32_t boot_id = 0;
+static MyTimer expire_timer(1000);
+
+void send_cached_page(AsyncWebServerRequest* request, PAGE_CACHE_TYPE page, uint32_t generation,
+                      unsigned long max_age_ms, String (*processor)(const String& var)) {
+  PAGE_CACHE_ENTRY_TYPE& entry = entries[page];
+  std::shared_ptr<const String> body;
+  String etag;
+  {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    const unsigned long now = millis();
+    entry.requested_ms = now;
+    if (!entry.body || entry.generation != generation || (max_age_ms > 0 && now - entry.rendered_ms > max_age_ms)) {
+      if (boot_id == 0) {
+        boot_id = esp_random() | 1;
+      }
+      // Same output as the %X% template. Responses still sending the previous copy keep it alive until done.
+      entry.body =
+          std::make_shared<const String>(String(index_html_header) + processor("X") + String(index_html_footer));
+      entry.generation = generation;
+      entry.rendered_ms = now;
+      entry.etag = "\"" + String(boot_id, HEX) + "-" + String(generation, HEX);
+      if (max_age_ms > 0) {
+        entry.etag += "-" + String(now, HEX);  // Re-rendered with the same generation, the content still differs
+      }
+      entry.etag += "\"";
+    }
+    body = entry.body;
+    etag = entry.etag;
+  }
+
+  AsyncWebServerResponse* response;
+  if (request->hasHeader("If-None-Match") && request->header("If-None-Match") == etag) {
+    response = request->beginResponse(304);
+  } else {
+    // Sent straight from the cached copy, no per-client copy of the page
+    response =
+        request->beginResponse("text/html", body->length(), [body](uint8_t* buffer, size_t max_length, size_t index) {
+          const size_t count = std::min<size_t>(max_length, body->length() - index);
+          memcpy(buffer, body->c_str() + index, count);
+          return count;
+        });
+  }
+  response->addHeader("ETag", etag);
+  response->addHeader("Cache-Control", "no-cache");
+  request->send(response);
+}
+
+void expire_cached_pages(void) {
+  if (!expire_timer.elapsed()) {
+    return;
+  }
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  const unsigned long now = millis();
+  for (PAGE_CACHE_ENTRY_TYPE& entry : entries) {
+    if (entry.body && now - entry.requested_ms > PAGE_CACHE_IDLE_MS) {
+      entry.body.reset();
+      entry.etag = String();
+    }
+  }
+}
@@ -0,0 +1,39 @@
+#ifndef PAGE_CACHE_H
+#define PAGE_CACHE_H
+
+#include "../../include.h"
+#include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
+
+// Upper bound on how old a cached page may get while its generation is unchanged, keeps uptime and "time ago" fresh
+#define PAGE_CACHE_MAX_AGE_MS 5000
+// A page nobody asked for this long is freed, the next request renders it again
+#define PAGE_CACHE_IDLE_MS 60000
+
+typedef enum { PAGE_CACHE_INDEX, PAGE_CACHE_CELLMONITOR, PAGE_CACHE_EVENTS, PAGE_CACHE_COUNT } PAGE_CACHE_TYPE;
+
+/**
+ * @brief Send an index_html page whose %X% content comes from processor, rendering it only if
+ *        generation changed or the cached copy is older than max_age_ms.
+ *        Answers 304 when the client already holds the current copy (If-None-Match).
+ *
+ * @param[in] request
+ * @param[in] page Cache slot of the route
+ * @param[in] generation Changes whenever the data shown on the page changes
+ * @param[in] max_age_ms PAGE_CACHE_MAX_AGE_MS for pages showing times, 0 for pages that only depend on generation
+ * @param[in] processor
+ *
+ * @return void
+ */
+void send_cached_page(AsyncWebServerRequest* request, PAGE_CACHE_TYPE page, uint32_t generation,
+                      unsigned long max_age_ms, String (*processor)(const String& var));
+
+/**
+ * @brief Free the cached pages nobody requested for PAGE_CACHE_IDLE_MS
+ *
+ * @param[in] void
+ *
+ * @return void
+ */
+void expire_cached_pages(void);
+
+#endif
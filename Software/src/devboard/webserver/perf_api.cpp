@@ -0,0 +1,150 @@
+#include "perf_api.h"
+#include <algorithm>
+#include "../../../USER_SECRETS.h"
+#include "../../lib/bblanchon-ArduinoJson/ArduinoJson.h"
+#include "../utils/latency_trace.h"
+#include "esp_timer.h"
+#include "webserver.h"
+
+#ifdef FUNCTION_TIME_MEASUREMENT
+
+typedef struct {
+  char name[PERF_ROUTE_NAME_LENGTH];
+  uint32_t count;
+  /** Time from request dispatch until the connection is closed, includes template rendering and sending */
+  uint32_t latency_us[PERF_LATENCY_SAMPLES];
+  uint8_t latency_index;
+  /** Worst time spent inside the handler itself */
+  uint32_t handler_max_us;
+  uint64_t bytes_total;
+  uint32_t bytes_max;
+  /** Most negative free heap change over the handler, i.e. what the response keeps allocated while sending */
+  int32_t heap_delta_min;
+  uint32_t min_free_heap;
+} PERF_ROUTE_TYPE;
+
+// All webserver callbacks run in the async TCP task, so the table needs no locking
+static PERF_ROUTE_TYPE perf_routes[PERF_MAX_ROUTES];
+static uint8_t perf_route_count = 0;
+
+// _sentLength is protected; a member pointer named through a derived class is the legal way to read it
+struct PerfResponseAccess : AsyncWebServerResponse {
+  static size_t sent_length(AsyncWebServerResponse* response) { return response->*(&PerfResponseAccess::_sentLength); }
+};
+
+static PERF_ROUTE_TYPE* perf_find_route(const String& url) {
+  for (uint8_t i = 0; i < perf_route_count; i++) {
+    if (strncmp(perf_routes[i].name, url.c_str(), PERF_ROUTE_NAME_LENGTH - 1) == 0) {
+      return &perf_routes[i];
+    }
+  }
+  if (perf_route_count == PERF_MAX_ROUTES) {
+    // Last slot is shared by everything that did not fit, such as 404 probes
+    return &perf_routes[PERF_MAX_ROUTES - 1];
+  }
+  PERF_ROUTE_TYPE* route = &perf_routes[perf_route_count++];
+  strlcpy(route->name, perf_route_count == PERF_MAX_ROUTES ? "other" : url.c_str(), PERF_ROUTE_NAME_LENGTH);
+  route->min_free_heap = UINT32_MAX;
+  return route;
+}
+
+static void perf_middleware(AsyncWebServerRequest* request, ArMiddlewareNext next) {
+  PERF_ROUTE_TYPE* route = perf_find_route(request->url());
+  const int64_t start_us = esp_timer_get_time();
+
+  // The response is rendered and sent after the handler returns, so latency and bytes are taken on disconnect.
+  // The callback runs before the request is deleted, so the response is still valid here. It is registered before
+  // the handler runs, so a handler that needs its own disconnect callback replaces it instead of losing it.
+  request->onDisconnect([request, route, start_us]() {
+    route->count++;
+    route->latency_us[route->latency_index] = (uint32_t)(esp_timer_get_time() - start_us);
+    route->latency_index = (route->latency_index + 1) % PERF_LATENCY_SAMPLES;
+    route->min_free_heap = std::min(route->min_free_heap, (uint32_t)ESP.getFreeHeap());
+
+    AsyncWebServerResponse* response = request->getResponse();
+    if (response != nullptr) {
+      const uint32_t bytes = PerfResponseAccess::sent_length(response);
+      route->bytes_total += bytes;
+      route->bytes_max = std::max(route->bytes_max, bytes);
+    }
+  });
+
+  const uint32_t heap_before = ESP.getFreeHeap();
+
+  next();
+
+  const uint32_t handler_us = (uint32_t)(esp_timer_get_time() - start_us);
+  const uint32_t heap_after = ESP.getFreeHeap();
+
+  route->handler_max_us = std::max(route->handler_max_us, handler_us);
+  route->heap_delta_min = std::min(route->heap_delta_min, (int32_t)(heap_after - heap_before));
+  route->min_free_heap = std::min(route->min_free_heap, heap_after);
+}
+
+static uint32_t perf_percentile(const PERF_ROUTE_TYPE& route, uint8_t percent) {
+  const uint8_t samples = std::min(route.count, (uint32_t)PERF_LATENCY_SAMPLES);
+  if (samples == 0) {
+    return 0;
+  }
+  uint32_t sorted[PERF_LATENCY_SAMPLES];
+  memcpy(sorted, route.latency_us, samples * sizeof(uint32_t));
+  std::sort(sorted, sorted + samples);
+  return sorted[((samples - 1) * percent + 50) / 100];
+}
+
+static void perf_api_handler(AsyncWebServerRequest* request) {
+  if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
+    return request->requestAuthentication();
+
+  JsonDocument doc;
+  doc["free_heap"] = ESP.getFreeHeap();
+  doc["min_free_heap"] = ESP.getMinFreeHeap();
+  doc["max_alloc_heap"] = ESP.getMaxAllocHeap();
+
+  JsonArray routes = doc["routes"].to<JsonArray>();
+  for (uint8_t i = 0; i < perf_route_count; i++) {
+    const PERF_ROUTE_TYPE& route = perf_routes[i];
+    JsonObject entry = routes.add<JsonObject>();
+    entry["route"] = route.name;
+    entry["count"] = route.count;
+    entry["p50_us"] = perf_percentile(route, 50);
+    entry["p99_us"] = perf_percentile(route, 99);
+    entry["handler_max_us"] = route.handler_max_us;
+    entry["bytes_total"] = route.bytes_total;
+    entry["bytes_max"] = route.bytes_max;
+    entry["heap_delta_min"] = route.heap_delta_min;
+    entry["min_free_heap"] = route.min_free_heap;
+  }
+
+  JsonArray buckets = doc["latency_buckets_ms"].to<JsonArray>();
+  for (uint16_t bucket_ms : latency_trace_bucket_ms) {
+    buckets.add(bucket_ms);
+  }
+  JsonArray latency = doc["latency"].to<JsonArray>();
+  for (uint8_t i = 0; i < latency_trace_field_count(); i++) {
+    const LATENCY_TRACE_FIELD_TYPE& trace = get_latency_trace(i);
+    JsonObject entry = latency.add<JsonObject>();
+    entry["field"] = datalayer_battery_fields[trace.field].key;
+    entry["frame_writes"] = trace.frame_writes;
+    entry["task_writes"] = trace.task_writes;
+    entry["untransmitted"] = trace.untransmitted;
+    for (uint8_t stage = 0; stage < LATENCY_STAGE_COUNT; stage++) {
+      JsonObject stage_entry = entry[latency_trace_stage_names[stage]].to<JsonObject>();
+      stage_entry["max_us"] = trace.max_us[stage];
+      JsonArray histogram = stage_entry["histogram"].to<JsonArray>();
+      for (uint32_t count : trace.histogram[stage]) {
+        histogram.add(count);
+      }
+    }
+  }
+
+  AsyncResponseStream* response = request->beginResponseStream("application/json");
+  serializeJson(doc, *response);
+  request->send(response);
+}
+
+void init_perf_api(AsyncWebServer& server) {
+  server.addMiddleware(perf_middleware);
+  server.on("/api/perf", HTTP_GET, perf_api_handler);
+}
+#endif  // FUNCTION_TIME_MEASUREMENT
@@ -0,0 +1,21 @@
+#ifndef PERF_API_H
+#define PERF_API_H
+
+#include "../../include.h"
+#include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
+
+#define PERF_MAX_ROUTES 40         // Routes beyond this are accounted under "other"
+#define PERF_ROUTE_NAME_LENGTH 32  // Longer URLs are truncated
+#define PERF_LATENCY_SAMPLES 32    // Per route ring of most recent latencies, used for p50/p99
+
+/**
+ * @brief Register the request measurement middleware and the /api/perf route, which also reports the battery
+ *        to inverter latency histograms of latency_trace.h. Only built with FUNCTION_TIME_MEASUREMENT.
+ *
+ * @param[in] server
+ *
+ * @return void
+ */
+void init_perf_api(AsyncWebServer& server);
+
+#endif
@@ -0,0 +1,15 @@
+#include "web_assets.h"
+#include "web_assets_gz.h"
+
+void init_web_assets(AsyncWebServer& server) {
+  for (const WEB_ASSET_TYPE& asset : web_assets) {
+    server.on(asset.path, HTTP_GET, [&asset](AsyncWebServerRequest* request) {
+      // Sent straight from flash, already compressed
+      AsyncWebServerResponse* response = request->beginResponse(200, asset.content_type, asset.data, asset.length);
+      response->addHeader("Content-Encoding", "gzip");
+      // Pages link with a content hash in the URL, so a new firmware never gets served an old cached copy
+      response->addHeader("Cache-Control", "public, max-age=31536000, immutable");
+      request->send(response);
+    });
+  }
+}
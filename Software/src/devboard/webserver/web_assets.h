@@ -0,0 +1,16 @@
+#ifndef WEB_ASSETS_H
+#define WEB_ASSETS_H
+
+#include "../../lib/ESP32Async-ESPAsyncWebServer/src/ESPAsyncWebServer.h"
+#include "web_assets_urls.h"
+
+/**
+ * @brief Register the gzip compressed static CSS/JS assets under /static/
+ *
+ * @param[in] server
+ *
+ * @return void
+ */
+void init_web_assets(AsyncWebServer& server);
+
+#endif
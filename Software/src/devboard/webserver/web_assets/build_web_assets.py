@@ -0,0 +1,124 @@
+"""Minify and gzip the static web assets in this folder into ../web_assets_gz.h, with the
+versioned URLs pages should link to in ../web_assets_urls.h
+
+Run it after editing any .css or .js file here:
+
+    python Software/src/devboard/webserver/web_assets/build_web_assets.py
+
+PlatformIO runs it automatically as a pre build script. The generated headers are committed
+so Arduino IDE and arduino-cli builds do not need Python.
+"""
+
+import gzip
+import hashlib
+import os
+import re
+
+try:
+    Import("env")  # noqa: F821 - only defined when run by PlatformIO
+    ASSET_DIR = os.path.join(env["PROJECT_DIR"], "Software", "src", "devboard", "webserver", "web_assets")  # noqa: F821
+except NameError:
+    ASSET_DIR = os.path.dirname(os.path.abspath(__file__))
+
+DATA_OUTPUT = os.path.join(ASSET_DIR, "..", "web_assets_gz.h")
+URLS_OUTPUT = os.path.join(ASSET_DIR, "..", "web_assets_urls.h")
+
+CONTENT_TYPES = {".css": "text/css", ".js": "application/javascript"}
+
+
+def minify_css(text):
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    text = re.sub(r"\s+", " ", text)
+    text = re.sub(r"\s*([{}:;,>])\s*", r"\1", text)
+    return text.replace(";}", "}").strip()
+
+
+def minify_js(text):
+    # Conservative on purpose: drop comments and indentation but keep line breaks, so automatic
+    # semicolon insertion and template literals behave exactly as in the source file
+    text = re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+    lines = []
+    for line in text.splitlines():
+        line = line.strip()
+        if line and not line.startswith("//"):
+            lines.append(line)
+    return "\n".join(lines)
+
+
+def write_if_changed(path, text):
+    if os.path.exists(path):
+        with open(path, encoding="utf-8") as f:
+            if f.read() == text:
+                return
+    with open(path, "w", encoding="utf-8", newline="\n") as f:
+        f.write(text)
+
+
+def symbol_for(filename):
+    return re.sub(r"[^A-Za-z0-9]", "_", filename).upper()
+
+
+def main():
+    assets = sorted(f for f in os.listdir(ASSET_DIR) if os.path.splitext(f)[1] in CONTENT_TYPES)
+    out = [
+        "// Generated by web_assets/build_web_assets.py, do not edit. Edit the files in web_assets/ instead.",
+        "#ifndef WEB_ASSETS_GZ_H",
+        "#define WEB_ASSETS_GZ_H",
+        "",
+        "#include <Arduino.h>",
+        "",
+        "// clang-format off",
+    ]
+    urls = [
+        "// Generated by web_assets/build_web_assets.py, do not edit. Edit the files in web_assets/ instead.",
+        "#ifndef WEB_ASSETS_URLS_H",
+        "#define WEB_ASSETS_URLS_H",
+        "",
+        "// The ?v= part is a content hash, so browsers may cache these URLs forever",
+    ]
+    table = []
+    for filename in assets:
+        ext = os.path.splitext(filename)[1]
+        with open(os.path.join(ASSET_DIR, filename), encoding="utf-8") as f:
+            source = f.read()
+        minified = minify_css(source) if ext == ".css" else minify_js(source)
+        # mtime=0 keeps the output identical between runs so the header only changes with the sources
+        compressed = gzip.compress(minified.encode("utf-8"), compresslevel=9, mtime=0)
+        version = hashlib.sha1(compressed).hexdigest()[:8]
+        symbol = symbol_for(filename)
+
+        out.append("")
+        out.append("// %s: %d bytes source, %d minified, %d gzipped" %
+                   (filename, len(source.encode("utf-8")), len(minified), len(compressed)))
+        urls.append('#define WEB_ASSET_%s_URL "/static/%s?v=%s"' % (symbol, filename, version))
+        out.append("const uint8_t %s_GZ[] PROGMEM = {" % symbol)
+        for i in range(0, len(compressed), 20):
+            out.append("  " + ",".join("0x%02x" % b for b in compressed[i:i + 20]) + ",")
+        out.append("};")
+        table.append('  {"/static/%s", "%s", %s_GZ, sizeof(%s_GZ)},' % (filename, CONTENT_TYPES[ext], symbol, symbol))
+
+    out.append("")
+    out.append("typedef struct {")
+    out.append("  const char* path;")
+    out.append("  const char* content_type;")
+    out.append("  const uint8_t* data;")
+    out.append("  size_t length;")
+    out.append("} WEB_ASSET_TYPE;")
+    out.append("")
+    out.append("static const WEB_ASSET_TYPE web_assets[] = {")
+    out.extend(table)
+    out.append("};")
+    out.append("// clang-format on")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    urls.append("")
+    urls.append("#endif")
+    urls.append("")
+
+    write_if_changed(DATA_OUTPUT, "\n".join(out))
+    write_if_changed(URLS_OUTPUT, "\n".join(urls))
+
+
+main()
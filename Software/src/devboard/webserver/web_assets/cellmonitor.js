@@ -0,0 +1,75 @@
+function home() {
+  window.location.href = '/';
+}
+
+// Arduino-style map() function
+function map(value, fromLow, fromHigh, toLow, toHigh) {
+  return (value - fromLow) * (toHigh - toLow) / (fromHigh - fromLow) + toLow;
+}
+
+// Draw cells, bars and the statistics header for one battery.
+// suffix selects the element set, '' for the first battery and '2' for the second one.
+// stats holds min, max and mean in mV, stddev in mV and the number of outliers, as computed by the emulator.
+function showCells(data, suffix, stats) {
+  const voltVal = document.getElementById('voltageValues' + suffix);
+  if (data.length == 0) {
+    voltVal.textContent = 'Cell information not yet fetched, or information not available';
+    return;
+  }
+  const graphContainer = document.getElementById('graph' + suffix);
+  const valueDisplay = document.getElementById('valueDisplay' + suffix);
+  const cellContainer = document.getElementById('cellContainer' + suffix);
+  const min_mv = stats.min;
+  const max_mv = stats.max;
+  const min_index = data.indexOf(min_mv);
+  const max_index = data.indexOf(max_mv);
+
+  // Cell population. For each value, add a cell block with its value
+  data.forEach((mV, index) => {
+    const cell = document.createElement('div');
+    cell.className = 'cell';
+    cell.id = `cellIndex${suffix}${index}`;
+    let cellContent = `Cell ${index + 1}<br>${mV} mV`;
+    if (mV < 3000) {
+      cellContent = `<span class='low-voltage'>${cellContent}</span>`;
+    }
+    cell.innerHTML = cellContent;
+    cellContainer.appendChild(cell);
+  });
+
+  // Bars. Get the mV, scale the height and add a bar div to its container
+  data.forEach((mV, index) => {
+    const bar = document.createElement('div');
+    const cell = document.getElementById(`cellIndex${suffix}${index}`);
+    bar.className = 'bar';
+    bar.id = `barIndex${suffix}${index}`;
+    bar.style.height = `${map(mV, min_mv - 20, max_mv + 20, 20, 200)}px`;
+    bar.style.width = `${750 / data.length}px`;
+
+    // Mark cell and bar with highest/lowest values
+    if ((index == min_index) || (index == max_index)) {
+      cell.style.borderColor = 'red';
+      bar.style.borderColor = 'red';
+    }
+
+    const highlight = () => {
+      valueDisplay.textContent = `Value: ${mV}`;
+      bar.style.backgroundColor = `lightblue`;
+      cell.style.backgroundColor = `blue`;
+    };
+    const unhighlight = () => {
+      valueDisplay.textContent = 'Value: ...';
+      bar.style.backgroundColor = `blue`;
+      cell.style.removeProperty('background-color');
+    };
+    bar.addEventListener('mouseenter', highlight);
+    bar.addEventListener('mouseleave', unhighlight);
+    cell.addEventListener('mouseenter', highlight);
+    cell.addEventListener('mouseleave', unhighlight);
+
+    graphContainer.appendChild(bar);
+  });
+
+  voltVal.innerHTML = `Max Voltage : ${max_mv} mV<br>Min Voltage: ${min_mv} mV<br>Voltage Deviation: ${max_mv - min_mv} mV` +
+    `<br>Mean Voltage: ${stats.mean} mV<br>Standard Deviation: ${stats.stddev} mV<br>Outliers: ${stats.outliers}`;
+}
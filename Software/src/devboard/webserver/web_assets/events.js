@@ -0,0 +1,18 @@
+// Each .sec-ago cell holds "<millis rollovers>;<ms since event>", shown as a local date and time
+function showEvent() {
+  document.querySelectorAll(".event").forEach(function (e) {
+    var n = e.querySelector(".sec-ago");
+    n && (n.innerText = new Date(Date.now() - (+n.innerText.split(";")[0] * 4294967296 + +n.innerText.split(";")[1])).toLocaleString());
+  });
+}
+function askClear() {
+  if (window.confirm('Are you sure you want to clear all events?')) {
+    window.location.href = '/clearevents';
+  }
+}
+function home() {
+  window.location.href = "/";
+}
+window.onload = function () {
+  showEvent();
+};
@@ -0,0 +1,36 @@
+function OTA() { window.location.href = '/update'; }
+function Cellmon() { window.location.href = '/cellmonitor'; }
+function Settings() { window.location.href = '/settings'; }
+function Advanced() { window.location.href = '/advanced'; }
+function CANlog() { window.location.href = '/canlog'; }
+function CANreplay() { window.location.href = '/canreplay'; }
+function Log() { window.location.href = '/log'; }
+function Events() { window.location.href = '/events'; }
+function askReboot() {
+  if (window.confirm('Are you sure you want to reboot the emulator? NOTE: If emulator is handling contactors, they will open during reboot!')) {
+    reboot();
+  }
+}
+function reboot() {
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', '/reboot', true);
+  xhr.send();
+}
+function logout() {
+  var xhr = new XMLHttpRequest();
+  xhr.open('GET', '/logout', true);
+  xhr.send();
+  setTimeout(function () { window.open("/", "_self"); }, 1000);
+}
+function PauseBattery(pause) {
+  var xhr = new XMLHttpRequest();
+  xhr.onload = function () { window.location.reload(); };
+  xhr.open('GET', '/pause?p=' + pause, true);
+  xhr.send();
+}
+function estop(stop) {
+  var xhr = new XMLHttpRequest();
+  xhr.onload = function () { window.location.reload(); };
+  xhr.open('GET', '/equipmentStop?stop=' + stop, true);
+  xhr.send();
+}
@@ -0,0 +1,165 @@
+// Generated by web_assets/build_web_assets.py, do not edit. Edit the files in web_assets/ instead.
+#ifndef WEB_ASSETS_GZ_H
+#define WEB_ASSETS_GZ_H
+
+#include <Arduino.h>
+
+// clang-format off
+
+// cellmonitor.css: 629 bytes source, 503 minified, 300 gzipped
+const uint8_t CELLMONITOR_CSS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x75,0x91,0xd1,0x6e,0xc3,0x20,0x0c,0x45,0x7f,0xa5,
+  0x52,0xd5,0xb7,0x12,0xb5,0xd5,0x1e,0x26,0x78,0xdd,0x8f,0x10,0x70,0x12,0xaf,0x2e,0x46,0xe0,0x34,0xa9,
+  0xa2,0xfc,0xfb,0x48,0xd2,0x49,0xab,0xb6,0xbd,0x80,0xb0,0xb0,0xcf,0xbd,0xd7,0x95,0xe3,0x20,0x16,0x03,
+  0xa4,0xc9,0x63,0x8e,0x64,0x1f,0xba,0x21,0x18,0xcd,0x72,0xa8,0x21,0xd9,0xa8,0x97,0xc3,0x7c,0xf6,0x59,
+  0xb0,0x79,0xa8,0xe5,0x37,0x04,0xd1,0x39,0x5a,0x07,0xca,0x26,0xee,0x83,0x9f,0x2b,0x07,0x44,0xd3,0x80,
+  0x5e,0x3a,0xfd,0xf6,0x7e,0x30,0x37,0x9b,0x5a,0x0c,0xfa,0x7c,0x30,0xd1,0x7a,0x8f,0xa1,0xd5,0xe7,0x53,
+  0x1c,0x4d,0xcd,0xc9,0x43,0xd2,0xe7,0x38,0xee,0x32,0x13,0xfa,0xdd,0xd0,0xa1,0x80,0x11,0x18,0x45,0x59,
+  0xc2,0x36,0x68,0x57,0x46,0x43,0x9a,0x2b,0xe2,0x41,0xdd,0x99,0xc4,0xb6,0x30,0x39,0x26,0x4e,0x3a,0x41,
+  0xc1,0x3c,0x4b,0xea,0x6e,0xa9,0x87,0x3c,0x6d,0x18,0x55,0xb3,0x08,0xdf,0x56,0xc4,0xbc,0x6f,0x8b,0xd8,
+  0xee,0xb8,0x5d,0x97,0x57,0x47,0x2b,0x42,0x15,0xe2,0x2d,0xaf,0x05,0x05,0xc1,0x9b,0x0e,0xb0,0xed,0x44,
+  0x5f,0x4e,0x7f,0x0a,0xdc,0x3b,0xe7,0x4c,0xe4,0x8c,0x82,0x1c,0x8a,0x06,0xb2,0x82,0x77,0x98,0xab,0xda,
+  0xa6,0x27,0x5d,0x9f,0x76,0x6b,0xa7,0x75,0xd7,0x76,0x0d,0x43,0x6d,0x7a,0xeb,0xa2,0xd0,0x7c,0xe3,0x31,
+  0x50,0x09,0x58,0xd5,0xc4,0xee,0xfa,0x7b,0x9c,0x71,0x7d,0xca,0xa5,0x25,0x32,0x2e,0xee,0xff,0x89,0x69,
+  0xde,0xaf,0xae,0x3f,0xb6,0x91,0xc7,0x97,0xd7,0x65,0xfa,0x91,0x21,0x41,0x23,0xa6,0x29,0x6b,0x52,0xc3,
+  0xe6,0xad,0x66,0xf2,0xcf,0x95,0x28,0xe1,0xb8,0x05,0xf5,0x05,0xc9,0x5d,0x8d,0x31,0xf7,0x01,0x00,0x00,
+};
+
+// cellmonitor.js: 3000 bytes source, 2301 minified, 873 gzipped
+const uint8_t CELLMONITOR_JS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x95,0x55,0x4d,0x6f,0xdb,0x38,0x10,0xbd,0xfb,0x57,
+  0xcc,0x21,0x80,0xa4,0xc6,0x51,0xbc,0x2d,0x8a,0x05,0xd6,0x71,0x0e,0x9b,0x06,0x68,0x81,0xa4,0x5d,0x60,
+  0x0b,0x5f,0x57,0xb4,0x38,0xb2,0x88,0xa5,0x48,0x83,0xa2,0x65,0x1b,0xa9,0xfe,0x7b,0x87,0xa4,0x14,0x4b,
+  0x89,0xd7,0x9b,0x1e,0x0c,0x4b,0x33,0x8f,0x6f,0xbe,0x1e,0x47,0xc5,0x56,0xe5,0x56,0x68,0x05,0xa5,0xae,
+  0x30,0x4e,0xe0,0x69,0xb2,0x13,0x8a,0xeb,0x5d,0x2a,0x75,0xce,0x9c,0x23,0x2d,0x0d,0x16,0xb0,0x80,0xe8,
+  0x3a,0x9a,0x4f,0xda,0x49,0xd1,0xe3,0x2b,0xb6,0x89,0x1b,0x26,0xb7,0x38,0x85,0xc2,0xe8,0xea,0x41,0xef,
+  0xc2,0xc3,0x67,0xb1,0x2e,0xa7,0x60,0xb5,0x37,0x58,0xed,0x5e,0x1d,0xab,0x41,0xbb,0x35,0x0a,0xc2,0x11,
+  0xb8,0xea,0xcf,0x24,0xf0,0x0e,0xe2,0x80,0x22,0xa3,0x3f,0x95,0xc0,0x35,0xc4,0x3d,0xd3,0x10,0x79,0x19,
+  0xfc,0xa3,0x2c,0xea,0x52,0xef,0xee,0x50,0xca,0x3a,0xe6,0xcc,0xb2,0x29,0xd4,0xdb,0xa2,0x10,0x7b,0xfa,
+  0xb7,0xcc,0xd6,0x2e,0x6e,0xae,0x55,0x6d,0xa1,0xd1,0xd2,0x2e,0x99,0xa4,0x32,0xb8,0xce,0xb7,0x15,0x2a,
+  0x9b,0xae,0xd1,0xde,0x4b,0x74,0x8f,0x7f,0x1e,0xbe,0xf0,0x38,0x72,0x10,0xb6,0xc6,0xa5,0xcb,0xaf,0x8e,
+  0x28,0x58,0xa0,0x4a,0xe6,0x13,0x51,0x80,0x67,0x4f,0x25,0xaa,0xb5,0x2d,0x61,0xb1,0x80,0x99,0xa3,0xee,
+  0x48,0x53,0x8b,0x7b,0x7b,0xa7,0x95,0x25,0x2a,0xd7,0x27,0x97,0x0e,0x08,0x55,0x68,0x53,0xf9,0x06,0x82,
+  0xd2,0x16,0x0e,0x68,0xa1,0x40,0x9b,0x97,0xc8,0xa7,0xa0,0xcd,0x2b,0x3f,0x6b,0x98,0x90,0x6c,0x25,0x91,
+  0x9a,0x1c,0x5a,0xe5,0xca,0x0c,0xc9,0xaf,0x0d,0xdb,0x94,0x2e,0x00,0x13,0x0a,0xcd,0xb9,0x1a,0x3c,0x72,
+  0x94,0x7b,0x57,0xbe,0x2b,0xea,0x93,0xa8,0x37,0x92,0x1d,0xce,0xf6,0x60,0x80,0x3b,0x41,0x93,0x53,0x65,
+  0x6f,0xca,0x63,0x04,0x3c,0x41,0x54,0x09,0xf5,0x4f,0xd5,0x10,0x83,0x1f,0x53,0x4a,0xaf,0xcf,0x1e,0xb6,
+  0x1f,0x79,0xd8,0x7e,0x78,0x86,0x94,0x89,0x7b,0x17,0xd8,0x4d,0xc3,0xbf,0x7c,0x2b,0xe2,0x40,0x96,0x0c,
+  0x19,0x4e,0xe3,0x3c,0x35,0xe1,0xbc,0x95,0xda,0x7f,0xcf,0xf2,0x32,0x8e,0xab,0xe5,0x14,0x3c,0x24,0x81,
+  0xc5,0xed,0xb3,0x60,0x5c,0x05,0xc3,0x0a,0x73,0x83,0xcc,0x62,0x57,0x64,0x1c,0x71,0xd1,0x44,0x2e,0x22,
+  0xa1,0xd2,0x5c,0xb2,0xba,0xfe,0xca,0x2a,0x74,0xc3,0x77,0x96,0xa8,0x73,0x08,0x4e,0x96,0xcc,0x3d,0x7e,
+  0x71,0xfc,0x17,0x4f,0xa1,0x0b,0xed,0xc5,0x93,0x8f,0xd7,0x66,0xf3,0x89,0xc4,0x63,0x57,0x83,0x7c,0x32,
+  0x2f,0x9f,0x0e,0x42,0x9d,0xfb,0xad,0xbd,0x59,0x99,0xdb,0x8b,0xa7,0x6a,0xd9,0x42,0xb5,0xcc,0x82,0x1a,
+  0xab,0x25,0xdc,0xc0,0x87,0xd9,0xcc,0xcb,0xf0,0xc5,0xf9,0x9b,0x7a,0xc3,0x14,0xf8,0xa4,0x16,0x91,0xd4,
+  0xbb,0xab,0x4e,0xd8,0x11,0x91,0x0c,0xa0,0xed,0xcd,0xb5,0x03,0xde,0x66,0x5e,0x67,0x3e,0x5d,0x45,0xc3,
+  0xfa,0xfc,0xfd,0xf1,0x81,0x58,0x06,0xc0,0xf9,0x64,0x34,0xcd,0x94,0x6d,0x36,0xa8,0xf8,0x5d,0x29,0x24,
+  0x8f,0x9d,0x87,0xda,0xd0,0xbe,0xb1,0xa9,0x2b,0x66,0xde,0xd0,0xd3,0x93,0xfd,0x7f,0xa1,0xb0,0x73,0x5d,
+  0x25,0x0e,0x0a,0x34,0x1e,0x0b,0x19,0xa2,0x60,0x0e,0x43,0xa1,0xa7,0xff,0x9c,0x89,0x43,0xd5,0xf6,0x20,
+  0x31,0x2d,0x91,0x36,0x90,0x6f,0x2a,0xf5,0x9f,0xd6,0x9d,0xab,0xaa,0x93,0xee,0x15,0xbc,0x9f,0x4d,0x7b,
+  0xb5,0x5e,0xfa,0x97,0xf0,0x9b,0x25,0xed,0x66,0x3f,0x62,0xd9,0x09,0xee,0x96,0x86,0x23,0xf9,0xfd,0xe3,
+  0x8c,0x96,0xdb,0x60,0x97,0x04,0xac,0x1b,0x69,0xdc,0x69,0x76,0x71,0x14,0x7a,0x02,0x3f,0x7e,0xc0,0xc0,
+  0xde,0x0b,0x3b,0xe9,0xa7,0xde,0x05,0x58,0x69,0xc3,0xd1,0xdc,0x69,0xa9,0x5d,0x7b,0x23,0x83,0x3c,0x1a,
+  0xc6,0x3f,0xe9,0xee,0x77,0x4b,0x49,0x15,0xca,0xae,0xca,0xb8,0x1b,0xd6,0x70,0x0b,0xbc,0x58,0x6e,0x99,
+  0x5f,0x8f,0x7f,0x80,0xd7,0xe3,0xa8,0xca,0x15,0xcb,0xff,0x5d,0x1b,0xbd,0x25,0x69,0x74,0x91,0x32,0xcf,
+  0xbb,0x22,0x7c,0x36,0x1f,0xa5,0xfb,0x1a,0xd9,0x81,0xda,0x7e,0xfa,0x5b,0xf5,0x8b,0x79,0x45,0x5d,0x5e,
+  0x69,0x9a,0x46,0xff,0x93,0xd5,0xeb,0x84,0x0c,0x56,0xba,0xc1,0xbf,0x8c,0xde,0xa0,0xb1,0x87,0x38,0x3a,
+  0x1e,0xba,0xca,0xdd,0x29,0xa7,0xca,0x36,0xb0,0x32,0xce,0xef,0x1b,0x0a,0xf9,0x20,0x6a,0x8a,0x8c,0x26,
+  0x8e,0x2a,0xbd,0xad,0x91,0x2c,0xb4,0xe7,0xa6,0xc7,0x6e,0x26,0x67,0xe1,0x12,0x59,0x83,0x04,0x1f,0x94,
+  0xd9,0x2f,0x93,0x5f,0x08,0x70,0x0e,0x7f,0x3a,0xc2,0xf8,0x43,0x32,0xba,0xc9,0x94,0x6d,0x77,0x91,0xfb,
+  0xaf,0xda,0x70,0x1d,0x64,0x8f,0x6c,0x0f,0xcb,0xb0,0x47,0xc0,0x4f,0xdf,0x0b,0xdf,0x6d,0x24,0xb7,0x9d,
+  0x1e,0x85,0xea,0xbd,0xde,0xe9,0xaf,0x48,0xef,0xec,0x8f,0x7d,0xc2,0x46,0xf8,0xef,0xdd,0xf1,0x3c,0xdd,
+  0xa2,0x23,0x36,0x83,0xcb,0x49,0xe6,0xd9,0x90,0x8d,0xe8,0xba,0x2f,0x01,0x59,0x7b,0xca,0xbf,0x2d,0x53,
+  0x9c,0x19,0x3e,0xe6,0x0c,0xb8,0xda,0x72,0x8e,0xcf,0xc1,0xbf,0x6d,0xad,0x14,0x68,0xea,0xa3,0x5f,0x77,
+  0x16,0xa7,0xde,0xf6,0x27,0xeb,0x7c,0xf5,0x46,0xfd,0x08,0x00,0x00,
+};
+
+// common.css: 315 bytes source, 205 minified, 153 gzipped
+const uint8_t COMMON_CSS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x8e,0xc1,0x0a,0xc2,0x30,0x10,0x44,0x7f,0x45,
+  0xf0,0x1c,0xa8,0xd5,0x28,0x24,0xa7,0x1e,0xfc,0x90,0x24,0x1b,0xd2,0x60,0xbb,0x1b,0xb6,0x49,0x55,0xa4,
+  0xff,0x6e,0xa8,0x3d,0x08,0x7a,0x19,0x96,0x61,0xde,0xce,0x58,0x82,0xe7,0xcb,0x1a,0x77,0x0b,0x4c,0x05,
+  0x41,0x38,0x1a,0x88,0x95,0x1d,0xaa,0xa3,0x3f,0xf7,0xbd,0x8f,0xd9,0x2f,0xb6,0xe4,0x4c,0xf8,0x9b,0xdc,
+  0xcb,0x46,0x5e,0xcf,0x97,0xef,0xac,0xb6,0xc4,0xe0,0x59,0x21,0xa1,0xd7,0xc9,0x00,0x44,0x0c,0xea,0xd0,
+  0xa4,0xc7,0xae,0xad,0xa2,0x47,0xc3,0x21,0xa2,0xb0,0x54,0x1f,0x8e,0x6a,0xb5,0x5c,0xe1,0xa9,0xd2,0x89,
+  0x22,0x66,0xcf,0x1b,0x2f,0xd8,0x40,0x2c,0xd3,0x4a,0x6e,0xf5,0xaa,0xa7,0xd9,0xf3,0x9f,0x11,0xc7,0xee,
+  0xd4,0xc9,0x76,0x79,0x03,0xee,0xfc,0x2a,0x62,0xcd,0x00,0x00,0x00,
+};
+
+// events.css: 351 bytes source, 281 minified, 191 gzipped
+const uint8_t EVENTS_CSS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x6d,0x8e,0xcb,0x0a,0x83,0x30,0x10,0x45,0x7f,0x45,
+  0x90,0x42,0xbb,0x88,0x68,0xab,0x05,0x27,0xd0,0x7f,0x89,0x4e,0xd4,0xc1,0x98,0x84,0xf8,0x2c,0xe2,0xbf,
+  0xd7,0x88,0xbb,0xba,0xb9,0x70,0x87,0x73,0x0f,0x13,0xc9,0x49,0xea,0x81,0x29,0x53,0xaf,0x48,0xbd,0x55,
+  0xe2,0x0b,0x95,0x92,0x0b,0xf7,0xc1,0x90,0x9c,0x2c,0x07,0x32,0x1a,0x4a,0xa3,0xc6,0x4e,0x6f,0xd1,0x41,
+  0x5f,0x90,0xb3,0x13,0x16,0x7c,0xf0,0xc2,0x38,0x94,0x0e,0x12,0xbb,0x04,0xbd,0x51,0x84,0x41,0x58,0x55,
+  0x15,0xb7,0x02,0x91,0x74,0x0d,0x49,0x6c,0x97,0xd3,0xf2,0x41,0x9a,0x56,0x3f,0x86,0x84,0x77,0xa4,0xd9,
+  0x4c,0x38,0x34,0x3b,0xb0,0x13,0xbc,0x13,0xcb,0xd9,0xf3,0xf8,0xc6,0xe7,0x5d,0xc9,0x0a,0x27,0x45,0x0b,
+  0x47,0x32,0x7f,0x38,0x2d,0xa0,0x87,0x86,0x95,0x0d,0x29,0xbc,0xfb,0xfe,0x58,0x0b,0x51,0xb6,0xb5,0x33,
+  0xa3,0x46,0xb6,0x3f,0x6d,0x1c,0x84,0x69,0x96,0x89,0x77,0xfa,0xcf,0x1b,0xc4,0x2b,0xfc,0x95,0xa7,0x45,
+  0xf6,0xdc,0x7e,0x22,0x53,0xce,0x0c,0x19,0x01,0x00,0x00,
+};
+
+// events.js: 607 bytes source, 484 minified, 302 gzipped
+const uint8_t EVENTS_JS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0x7d,0x91,0xc1,0x4e,0x02,0x31,0x10,0x86,0xef,0x3c,
+  0xc5,0xa4,0x07,0xb6,0x95,0x50,0x94,0x10,0xcc,0x86,0x18,0x43,0x94,0x9b,0x37,0xbc,0x19,0x0e,0x4d,0x99,
+  0x65,0x1b,0xcb,0x8c,0x76,0xbb,0xac,0xc4,0xf8,0xee,0xb6,0x88,0x82,0x07,0x3d,0xb4,0xe9,0xb4,0xff,0x37,
+  0xf3,0x77,0xa6,0x6a,0xc9,0x46,0xc7,0x04,0x4d,0xcd,0xdd,0x62,0x87,0x14,0xa5,0x82,0xf7,0xde,0x9a,0x6d,
+  0xbb,0x4d,0x81,0x7e,0x6d,0x31,0xec,0x97,0xe8,0xd1,0x46,0x0e,0x73,0xef,0xa5,0xd0,0x98,0x55,0x42,0xe9,
+  0x8a,0xc3,0xc2,0xd8,0x5a,0x56,0xdf,0x29,0x24,0x66,0x74,0x67,0x02,0x10,0xdc,0x00,0xfe,0x66,0x13,0xd8,
+  0xa0,0x1d,0x9a,0x0d,0x0b,0x35,0xeb,0x11,0xf4,0xfb,0x20,0x49,0x3b,0x22,0x0c,0x8f,0xf8,0x16,0x13,0x40,
+  0xd8,0xc1,0xbd,0x89,0x28,0xf3,0xa6,0x89,0xbb,0xe4,0x64,0x08,0x72,0x70,0xa6,0xd2,0xcd,0x8b,0x77,0x51,
+  0x8a,0x99,0x50,0x4f,0x97,0x2b,0xb8,0x80,0xc9,0xb8,0x9c,0x94,0xd3,0xeb,0x71,0x39,0x85,0x01,0xfc,0xa5,
+  0xbc,0x5a,0x29,0xa5,0x23,0x3f,0xb0,0x35,0x1e,0x97,0x31,0x38,0xda,0x48,0x95,0x4c,0x7c,0xe4,0xd5,0xfb,
+  0xb1,0x6f,0x9a,0xe7,0x3b,0x8f,0x26,0x1c,0x1a,0xe0,0x2a,0x90,0x9d,0xa3,0x35,0x77,0xda,0x32,0x55,0x2e,
+  0x6c,0x65,0x31,0x0f,0x08,0x7b,0x6e,0xa1,0x69,0x8f,0x87,0xce,0x50,0x84,0xc8,0x60,0x33,0x06,0xc6,0x7b,
+  0x38,0xf4,0xa6,0xb9,0x2d,0x54,0xce,0x71,0xe4,0x7d,0xaa,0x9b,0x0b,0xe8,0x3a,0x60,0x95,0xfe,0x59,0x8c,
+  0x0e,0xfa,0x2f,0x69,0x91,0x2d,0x9c,0x99,0xa8,0x79,0x8b,0xf2,0x1f,0x58,0x8c,0x44,0x26,0x8e,0xaf,0x4c,
+  0x9e,0xcd,0x3a,0x5d,0x9f,0x66,0x90,0xd9,0xb3,0x59,0x26,0xf1,0xec,0x13,0x66,0xe1,0x83,0x38,0xe4,0x01,
+  0x00,0x00,
+};
+
+// index.js: 1295 bytes source, 1256 minified, 434 gzipped
+const uint8_t INDEX_JS_GZ[] PROGMEM = {
+  0x1f,0x8b,0x08,0x00,0x00,0x00,0x00,0x00,0x02,0x03,0xbd,0x92,0x4d,0x4f,0x83,0x40,0x10,0x86,0xef,0xfd,
+  0x15,0x63,0x2f,0xd0,0xd8,0xd4,0x7a,0xb5,0x69,0x9a,0x6a,0x1a,0x35,0xf1,0x2b,0x95,0x83,0x37,0xb3,0xc2,
+  0x60,0x37,0x2e,0xbb,0xb8,0x1f,0xc5,0xc6,0xf8,0xdf,0x9d,0x05,0x44,0xd1,0xa6,0x18,0x0f,0x5e,0xc8,0xb0,
+  0xbc,0xcf,0xbc,0x2f,0x33,0x9b,0x3a,0x19,0x5b,0xae,0x24,0x5c,0x47,0xf3,0x70,0x00,0xaf,0x50,0x70,0x99,
+  0xa8,0x62,0x24,0x54,0xcc,0xfc,0xf9,0x68,0xa5,0x31,0x85,0x29,0x04,0x07,0x2e,0x4f,0x98,0xc5,0x60,0x02,
+  0x6f,0xbd,0xf4,0x03,0x3a,0x41,0x21,0x32,0x25,0x77,0x83,0x71,0x25,0xe2,0x56,0xe9,0x36,0x7d,0x8b,0xd6,
+  0x72,0xf9,0x68,0x76,0xe3,0xa6,0x56,0xb5,0xd9,0x79,0xb2,0x66,0x32,0xc6,0x64,0x37,0xcb,0x6a,0xd5,0xb7,
+  0xd4,0xf3,0x2b,0xa1,0x1e,0x3b,0x42,0x33,0x49,0x9a,0x1f,0x9c,0xc6,0x5c,0xb0,0x4d,0x27,0x5a,0xc9,0xda,
+  0xf4,0x45,0x97,0xe5,0x0f,0xbf,0xc5,0x1a,0xa5,0xed,0x98,0x0e,0x96,0x9a,0x36,0xc7,0xcc,0xd3,0x12,0x1f,
+  0x94,0xb2,0x1e,0xed,0xf1,0x14,0xc2,0x1a,0x8f,0x95,0x4c,0xb9,0xce,0xc2,0x60,0xae,0x11,0x36,0xca,0x81,
+  0x71,0x75,0x51,0x30,0x69,0xc1,0x2a,0xd0,0x25,0x07,0x76,0x85,0x80,0x99,0x13,0x8c,0x76,0x36,0x83,0xab,
+  0xeb,0x68,0x71,0x04,0xe7,0x69,0x73,0x04,0xdc,0xc0,0x8a,0xc9,0x44,0xd0,0x5e,0x80,0x9a,0x5a,0x16,0xd3,
+  0xa9,0x19,0x7a,0x6e,0x43,0x59,0x85,0x00,0x95,0xa3,0x84,0xc4,0x69,0xaf,0xa8,0x9a,0xee,0x05,0x03,0x1f,
+  0x47,0xd7,0xc9,0x26,0xbd,0xb7,0xde,0x97,0xcc,0xfa,0x33,0xf0,0x9a,0x69,0x78,0x59,0x69,0xfa,0x3d,0x89,
+  0x05,0xdc,0x5d,0x5e,0x9c,0x59,0x9b,0x2f,0xf1,0xd9,0xa1,0x29,0x39,0xfa,0x36,0xf2,0xed,0xc3,0xe0,0x74,
+  0x11,0x05,0x43,0x1a,0x42,0x05,0x53,0x69,0xb5,0xc3,0x5a,0x61,0x50,0x26,0x95,0x4b,0xe3,0x41,0x03,0x56,
+  0xee,0xaf,0x1e,0x15,0xbc,0xdd,0x83,0xae,0x68,0xc4,0x33,0xf4,0xcd,0x1b,0xb3,0xaf,0x6b,0x2b,0x3b,0xf5,
+  0x0f,0xfa,0x43,0xe8,0xdf,0x1b,0x14,0x69,0x7f,0x40,0xfb,0x1a,0xc2,0xe1,0x78,0x3c,0x6e,0x27,0xbc,0x61,
+  0xce,0xe0,0x31,0xb3,0x16,0xf5,0x26,0xcc,0xfd,0xcb,0xaf,0xc3,0xd2,0x75,0x65,0x09,0x49,0xb6,0x06,0x68,
+  0xee,0x8d,0x46,0x2f,0x0b,0xbd,0xff,0xb6,0x9f,0x2c,0x2d,0x67,0xf9,0x34,0x80,0x7d,0x28,0xeb,0xae,0x91,
+  0x52,0x02,0x95,0x87,0xfe,0xf1,0xbf,0x41,0xa9,0x27,0xcf,0x33,0xba,0xfa,0xb7,0x64,0x3d,0xf3,0xfe,0x65,
+  0x66,0x5f,0x6c,0x8f,0xfc,0x0e,0x20,0xe2,0x42,0x10,0xe8,0x04,0x00,0x00,
+};
+
+typedef struct {
+  const char* path;
+  const char* content_type;
+  const uint8_t* data;
+  size_t length;
+} WEB_ASSET_TYPE;
+
+static const WEB_ASSET_TYPE web_assets[] = {
+  {"/static/cellmonitor.css", "text/css", CELLMONITOR_CSS_GZ, sizeof(CELLMONITOR_CSS_GZ)},
+  {"/static/cellmonitor.js", "application/javascript", CELLMONITOR_JS_GZ, sizeof(CELLMONITOR_JS_GZ)},
+  {"/static/common.css", "text/css", COMMON_CSS_GZ, sizeof(COMMON_CSS_GZ)},
+  {"/static/events.css", "text/css", EVENTS_CSS_GZ, sizeof(EVENTS_CSS_GZ)},
+  {"/static/events.js", "application/javascript", EVENTS_JS_GZ, sizeof(EVENTS_JS_GZ)},
+  {"/static/index.js", "application/javascript", INDEX_JS_GZ, sizeof(INDEX_JS_GZ)},
+};
+// clang-format on
+
+#endif
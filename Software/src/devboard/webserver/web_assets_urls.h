@@ -0,0 +1,13 @@
+// Generated by web_assets/build_web_assets.py, do not edit. Edit the files in web_assets/ instead.
+#ifndef WEB_ASSETS_URLS_H
+#define WEB_ASSETS_URLS_H
+
+// The ?v= part is a content hash, so browsers may cache these URLs forever
+#define WEB_ASSET_CELLMONITOR_CSS_URL "/static/cellmonitor.css?v=68890339"
+#define WEB_ASSET_CELLMONITOR_JS_URL "/static/cellmonitor.js?v=b91add03"
+#define WEB_ASSET_COMMON_CSS_URL "/static/common.css?v=5846731b"
+#define WEB_ASSET_EVENTS_CSS_URL "/static/events.css?v=ab67b05d"
+#define WEB_ASSET_EVENTS_JS_URL "/static/events.js?v=8745861b"
+#define WEB_ASSET_INDEX_JS_URL "/static/index.js?v=afe58884"
+
+#endif
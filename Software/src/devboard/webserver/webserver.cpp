@@ -17,14 +17,20 @@ AsyncWebServer server(80);
 // Measure OTA progress
 unsigned long ota_progress_millis = 0;
 
+#include "advanced_battery_fields.h"
 #include "advanced_battery_html.h"
 #include "can_logging_html.h"
 #include "can_replay_html.h"
+#include "cell_history_api.h"
 #include "cellmonitor_html.h"
 #include "debug_logging_html.h"
 #include "events_html.h"
 #include "index_html.h"
+#include "metrics_api.h"
+#include "page_cache.h"
+#include "perf_api.h"
 #include "settings_html.h"
+#include "web_assets.h"
 
 MyTimer ota_timeout_timer = MyTimer(15000);
 bool ota_active = false;
@@ -149,8 +155,163 @@ void canReplayTask(void* param) {
   vTaskDelete(NULL);
 }
 
+typedef struct {
+  const char* name;
+  float min_value;
+  float max_value;
+  void (*apply)(DATALAYER_BATTERY_TYPE& battery, float value);
+} SETTINGS_BATCH_ENTRY_TYPE;
+
+// Settings accepted by /updateSettings. Ranges match the limits enforced on the settings page
+// clang-format off
+static const SETTINGS_BATCH_ENTRY_TYPE settings_batch_entries[] = {
+    {"BATTERY_WH_MAX", 1, 120000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.info.total_capacity_Wh = static_cast<uint32_t>(v); }},
+    {"USE_SCALED_SOC", 0, 1, [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.soc_scaling_active = v != 0; }},
+    {"SOC_MAX", 50, 100,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.max_percentage = static_cast<uint16_t>(v * 100); }},
+    {"SOC_MIN", -10, 50,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.min_percentage = static_cast<int16_t>(v * 100); }},
+    {"MAX_CHARGE_A", 0, 1000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.max_user_set_charge_dA = static_cast<uint16_t>(v * 10); }},
+    {"MAX_DISCHARGE_A", 0, 1000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.max_user_set_discharge_dA = static_cast<uint16_t>(v * 10);
+     }},
+    {"USE_VOLTAGE_LIMITS", 0, 1,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.user_set_voltage_limits_active = v != 0; }},
+    {"MAX_CHARGE_VOLTAGE", 0, 1000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.max_user_set_charge_voltage_dV = static_cast<uint16_t>(v * 10);
+     }},
+    {"MAX_DISCHARGE_VOLTAGE", 0, 1000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.max_user_set_discharge_voltage_dV = static_cast<uint16_t>(v * 10);
+     }},
+#ifdef TESLA_MODEL_3Y_BATTERY
+    {"BAL_ACTIVE", 0, 1, [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.user_requests_balancing = v != 0; }},
+    {"BAL_TIME", 1, 300,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.balancing_time_ms = static_cast<uint32_t>(v * 60000); }},
+    {"BAL_FLOAT_POWER", 100, 2000,
+     [](DATALAYER_BATTERY_TYPE& b, float v) { b.settings.balancing_float_power_W = static_cast<uint16_t>(v); }},
+    {"BAL_MAX_PACK_V", 380, 410,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.balancing_max_pack_voltage_dV = static_cast<uint16_t>(v * 10);
+     }},
+    {"BAL_MAX_CELL_V", 3400, 3750,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.balancing_max_cell_voltage_mV = static_cast<uint16_t>(v);
+     }},
+    {"BAL_MAX_DEV_CELL_V", 300, 600,
+     [](DATALAYER_BATTERY_TYPE& b, float v) {
+       b.settings.balancing_max_deviation_cell_voltage_mV = static_cast<uint16_t>(v);
+     }},
+#endif  // TESLA_MODEL_3Y_BATTERY
+};
+// clang-format on
+
+#define SETTINGS_BATCH_NOF_ENTRIES (sizeof(settings_batch_entries) / sizeof(settings_batch_entries[0]))
+
+typedef struct {
+  const SETTINGS_BATCH_ENTRY_TYPE* entry;
+  float value;
+} SETTINGS_BATCH_STAGED_TYPE;
+
+// Validates one setting and stages it. Returns false with a reason if rejected
+static bool stage_setting(SETTINGS_BATCH_STAGED_TYPE* staged, int& count, const char* name, float value,
+                          String& error) {
+  for (const auto& entry : settings_batch_entries) {
+    if (strcmp(entry.name, name) != 0) {
+      continue;
+    }
+    if (isnan(value) || value < entry.min_value || value > entry.max_value) {
+      error = String(name) + " must be between " + String(entry.min_value, 1) + " and " + String(entry.max_value, 1);
+      return false;
+    }
+    if (count >= (int)SETTINGS_BATCH_NOF_ENTRIES) {
+      error = "Too many settings";
+      return false;
+    }
+    staged[count].entry = &entry;
+    staged[count].value = value;
+    count++;
+    return true;
+  }
+  error = "Unknown setting " + String(name);
+  return false;
+}
+
+void handle_settings_batch(AsyncWebServerRequest* request) {
+  SETTINGS_BATCH_STAGED_TYPE staged[SETTINGS_BATCH_NOF_ENTRIES];
+  String error = "";
+  int count = 0;
+
+  if (request->_tempObject != NULL) {
+    JsonDocument doc;
+    if (deserializeJson(doc, (const char*)request->_tempObject) || !doc.is<JsonObject>()) {
+      error = "Invalid JSON";
+    } else {
+      for (JsonPair kv : doc.as<JsonObject>()) {
+        if (!kv.value().is<float>() && !kv.value().is<bool>()) {
+          error = String(kv.key().c_str()) + " must be a number";
+          break;
+        }
+        if (!stage_setting(staged, count, kv.key().c_str(), kv.value().as<float>(), error)) {
+          break;
+        }
+      }
+    }
+  } else {
+    for (size_t i = 0; i < request->params(); i++) {
+      const AsyncWebParameter* p = request->getParam(i);
+      if (!p->isPost() || p->isFile()) {
+        continue;
+      }
+      if (!stage_setting(staged, count, p->name().c_str(), p->value().toFloat(), error)) {
+        break;
+      }
+    }
+  }
+
+  if (error.length() == 0 && count == 0) {
+    // Bodies over SETTINGS_BATCH_MAX_BODY are not collected, so an empty batch with a large body is one of those
+    if (request->_tempObject == NULL && request->contentLength() > SETTINGS_BATCH_MAX_BODY) {
+      request->send(413, "text/plain", "Settings body too large");
+      return;
+    }
+    error = "No settings given";
+  }
+
+  // A rejected batch leaves the datalayer untouched
+  if (error.length() > 0) {
+    request->send(400, "text/plain", error);
+    return;
+  }
+
+  // Everything validated, apply all values in one go
+  for (int i = 0; i < count; i++) {
+    staged[i].entry->apply(datalayer.battery, staged[i].value);
+  }
+
+  request_store_settings();
+  request->send(200, "text/plain", "Updated " + String(count) + " settings successfully");
+}
+
 void init_webserver() {
 
+#ifdef FUNCTION_TIME_MEASUREMENT
+  // Server wide middleware, measures every route registered below as well as /api/perf itself
+  init_perf_api(server);
+#endif  // FUNCTION_TIME_MEASUREMENT
+
+  init_web_assets(server);
+
+  init_metrics_api(server);
+
+#ifdef CELL_HISTORY
+  init_cell_history_api(server);
+#endif  // CELL_HISTORY
+
   server.on("/logout", HTTP_GET, [](AsyncWebServerRequest* request) { request->send(401); });
 
   // Route for firmware info from ota update page
@@ -164,7 +325,9 @@ void init_webserver() {
   server.on("/", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
       return request->requestAuthentication();
-    request->send(200, "text/html", index_html, processor);
+    // Both counters only ever increase, so their sum changes whenever either of them does
+    send_cached_page(request, PAGE_CACHE_INDEX, datalayer.system.status.data_generation + get_event_generation(),
+                     PAGE_CACHE_MAX_AGE_MS, processor);
   });
 
   // Route for going to settings web page
@@ -179,6 +342,30 @@ void init_webserver() {
     request->send(200, "text/html", index_html, advanced_battery_processor);
   });
 
+#ifdef BATTERY_HAS_FIELD_TABLE
+  // Route for a single section of the advanced battery info, as HTML or with format=json
+  server.on("/advancedSection", HTTP_GET, [](AsyncWebServerRequest* request) {
+    const AsyncWebParameter* id = request->getParam("id");
+    if (id == nullptr || id->value().toInt() < 0 || id->value().toInt() >= battery_section_count) {
+      return request->send(400, "text/plain", "Bad Request");
+    }
+    const BATTERY_SECTION_TYPE& section = battery_sections[id->value().toInt()];
+    if (!battery_section_visible(section)) {
+      return request->send(404, "text/plain", "Section not shown");
+    }
+    const AsyncWebParameter* format = request->getParam("format");
+    if (format != nullptr && format->value() == "json") {
+      AsyncResponseStream* response = request->beginResponseStream("application/json");
+      render_battery_section_json(*response, section);
+      request->send(response);
+    } else {
+      AsyncResponseStream* response = request->beginResponseStream("text/html");
+      render_battery_section_html(*response, section);
+      request->send(response);
+    }
+  });
+#endif  // BATTERY_HAS_FIELD_TABLE
+
   // Route for going to CAN logging web page
   server.on("/canlog", HTTP_GET, [](AsyncWebServerRequest* request) {
     AsyncWebServerResponse* response = request->beginResponse(200, "text/html", can_logger_processor());
@@ -356,14 +543,16 @@ void init_webserver() {
   server.on("/cellmonitor", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
       return request->requestAuthentication();
-    request->send(200, "text/html", index_html, cellmonitor_processor);
+    // The page only shows cell voltages, a change of any other value does not need a new render
+    const uint32_t generation = datalayer.system.status.group_generation[DATALAYER_GROUP_CELL_VOLTAGES];
+    send_cached_page(request, PAGE_CACHE_CELLMONITOR, generation, 0, cellmonitor_processor);
   });
 
   // Route for going to event log web page
   server.on("/events", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
       return request->requestAuthentication();
-    request->send(200, "text/html", index_html, events_processor);
+    send_cached_page(request, PAGE_CACHE_EVENTS, get_event_generation(), PAGE_CACHE_MAX_AGE_MS, events_processor);
   });
 
   // Route for clearing all events
@@ -386,8 +575,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       if (value.length() <= 63) {  // Check if SSID is within the allowable length
-        ssid = value.c_str();
-        store_settings();
+        update_wifi_ssid(value.c_str());
         request->send(200, "text/plain", "Updated successfully");
       } else {
         request->send(400, "text/plain", "SSID must be 63 characters or less");
@@ -403,8 +591,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       if (value.length() > 8) {  // Check if password is within the allowable length
-        password = value.c_str();
-        store_settings();
+        update_wifi_password(value.c_str());
         request->send(200, "text/plain", "Updated successfully");
       } else {
         request->send(400, "text/plain", "Password must be atleast 8 characters");
@@ -421,7 +608,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.info.total_capacity_Wh = value.toInt();
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -435,7 +622,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.soc_scaling_active = value.toInt();
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -449,7 +636,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.max_percentage = static_cast<uint16_t>(value.toFloat() * 100);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -493,7 +680,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.min_percentage = static_cast<uint16_t>(value.toFloat() * 100);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -507,7 +694,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.max_user_set_charge_dA = static_cast<uint16_t>(value.toFloat() * 10);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -521,7 +708,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.max_user_set_discharge_dA = static_cast<uint16_t>(value.toFloat() * 10);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -535,7 +722,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.user_set_voltage_limits_active = value.toInt();
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -549,7 +736,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.max_user_set_charge_voltage_dV = static_cast<uint16_t>(value.toFloat() * 10);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -563,13 +750,33 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.max_user_set_discharge_voltage_dV = static_cast<uint16_t>(value.toFloat() * 10);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
     }
   });
 
+  // Route for updating several settings at once, as form fields or a flat JSON object.
+  // All values are validated before any of them is applied, and they are persisted in one NVS commit.
+  server.on(
+      "/updateSettings", HTTP_POST,
+      [](AsyncWebServerRequest* request) {
+        if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password))
+          return request->requestAuthentication();
+        handle_settings_batch(request);
+      },
+      NULL,
+      [](AsyncWebServerRequest* request, uint8_t* data, size_t len, size_t index, size_t total) {
+        // Collect a JSON body, it is parsed once complete in handle_settings_batch()
+        if (index == 0 && total > 0 && total <= SETTINGS_BATCH_MAX_BODY) {
+          request->_tempObject = calloc(total + 1, 1);
+        }
+        if (request->_tempObject != NULL && index + len <= total) {
+          memcpy((uint8_t*)request->_tempObject + index, data, len);
+        }
+      });
+
   // Route for clearing isolation faults on Tesla
   server.on("/teslaClearIsolation", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
@@ -588,6 +795,7 @@ void init_webserver() {
     request->send(200, "text/plain", "Updated successfully");
   });
 
+#ifdef RENAULT_ZOE_GEN2_BATTERY
   // Route for triggering NVROL reset on Zoe Gen2 batteries
   server.on("/triggerNVROL", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
@@ -596,7 +804,9 @@ void init_webserver() {
     datalayer_extended.zoePH2.UserRequestNVROLReset = true;
     request->send(200, "text/plain", "Updated successfully");
   });
+#endif  // RENAULT_ZOE_GEN2_BATTERY
 
+#ifdef NISSAN_LEAF_BATTERY
   // Route for resetting SOH on Nissan LEAF batteries
   server.on("/resetSOH", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
@@ -605,14 +815,19 @@ void init_webserver() {
     datalayer_extended.nissanleaf.UserRequestSOHreset = true;
     request->send(200, "text/plain", "Updated successfully");
   });
+#endif  // NISSAN_LEAF_BATTERY
 
   // Route for erasing DTC on Volvo/Polestar batteries
   server.on("/volvoEraseDTC", HTTP_GET, [](AsyncWebServerRequest* request) {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
       return request->requestAuthentication();
     }
+#ifdef VOLVO_SPA_BATTERY
     datalayer_extended.VolvoPolestar.UserRequestDTCreset = true;
+#endif
+#ifdef VOLVO_SPA_HYBRID_BATTERY
     datalayer_extended.VolvoHybrid.UserRequestDTCreset = true;
+#endif
     request->send(200, "text/plain", "Updated successfully");
   });
 
@@ -621,8 +836,12 @@ void init_webserver() {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
       return request->requestAuthentication();
     }
+#ifdef VOLVO_SPA_BATTERY
     datalayer_extended.VolvoPolestar.UserRequestDTCreadout = true;
+#endif
+#ifdef VOLVO_SPA_HYBRID_BATTERY
     datalayer_extended.VolvoHybrid.UserRequestDTCreadout = true;
+#endif
     request->send(200, "text/plain", "Updated successfully");
   });
 
@@ -631,8 +850,12 @@ void init_webserver() {
     if (WEBSERVER_AUTH_REQUIRED && !request->authenticate(http_username, http_password)) {
       return request->requestAuthentication();
     }
+#ifdef VOLVO_SPA_BATTERY
     datalayer_extended.VolvoPolestar.UserRequestBECMecuReset = true;
+#endif
+#ifdef VOLVO_SPA_HYBRID_BATTERY
     datalayer_extended.VolvoHybrid.UserRequestBECMecuReset = true;
+#endif
     request->send(200, "text/plain", "Updated successfully");
   });
 
@@ -663,7 +886,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.user_requests_balancing = value.toInt();
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -677,7 +900,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.balancing_time_ms = static_cast<uint32_t>(value.toFloat() * 60000);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -691,7 +914,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.balancing_float_power_W = static_cast<uint16_t>(value.toFloat());
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -705,7 +928,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.balancing_max_pack_voltage_dV = static_cast<uint16_t>(value.toFloat() * 10);
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -719,7 +942,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.balancing_max_cell_voltage_mV = static_cast<uint16_t>(value.toFloat());
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -733,7 +956,7 @@ void init_webserver() {
     if (request->hasParam("value")) {
       String value = request->getParam("value")->value();
       datalayer.battery.settings.balancing_max_deviation_cell_voltage_mV = static_cast<uint16_t>(value.toFloat());
-      store_settings();
+      request_store_settings();
       request->send(200, "text/plain", "Updated successfully");
     } else {
       request->send(400, "text/plain", "Bad Request");
@@ -843,6 +1066,9 @@ void init_webserver() {
       return request->requestAuthentication();
     request->send(200, "text/plain", "Rebooting server...");
 
+    // Commit any settings still waiting for the debounce time
+    store_settings();
+
     //Equipment STOP without persisting the equipment state before restart
     // Max Charge/Discharge = 0; CAN = stop; contactors = open
     setBatteryPause(true, true, true, false);
@@ -926,13 +1152,7 @@ String processor(const String& var) {
     String content = "";
     content += "<h2>" + String(ssidAP) + "</h2>";  // ssidAP name is used as header name
     //Page format
-    content += "<style>";
-    content += "body { background-color: black; color: white; }";
-    content +=
-        "button { background-color: #505E67; color: white; border: none; padding: 10px 20px; margin-bottom: 20px; "
-        "cursor: pointer; border-radius: 10px; }";
-    content += "button:hover { background-color: #3A4A52; }";
-    content += "</style>";
+    content += "<link rel='stylesheet' href='" WEB_ASSET_COMMON_CSS_URL "'>";
 
     // Start a new block with a specific background color
     content += "<div style='background-color: #303E47; padding: 10px; margin-bottom: 10px;border-radius: 50px'>";
@@ -955,6 +1175,13 @@ String processor(const String& var) {
     content +=
         "<h4>MQTT function (MQTT task) max load last 10 s: " + String(datalayer.system.status.mqtt_task_10s_max_us) +
         " us</h4>";
+#ifdef MQTT
+    content +=
+        "<h4>MQTT publish heap drop max last 10 s: " + String(datalayer.system.status.mqtt_publish_heap_10s_max) +
+        " bytes, heap fragmentation: " + String(datalayer.system.status.heap_fragmentation_pct) + " %</h4>";
+    content += "<h4>MQTT command latency last: " + String(datalayer.system.status.mqtt_command_latency_us) +
+               " us, max: " + String(datalayer.system.status.mqtt_command_latency_max_us) + " us</h4>";
+#endif  // MQTT
     content +=
         "<h4>WIFI function (MQTT task) max load last 10 s: " + String(datalayer.system.status.wifi_task_10s_max_us) +
         " us</h4>";
@@ -1508,45 +1735,7 @@ String processor(const String& var) {
           " onclick=\""
           "if(confirm('This action will restore the battery state. Are you sure?')) { estop(false); }\""
           ">Close Contactors</button><br/>";
-    content += "<script>";
-    content += "function OTA() { window.location.href = '/update'; }";
-    content += "function Cellmon() { window.location.href = '/cellmonitor'; }";
-    content += "function Settings() { window.location.href = '/settings'; }";
-    content += "function Advanced() { window.location.href = '/advanced'; }";
-    content += "function CANlog() { window.location.href = '/canlog'; }";
-    content += "function CANreplay() { window.location.href = '/canreplay'; }";
-    content += "function Log() { window.location.href = '/log'; }";
-    content += "function Events() { window.location.href = '/events'; }";
-    content +=
-        "function askReboot() { if (window.confirm('Are you sure you want to reboot the emulator? NOTE: If "
-        "emulator is handling contactors, they will open during reboot!')) { "
-        "reboot(); } }";
-    content += "function reboot() {";
-    content += "  var xhr = new XMLHttpRequest();";
-    content += "  xhr.open('GET', '/reboot', true);";
-    content += "  xhr.send();";
-    content += "}";
-    if (WEBSERVER_AUTH_REQUIRED) {
-      content += "function logout() {";
-      content += "  var xhr = new XMLHttpRequest();";
-      content += "  xhr.open('GET', '/logout', true);";
-      content += "  xhr.send();";
-      content += "  setTimeout(function(){ window.open(\"/\",\"_self\"); }, 1000);";
-      content += "}";
-    }
-    content += "function PauseBattery(pause){";
-    content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/pause?p='+pause,true);xhr.send();";
-    content += "}";
-    content += "function estop(stop){";
-    content +=
-        "var xhr=new "
-        "XMLHttpRequest();xhr.onload=function() { "
-        "window.location.reload();};xhr.open('GET','/equipmentStop?stop='+stop,true);xhr.send();";
-    content += "}";
-    content += "</script>";
+    content += "<script src='" WEB_ASSET_INDEX_JS_URL "'></script>";
 
     //Script for refreshing page
     content += "<script>";
@@ -1594,7 +1783,8 @@ void onOTAEnd(bool success) {
     //Equipment STOP without persisting the equipment state before restart
     // Max Charge/Discharge = 0; CAN = stop; contactors = open
     setBatteryPause(true, true, true, false);
-    // a reboot will be done by the OTA library. no need to do anything here
+    // Commit any settings still waiting for the debounce time, the OTA library reboots right after this
+    store_settings();
 #ifdef DEBUG_LOG
     logging.println("OTA update finished successfully!");
 #endif  // DEBUG_LOG
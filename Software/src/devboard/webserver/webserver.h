@@ -107,6 +107,19 @@ template <typename T>  // This function makes power values appear as W when unde
 String formatPowerValue(T value, String unit, int precision);
 
 extern void store_settings();
+extern void request_store_settings();
+
+// Largest JSON body accepted by /updateSettings
+#define SETTINGS_BATCH_MAX_BODY 1024
+
+/**
+ * @brief Validates and applies a batch of settings posted to /updateSettings
+ *
+ * @param[in] request
+ *
+ * @return void
+ */
+void handle_settings_batch(AsyncWebServerRequest* request);
 
 void ota_monitor();
 
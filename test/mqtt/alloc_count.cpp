@@ -0,0 +1,49 @@
+#include "alloc_count.h"
+#include <stdlib.h>
+#include <new>
+
+static uint64_t allocations = 0;
+static int paused = 0;
+
+uint64_t allocation_count(void) {
+  return allocations;
+}
+
+void pause_allocation_count(bool pause) {
+  paused += pause ? 1 : -1;
+}
+
+static void* counted_alloc(size_t size) {
+  if (paused == 0) {
+    allocations++;
+  }
+  void* pointer = malloc(size > 0 ? size : 1);
+  if (pointer == nullptr) {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+
+void* operator new(size_t size) {
+  return counted_alloc(size);
+}
+
+void* operator new[](size_t size) {
+  return counted_alloc(size);
+}
+
+void operator delete(void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+  free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept {
+  free(pointer);
+}
+
+void operator delete[](void* pointer, size_t) noexcept {
+  free(pointer);
+}
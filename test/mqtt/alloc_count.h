@@ -0,0 +1,12 @@
+#ifndef __ALLOC_COUNT_H__
+#define __ALLOC_COUNT_H__
+
+#include <stdint.h>
+
+/** Number of operator new calls since start, without the ones made while counting was paused */
+uint64_t allocation_count(void);
+
+/** Pause counting while the harness does its own bookkeeping, calls nest */
+void pause_allocation_count(bool pause);
+
+#endif  // __ALLOC_COUNT_H__
@@ -0,0 +1,226 @@
+#include "fake_broker.h"
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "alloc_count.h"
+#include "mqtt_client.h"
+
+typedef struct {
+  std::string topic;
+  std::string payload;
+  bool retain;
+} FAKE_BROKER_MESSAGE_TYPE;
+
+static esp_mqtt_client_config_t config;
+static std::string last_will_topic;
+static std::string last_will_payload;
+static esp_event_handler_t handler = nullptr;
+static void* handler_args = nullptr;
+static bool started = false;
+static bool connected = false;
+static bool verbose = false;
+static std::vector<std::string> subscriptions;
+static std::vector<FAKE_BROKER_MESSAGE_TYPE> outbox;
+static int outbox_bytes = 0;
+static int next_msg_id = 1;
+static FAKE_BROKER_COUNTERS_TYPE counters;
+static std::map<std::string, FAKE_BROKER_TOPIC_TYPE> topics;
+
+static void send_event(esp_mqtt_event_id_t event_id, esp_mqtt_event_t* event) {
+  if (handler != nullptr) {
+    handler(handler_args, "MQTT_EVENTS", event_id, event);
+  }
+}
+
+static void deliver(const std::string& topic, const std::string& payload, bool retain) {
+  FAKE_BROKER_TOPIC_TYPE& stats = topics[topic];
+  stats.messages++;
+  stats.bytes += topic.size() + payload.size();
+  stats.retained = retain;
+  stats.last_payload = payload;
+  counters.messages++;
+  counters.bytes += topic.size() + payload.size();
+  if (verbose) {
+    printf("  %s%s %s\n", topic.c_str(), retain ? " (retained)" : "", payload.c_str());
+  }
+}
+
+/** MQTT topic filter match with + and # wildcards */
+static bool topic_matches(const std::string& filter, const char* topic) {
+  size_t f = 0;
+  const char* t = topic;
+  while (f < filter.size()) {
+    if (filter[f] == '#') {
+      return true;
+    }
+    if (filter[f] == '+') {
+      while (*t != '\0' && *t != '/') {
+        t++;
+      }
+      f++;
+      continue;
+    }
+    if (*t != filter[f]) {
+      return false;
+    }
+    t++;
+    f++;
+  }
+  return *t == '\0';
+}
+
+void fake_broker_connect(void) {
+  if (!started || connected) {
+    return;
+  }
+  connected = true;
+  counters.connects++;
+  pause_allocation_count(true);
+  subscriptions.clear();  // Clean session, the client subscribes again
+  pause_allocation_count(false);
+  esp_mqtt_event_t event = {};
+  event.event_id = MQTT_EVENT_CONNECTED;
+  send_event(MQTT_EVENT_CONNECTED, &event);
+}
+
+void fake_broker_disconnect(void) {
+  if (!connected) {
+    return;
+  }
+  connected = false;
+  counters.disconnects++;
+  pause_allocation_count(true);
+  if (!last_will_topic.empty()) {
+    deliver(last_will_topic, last_will_payload, config.session.last_will.retain);
+  }
+  pause_allocation_count(false);
+  esp_mqtt_event_t event = {};
+  event.event_id = MQTT_EVENT_DISCONNECTED;
+  send_event(MQTT_EVENT_DISCONNECTED, &event);
+}
+
+bool fake_broker_connected(void) {
+  return connected;
+}
+
+void fake_broker_tick(void) {
+  if (!connected || outbox.empty()) {
+    return;
+  }
+  pause_allocation_count(true);
+  for (const FAKE_BROKER_MESSAGE_TYPE& message : outbox) {
+    deliver(message.topic, message.payload, message.retain);
+  }
+  outbox.clear();
+  outbox_bytes = 0;
+  pause_allocation_count(false);
+}
+
+void fake_broker_send(const char* topic, const char* payload) {
+  if (!connected || !fake_broker_subscribed(topic)) {
+    return;
+  }
+  // Like the real client the buffers are only valid during the event, and not null terminated
+  std::vector<char> topic_buffer(topic, topic + strlen(topic));
+  std::vector<char> data_buffer(payload, payload + strlen(payload));
+  esp_mqtt_event_t event = {};
+  event.event_id = MQTT_EVENT_DATA;
+  event.topic = topic_buffer.data();
+  event.topic_len = topic_buffer.size();
+  event.data = data_buffer.data();
+  event.data_len = data_buffer.size();
+  event.total_data_len = data_buffer.size();
+  send_event(MQTT_EVENT_DATA, &event);
+}
+
+bool fake_broker_subscribed(const char* topic) {
+  for (const std::string& filter : subscriptions) {
+    if (topic_matches(filter, topic)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+const FAKE_BROKER_COUNTERS_TYPE& fake_broker_counters(void) {
+  return counters;
+}
+
+const std::map<std::string, FAKE_BROKER_TOPIC_TYPE>& fake_broker_topics(void) {
+  return topics;
+}
+
+int fake_broker_outbox_size(void) {
+  return outbox_bytes;
+}
+
+void fake_broker_set_verbose(bool enable) {
+  verbose = enable;
+}
+
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t* client_config) {
+  config = *client_config;
+  pause_allocation_count(true);
+  if (config.session.last_will.topic != nullptr) {
+    last_will_topic = config.session.last_will.topic;
+    last_will_payload.assign(config.session.last_will.msg, config.session.last_will.msg_len);
+  }
+  pause_allocation_count(false);
+  // The string pointers in the config are not guaranteed to outlive the call, same as on the device
+  config.broker.address.hostname = nullptr;
+  config.credentials.client_id = nullptr;
+  config.session.last_will.topic = nullptr;
+  config.session.last_will.msg = nullptr;
+  return (esp_mqtt_client_handle_t)&config;
+}
+
+int esp_mqtt_client_register_event([[maybe_unused]] esp_mqtt_client_handle_t client,
+                                   [[maybe_unused]] esp_mqtt_event_id_t event, esp_event_handler_t event_handler,
+                                   void* event_handler_arg) {
+  handler = event_handler;
+  handler_args = event_handler_arg;
+  return 0;
+}
+
+int esp_mqtt_client_start([[maybe_unused]] esp_mqtt_client_handle_t client) {
+  started = true;
+  return 0;
+}
+
+int esp_mqtt_client_subscribe([[maybe_unused]] esp_mqtt_client_handle_t client, const char* topic,
+                              [[maybe_unused]] int qos) {
+  if (!connected) {
+    return -1;
+  }
+  pause_allocation_count(true);
+  subscriptions.push_back(topic);
+  pause_allocation_count(false);
+  return next_msg_id++;
+}
+
+int esp_mqtt_client_publish([[maybe_unused]] esp_mqtt_client_handle_t client, const char* topic, const char* data,
+                            int len, int qos, int retain) {
+  if (len <= 0) {
+    len = strlen(data);
+  }
+  if (qos == 0) {
+    if (!connected) {
+      counters.lost++;
+      return -1;
+    }
+    pause_allocation_count(true);
+    deliver(topic, std::string(data, len), retain);
+    pause_allocation_count(false);
+    return 0;
+  }
+  pause_allocation_count(true);
+  outbox.push_back({topic, std::string(data, len), retain != 0});
+  pause_allocation_count(false);
+  outbox_bytes += strlen(topic) + len;
+  counters.queued++;
+  return next_msg_id++;
+}
+
+int esp_mqtt_client_get_outbox_size([[maybe_unused]] esp_mqtt_client_handle_t client) {
+  return outbox_bytes;
+}
@@ -0,0 +1,51 @@
+#ifndef __FAKE_BROKER_H__
+#define __FAKE_BROKER_H__
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+/**
+ * In-process stand-in for a broker, reached through the esp_mqtt_client_* shim in shim/mqtt_client.h.
+ *
+ * Everything runs on the caller's thread: events go to the registered handler from inside the fake_broker_*() call
+ * that caused them. Publishing follows esp-mqtt: QoS 0 messages are lost while disconnected (-1), QoS 1/2 messages
+ * wait in the outbox until the next fake_broker_tick() after a connect acknowledges them.
+ */
+
+typedef struct {
+  uint32_t messages;
+  uint64_t bytes;  // Topic plus payload
+  bool retained;
+  std::string last_payload;
+} FAKE_BROKER_TOPIC_TYPE;
+
+typedef struct {
+  uint32_t messages;  // Delivered to the broker
+  uint64_t bytes;
+  uint32_t lost;    // QoS 0 publishes while disconnected
+  uint32_t queued;  // QoS 1/2 publishes that went to the outbox
+  uint32_t connects;
+  uint32_t disconnects;
+} FAKE_BROKER_COUNTERS_TYPE;
+
+/** Accept the client (it must have called esp_mqtt_client_start()), it gets MQTT_EVENT_CONNECTED */
+void fake_broker_connect(void);
+/** Drop the connection, the last will is published and the client gets MQTT_EVENT_DISCONNECTED */
+void fake_broker_disconnect(void);
+bool fake_broker_connected(void);
+/** One network round trip, acknowledges the outbox while connected */
+void fake_broker_tick(void);
+
+/** Publish from another client, delivered to the MQTT module if it subscribed to a matching filter */
+void fake_broker_send(const char* topic, const char* payload);
+bool fake_broker_subscribed(const char* topic);
+
+const FAKE_BROKER_COUNTERS_TYPE& fake_broker_counters(void);
+const std::map<std::string, FAKE_BROKER_TOPIC_TYPE>& fake_broker_topics(void);
+/** Bytes in the client outbox, as returned by esp_mqtt_client_get_outbox_size() */
+int fake_broker_outbox_size(void);
+/** Print every message the broker receives */
+void fake_broker_set_verbose(bool verbose);
+
+#endif  // __FAKE_BROKER_H__
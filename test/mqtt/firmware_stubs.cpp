@@ -0,0 +1,188 @@
+#include "firmware_stubs.h"
+#include <Arduino.h>
+#include <WiFi.h>
+#include <stdarg.h>
+#include "esp_timer.h"
+#include "USER_SECRETS.h"
+#include "src/datalayer/datalayer.h"
+#include "src/devboard/mqtt/mqtt.h"
+#include "src/devboard/utils/events.h"
+
+unsigned long sim_millis = 0;
+bool sim_wifi_connected = true;
+SIM_COMMAND_COUNTERS_TYPE sim_commands = {};
+
+/* Arduino and ESP-IDF */
+
+unsigned long millis(void) {
+  return sim_millis;
+}
+
+void delay(unsigned long ms) {
+  sim_millis += ms;
+}
+
+int64_t esp_timer_get_time(void) {
+  return (int64_t)sim_millis * 1000;
+}
+
+EspClass ESP;
+
+void EspClass::restart(void) {
+  sim_commands.restart++;
+}
+
+uint32_t EspClass::getFreeHeap(void) {
+  return 150000;
+}
+
+uint32_t EspClass::getMaxAllocHeap(void) {
+  return 110000;
+}
+
+WiFiClass WiFi;
+
+wl_status_t WiFiClass::status(void) {
+  return sim_wifi_connected ? WL_CONNECTED : WL_DISCONNECTED;
+}
+
+const char* WiFiClass::getHostname(void) {
+  return "esp32-123456";
+}
+
+size_t Print::print(const char* text) {
+  return write((const uint8_t*)text, strlen(text));
+}
+
+size_t Print::print(int value) {
+  char text[12];
+  snprintf(text, sizeof(text), "%d", value);
+  return print(text);
+}
+
+size_t Print::println(const char* text) {
+  return print(text) + print("\n");
+}
+
+size_t Print::println(int value) {
+  return print(value) + print("\n");
+}
+
+/* Logging is dropped, its cost is not what the harness measures */
+
+Logging logging;
+
+size_t Logging::write([[maybe_unused]] const uint8_t* buffer, size_t size) {
+  return size;
+}
+
+void Logging::printf([[maybe_unused]] const char* fmt, ...) {}
+
+/* Settings normally in Software.ino and USER_SETTINGS.cpp */
+
+const char* version_number = "host";
+const char* mqtt_user = MQTT_USER;
+const char* mqtt_password = MQTT_PASSWORD;
+#ifdef MQTT_MANUAL_TOPIC_OBJECT_NAME
+const char* mqtt_topic_name = "BE";
+const char* mqtt_object_id_prefix = "be_";
+const char* mqtt_device_name = "Battery Emulator";
+const char* ha_device_id = "battery-emulator";
+#endif  // MQTT_MANUAL_TOPIC_OBJECT_NAME
+
+/* Settings storage */
+
+void store_settings() {
+  sim_commands.store_settings++;
+}
+
+/* Safety */
+
+bool emulator_pause_request_ON = false;
+bool emulator_pause_CAN_send_ON = false;
+battery_pause_status emulator_pause_status = NORMAL;
+bool allowed_to_send_CAN = true;
+
+void setBatteryPause(bool pause_battery, [[maybe_unused]] bool pause_CAN, bool equipment_stop,
+                     [[maybe_unused]] bool store_settings) {
+  if (equipment_stop) {
+    sim_commands.equipment_stop++;
+  } else if (pause_battery) {
+    sim_commands.pause++;
+  } else {
+    sim_commands.resume++;
+  }
+  emulator_pause_status = pause_battery ? PAUSED : NORMAL;
+}
+
+std::string get_emulator_pause_status() {
+  switch (emulator_pause_status) {
+    case NORMAL:
+      return "RUNNING";
+    case PAUSING:
+      return "PAUSING";
+    case PAUSED:
+      return "PAUSED";
+    case RESUMING:
+      return "RESUMING";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+void start_bms_reset() {
+  sim_commands.bms_reset++;
+}
+
+/* Events, same bookkeeping as events.cpp without levels, storage and LED handling */
+
+static const char* EVENTS_ENUM_TYPE_STRING[] = {EVENTS_ENUM_TYPE(GENERATE_STRING)};
+static EVENTS_STRUCT_TYPE event_entries[EVENT_NOF_EVENTS];
+static uint32_t event_generation = 0;
+
+const char* get_event_enum_string(EVENTS_ENUM_TYPE event) {
+  return EVENTS_ENUM_TYPE_STRING[event] + 6;
+}
+
+const char* get_event_message_string([[maybe_unused]] EVENTS_ENUM_TYPE event) {
+  return "Simulated event on the host";
+}
+
+const char* get_event_level_string([[maybe_unused]] EVENTS_ENUM_TYPE event) {
+  return "INFO";
+}
+
+void set_event(EVENTS_ENUM_TYPE event, uint8_t data) {
+  EVENTS_STRUCT_TYPE& entry = event_entries[event];
+  if (entry.state != EVENT_STATE_ACTIVE) {
+    entry.state = EVENT_STATE_ACTIVE;
+    entry.occurences++;
+    entry.MQTTpublished = false;
+    entry.timestamp = millis() / 1000;
+    event_generation++;
+  }
+  entry.data = data;
+}
+
+void clear_event(EVENTS_ENUM_TYPE event) {
+  if (event_entries[event].state == EVENT_STATE_ACTIVE) {
+    event_entries[event].state = EVENT_STATE_INACTIVE;
+    event_generation++;
+  }
+}
+
+void set_event_MQTTpublished(EVENTS_ENUM_TYPE event) {
+  event_entries[event].MQTTpublished = true;
+}
+
+const EVENTS_STRUCT_TYPE* get_event_pointer(EVENTS_ENUM_TYPE event) {
+  return &event_entries[event];
+}
+
+uint32_t get_event_generation(void) {
+  return event_generation;
+}
+
+bool compareEventsByTimestampAsc(const EventData& a, const EventData& b) {
+  return a.event_pointer->timestamp < b.event_pointer->timestamp;
+}
@@ -0,0 +1,24 @@
+#ifndef __FIRMWARE_STUBS_H__
+#define __FIRMWARE_STUBS_H__
+
+#include <stdint.h>
+
+// Host side of what the MQTT module expects from the rest of the firmware, controlled by the harness
+
+/** Simulated clock behind millis() and esp_timer_get_time() */
+extern unsigned long sim_millis;
+/** What WiFi.status() reports */
+extern bool sim_wifi_connected;
+
+typedef struct {
+  uint32_t pause;  // setBatteryPause(true, ..)
+  uint32_t resume;
+  uint32_t equipment_stop;
+  uint32_t bms_reset;
+  uint32_t restart;
+  uint32_t store_settings;
+} SIM_COMMAND_COUNTERS_TYPE;
+
+extern SIM_COMMAND_COUNTERS_TYPE sim_commands;
+
+#endif  // __FIRMWARE_STUBS_H__
@@ -0,0 +1,425 @@
+/**
+ * Benchmark and soak harness for the MQTT module (Software/src/devboard/mqtt), built from the real sources against the
+ * host shims in shim/ and the in-process broker in fake_broker.cpp.
+ *
+ *   mqtt_bench [--minutes N] [--cells N] [--verbose]
+ *
+ * A synthetic battery changes the datalayer while the harness calls mqtt_loop() every simulated millisecond, like the
+ * MQTT task does. It runs through boot with Home Assistant discovery, a steady soak, a WiFi outage, a broker restart,
+ * a Home Assistant restart and a few commands, then reports:
+ *  - host CPU time spent in mqtt_loop(), only comparable between runs on the same machine
+ *  - messages and bytes per minute, per topic
+ *  - heap allocations made by the MQTT module
+ *  - what is lost and how long publishing takes to recover after disconnects
+ *
+ * The process exits with 1 when one of the budgets below is exceeded, so the unit test workflow catches telemetry cost
+ * regressions. mqtt_bench_on_change runs the same with MQTT_PUBLISH_ON_CHANGE and MQTT_BACKLOG.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include "alloc_count.h"
+#include "fake_broker.h"
+#include "firmware_stubs.h"
+#include "src/datalayer/datalayer.h"
+#include "src/devboard/mqtt/mqtt.h"
+#include "src/devboard/mqtt/mqtt_batch.h"
+#include "src/devboard/mqtt/mqtt_commands.h"
+#include "src/devboard/utils/cell_stats.h"
+#include "src/devboard/utils/events.h"
+
+// Budgets for the default settings with 96 cells, raise them on purpose when a change is meant to send more
+#if defined(MQTT_PUBLISH_ON_CHANGE)
+#define BUDGET_BYTES_PER_MINUTE 9000
+#elif defined(MQTT_BATCH)
+#define BUDGET_BYTES_PER_MINUTE 19000
+#else
+#define BUDGET_BYTES_PER_MINUTE 10000
+#endif
+#define BUDGET_STEADY_ALLOCATIONS 0  // Publishing must not touch the heap once running, connected or not
+#define BUDGET_DISCOVERY_MS 20000    // Connect to the last Home Assistant discovery message
+#define BUDGET_RECOVERY_MS 2500      // Reconnect to the first power message
+#define BUDGET_COMMAND_LATENCY_MS 2  // Command received to executed by the core task
+
+#define BROKER_TICK_MS 10      // Network round trip, outbox acknowledgements
+#define BATTERY_UPDATE_MS 100  // How often the synthetic battery changes the datalayer
+
+typedef struct {
+  double cpu_us;  // Host time spent in mqtt_loop()
+  double max_call_us;
+  uint64_t calls;
+  uint64_t allocations;
+} RUN_STATS_TYPE;
+
+static bool verbose = false;
+static bool broker_up = true;
+static int failures = 0;
+static uint32_t rng_state = 0x12345678;
+
+static uint32_t rng(void) {
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 17;
+  rng_state ^= rng_state << 5;
+  return rng_state;
+}
+
+/** Random integer in [-range, range] */
+static int32_t noise(int32_t range) {
+  return (int32_t)(rng() % (2 * range + 1)) - range;
+}
+
+static void init_battery(uint8_t cells) {
+  DATALAYER_BATTERY_TYPE& battery = datalayer.battery;
+  battery.info.number_of_cells = cells;
+  battery.info.total_capacity_Wh = 30000;
+  battery.info.reported_total_capacity_Wh = 30000;
+  battery.status.real_soc = 6000;
+  battery.status.reported_soc = 6000;
+  battery.status.soh_pptt = 9650;
+  battery.status.temperature_min_dC = 180;
+  battery.status.temperature_max_dC = 210;
+  battery.status.max_charge_power_W = 8000;
+  battery.status.max_discharge_power_W = 10000;
+  battery.status.bms_status = ACTIVE;
+  for (uint8_t i = 0; i < cells; i++) {
+    battery.status.cell_voltages_mV[i] = 3780 + noise(8);
+  }
+}
+
+/** A house battery: power follows a slow load curve with some noise, the rest follows the power */
+static void update_battery(void) {
+  DATALAYER_BATTERY_TYPE& battery = datalayer.battery;
+  double minutes = sim_millis / 60000.0;
+  int32_t power_W = (int32_t)(2500 * sin(minutes * 0.7) + 600 * sin(minutes * 5.3)) + noise(25);
+  battery.status.active_power_W = power_W;
+  battery.status.voltage_dV = 3630 - power_W / 100 + noise(1);
+  battery.status.current_dA = (int16_t)(power_W * 100 / battery.status.voltage_dV);
+
+  // Energy and SOC follow the power integrated over the update interval
+  static double energy_Wh = 18000;
+  static double charged_Wh = 0;
+  static double discharged_Wh = 0;
+  double step_Wh = power_W * (BATTERY_UPDATE_MS / 3600000.0);
+  energy_Wh = std::min(30000.0, std::max(0.0, energy_Wh + step_Wh));
+  (step_Wh > 0 ? charged_Wh : discharged_Wh) += fabs(step_Wh);
+  battery.status.remaining_capacity_Wh = (uint32_t)energy_Wh;
+  battery.status.reported_remaining_capacity_Wh = (uint32_t)energy_Wh;
+  battery.status.total_charged_battery_Wh = (int32_t)charged_Wh;
+  battery.status.total_discharged_battery_Wh = (int32_t)discharged_Wh;
+  battery.status.real_soc = (uint16_t)(energy_Wh * 10000 / 30000);
+  battery.status.reported_soc = battery.status.real_soc;
+
+  if (rng() % 600 == 0) {  // Temperatures creep a tenth of a degree at a time
+    battery.status.temperature_min_dC += noise(1);
+    battery.status.temperature_max_dC += noise(1);
+  }
+
+  uint16_t min_mV = UINT16_MAX;
+  uint16_t max_mV = 0;
+  int32_t target_mV = 3600 + battery.status.real_soc / 20 - power_W / 400;
+  for (uint8_t i = 0; i < battery.info.number_of_cells; i++) {
+    uint16_t& cell_mV = battery.status.cell_voltages_mV[i];
+    cell_mV += (target_mV > cell_mV) - (target_mV < cell_mV);
+    if (rng() % 4 == 0) {
+      cell_mV += noise(1);  // Measurement noise
+    }
+    min_mV = std::min(min_mV, cell_mV);
+    max_mV = std::max(max_mV, cell_mV);
+  }
+  battery.status.cell_min_voltage_mV = min_mV;
+  battery.status.cell_max_voltage_mV = max_mV;
+}
+
+/** Advance the simulated time by ms, calling mqtt_loop() every millisecond */
+static void run_for(unsigned long ms, RUN_STATS_TYPE* stats = nullptr) {
+  for (unsigned long i = 0; i < ms; i++) {
+    sim_millis++;
+    if (sim_millis % BATTERY_UPDATE_MS == 0) {
+      update_battery();
+      finish_cell_stats(datalayer.battery);
+      update_datalayer_generation();  // Like the core task at the end of its values pass
+      publish_datalayer_snapshot();
+    }
+    if (sim_millis % BROKER_TICK_MS == 0) {
+      fake_broker_tick();
+    }
+    if (sim_wifi_connected && broker_up && !fake_broker_connected()) {
+      // Straight away instead of after esp-mqtt's 10s reconnect timeout, so recovery times are the module's own
+      fake_broker_connect();  // Does nothing until the client has been started
+    }
+    handle_mqtt_commands();  // The core task, every 1ms
+#ifdef MQTT_BATCH
+    mqtt_batch_sample();
+#endif  // MQTT_BATCH
+
+    uint64_t allocations = allocation_count();
+    auto start = std::chrono::steady_clock::now();
+    mqtt_loop();
+    auto end = std::chrono::steady_clock::now();
+    if (stats != nullptr) {
+      double us = std::chrono::duration<double, std::micro>(end - start).count();
+      stats->cpu_us += us;
+      stats->max_call_us = std::max(stats->max_call_us, us);
+      stats->calls++;
+      stats->allocations += allocation_count() - allocations;
+    }
+  }
+}
+
+static void check(bool ok, const char* what, double value, double budget) {
+  printf("  %-44s %12.0f %s budget %.0f\n", what, value, ok ? "within" : "EXCEEDS", budget);
+  if (!ok) {
+    failures++;
+  }
+}
+
+static void expect(bool ok, const char* what) {
+  printf("  %-44s %s\n", what, ok ? "ok" : "FAILED");
+  if (!ok) {
+    failures++;
+  }
+}
+
+static bool is_discovery_topic(const std::string& topic) {
+  return topic.compare(0, 14, "homeassistant/") == 0;
+}
+
+static uint64_t discovery_messages(void) {
+  uint64_t messages = 0;
+  for (const auto& topic : fake_broker_topics()) {
+    if (is_discovery_topic(topic.first)) {
+      messages += topic.second.messages;
+    }
+  }
+  return messages;
+}
+
+static uint32_t topic_messages(const char* suffix) {
+  std::string topic = std::string(mqtt_topic_name) + suffix;
+  auto found = fake_broker_topics().find(topic);
+  return found == fake_broker_topics().end() ? 0 : found->second.messages;
+}
+
+/** Run until the topic gets a new message, returns how long that took or UINT32_MAX */
+static unsigned long run_until_published(const char* suffix, unsigned long limit_ms) {
+  uint32_t before = topic_messages(suffix);
+  for (unsigned long waited = 0; waited < limit_ms; waited++) {
+    run_for(1);
+    if (topic_messages(suffix) != before) {
+      return waited + 1;
+    }
+  }
+  return UINT32_MAX;
+}
+
+/** Run until no discovery message was sent for a while, returns when the last one was sent */
+static unsigned long run_until_discovery_done(void) {
+  unsigned long last_ms = sim_millis;
+  uint64_t last_count = discovery_messages();
+  while (sim_millis - last_ms < 5000) {
+    run_for(100);
+    if (discovery_messages() != last_count) {
+      last_count = discovery_messages();
+      last_ms = sim_millis;
+    }
+  }
+  return last_ms;
+}
+
+static void print_topics(const std::map<std::string, FAKE_BROKER_TOPIC_TYPE>& before, double minutes) {
+  printf("  %-44s %12s %12s\n", "topic", "msgs/min", "bytes/min");
+  for (const auto& topic : fake_broker_topics()) {
+    if (is_discovery_topic(topic.first)) {
+      continue;
+    }
+    auto earlier = before.find(topic.first);
+    uint32_t messages = topic.second.messages - (earlier == before.end() ? 0 : earlier->second.messages);
+    uint64_t bytes = topic.second.bytes - (earlier == before.end() ? 0 : earlier->second.bytes);
+    if (messages > 0) {
+      printf("  %-44s %12.1f %12.0f\n", topic.first.c_str(), messages / minutes, bytes / minutes);
+    }
+  }
+}
+
+static void print_cpu(const RUN_STATS_TYPE& stats, double minutes) {
+  printf("  %-44s %12.2f\n", "host CPU ms per minute in mqtt_loop()", stats.cpu_us / 1000 / minutes);
+  printf("  %-44s %12.2f\n", "host CPU us per mqtt_loop() call, mean", stats.cpu_us / stats.calls);
+  printf("  %-44s %12.2f\n", "host CPU us per mqtt_loop() call, max", stats.max_call_us);
+}
+
+#ifdef MQTT_BACKLOG
+/** Number of samples in a backlog payload, the rows of the "samples" array */
+static uint32_t backlog_samples(const std::string& payload) {
+  size_t samples = payload.find("\"samples\":[");
+  uint32_t count = 0;
+  for (size_t i = samples; samples != std::string::npos && i < payload.size(); i++) {
+    count += payload[i] == '[';
+  }
+  return count > 0 ? count - 1 : 0;
+}
+#endif  // MQTT_BACKLOG
+
+#ifdef MQTT_BATCH
+/** Number of samples in a batch payload, the entries of the "t" array */
+static uint32_t batch_length(const std::string& payload) {
+  size_t start = payload.find("\"t\":[");
+  size_t end = payload.find(']', start);
+  if (start == std::string::npos || end == std::string::npos) {
+    return 0;
+  }
+  return std::count(payload.begin() + start, payload.begin() + end, ',') + 1;
+}
+#endif  // MQTT_BATCH
+
+int main(int argc, char* argv[]) {
+  double minutes = 10;
+  int cells = 96;
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--minutes") == 0 && i + 1 < argc) {
+      minutes = atof(argv[++i]);
+    } else if (strcmp(argv[i], "--cells") == 0 && i + 1 < argc) {
+      cells = atoi(argv[++i]);
+    } else if (strcmp(argv[i], "--verbose") == 0) {
+      verbose = true;
+    } else {
+      printf("usage: %s [--minutes N] [--cells N] [--verbose]\n", argv[0]);
+      return 2;
+    }
+  }
+  if (minutes <= 0 || cells < 1 || cells > MAX_AMOUNT_CELLS) {
+    printf("--minutes must be positive and --cells between 1 and %d\n", MAX_AMOUNT_CELLS);
+    return 2;
+  }
+  fake_broker_set_verbose(verbose);
+
+#ifdef MQTT_PUBLISH_ON_CHANGE
+  printf("MQTT bench, %d cells, MQTT_PUBLISH_ON_CHANGE", cells);
+#else
+  printf("MQTT bench, %d cells, publish every interval", cells);
+#endif
+#ifdef MQTT_BACKLOG
+  printf(", MQTT_BACKLOG");
+#endif
+#ifdef MQTT_BATCH
+  printf(", MQTT_BATCH");
+#endif
+  printf("\n");
+
+  // Boot: WiFi is up, the client connects on the first check and Home Assistant discovery follows
+  printf("\nBoot\n");
+  init_battery(cells);
+  update_battery();
+  init_mqtt();
+  run_for(BOOTUP_TIME);
+  unsigned long connected_ms = 0;
+  while (!fake_broker_connected() && sim_millis < 10000) {
+    run_for(1);
+    connected_ms = sim_millis;
+  }
+  expect(fake_broker_connected(), "connected to the broker");
+#ifdef HA_AUTODISCOVERY
+  unsigned long discovery_done_ms = run_until_discovery_done();
+  uint64_t boot_discovery = discovery_messages();
+  printf("  %-44s %12llu\n", "discovery messages", (unsigned long long)boot_discovery);
+  check(discovery_done_ms - connected_ms <= BUDGET_DISCOVERY_MS, "discovery time ms", discovery_done_ms - connected_ms,
+        BUDGET_DISCOVERY_MS);
+#endif  // HA_AUTODISCOVERY
+
+  // Steady state soak
+  printf("\nSoak, %.1f simulated minutes\n", minutes);
+  run_for(MQTT_CELL_VOLTAGES_INTERVAL_MS);  // Let every schedule come around once
+  std::map<std::string, FAKE_BROKER_TOPIC_TYPE> topics_before = fake_broker_topics();
+  FAKE_BROKER_COUNTERS_TYPE counters_before = fake_broker_counters();
+  RUN_STATS_TYPE soak = {};
+  run_for((unsigned long)(minutes * 60000), &soak);
+  print_topics(topics_before, minutes);
+  double bytes_per_minute = (fake_broker_counters().bytes - counters_before.bytes) / minutes;
+  printf("  %-44s %12.1f\n", "messages per minute",
+         (fake_broker_counters().messages - counters_before.messages) / minutes);
+  print_cpu(soak, minutes);
+  check(bytes_per_minute <= BUDGET_BYTES_PER_MINUTE, "bytes per minute", bytes_per_minute, BUDGET_BYTES_PER_MINUTE);
+  check(soak.allocations <= BUDGET_STEADY_ALLOCATIONS, "heap allocations", soak.allocations, BUDGET_STEADY_ALLOCATIONS);
+#ifdef MQTT_BATCH
+  uint32_t batch_messages = topic_messages("/batch") - topics_before[std::string(mqtt_topic_name) + "/batch"].messages;
+  uint32_t batch_samples = batch_length(fake_broker_topics().at(std::string(mqtt_topic_name) + "/batch").last_payload);
+  printf("  %-44s %12u\n", "samples in the last batch message", batch_samples);
+  expect(batch_messages > 0 && batch_samples > 1, "batches sent");
+#endif  // MQTT_BATCH
+
+  // WiFi outage: the connection drops with it, nothing can be sent until both are back
+  printf("\nWiFi outage, 5 minutes\n");
+  const unsigned long outage_ms = 5 * 60000;
+  uint32_t lost_before = fake_broker_counters().lost;
+  sim_wifi_connected = false;
+  fake_broker_disconnect();
+  RUN_STATS_TYPE outage = {};
+  run_for(outage_ms, &outage);
+  printf("  %-44s %12u\n", "publishes lost", fake_broker_counters().lost - lost_before);
+  print_cpu(outage, outage_ms / 60000.0);
+  check(outage.allocations <= BUDGET_STEADY_ALLOCATIONS, "heap allocations", outage.allocations,
+        BUDGET_STEADY_ALLOCATIONS);
+  sim_wifi_connected = true;
+  unsigned long recovery_ms = run_until_published("/power", 60000);
+  check(recovery_ms <= BUDGET_RECOVERY_MS, "reconnect to first power message ms", recovery_ms, BUDGET_RECOVERY_MS);
+#ifdef MQTT_BACKLOG
+  // One sample per MQTT_BACKLOG_INTERVAL_MS while disconnected, all replayed once connected
+  uint32_t backlog_before = topic_messages("/backlog");
+  run_for(60000);
+  uint32_t replayed = 0;
+  auto backlog = fake_broker_topics().find(std::string(mqtt_topic_name) + "/backlog");
+  if (backlog != fake_broker_topics().end()) {
+    // Only the last payload is kept, the batches before it were full
+    replayed = (backlog->second.messages - backlog_before - 1) * MQTT_BACKLOG_BATCH_SAMPLES +
+               backlog_samples(backlog->second.last_payload);
+  }
+  printf("  %-44s %12u\n", "backlog samples replayed", replayed);
+  expect(replayed >= outage_ms / MQTT_BACKLOG_INTERVAL_MS - 1, "backlog covers the outage");
+#endif  // MQTT_BACKLOG
+
+  // Broker restart: WiFi stays up, publishes fail until the client reconnects
+  printf("\nBroker restart, 30 seconds\n");
+  lost_before = fake_broker_counters().lost;
+  broker_up = false;
+  fake_broker_disconnect();
+  RUN_STATS_TYPE restart = {};
+  run_for(30000, &restart);
+  printf("  %-44s %12u\n", "publishes lost", fake_broker_counters().lost - lost_before);
+  print_cpu(restart, 0.5);
+  check(restart.allocations <= BUDGET_STEADY_ALLOCATIONS, "heap allocations", restart.allocations,
+        BUDGET_STEADY_ALLOCATIONS);
+  broker_up = true;
+  recovery_ms = run_until_published("/power", 60000);
+  check(recovery_ms <= BUDGET_RECOVERY_MS, "reconnect to first power message ms", recovery_ms, BUDGET_RECOVERY_MS);
+  expect(fake_broker_subscribed((std::string(mqtt_topic_name) + "/command/STOP").c_str()), "commands subscribed again");
+
+#ifdef HA_AUTODISCOVERY
+  // Home Assistant restart: it announces itself and wants every discovery message again
+  printf("\nHome Assistant restart\n");
+  uint64_t discovery_before = discovery_messages();
+  fake_broker_send("homeassistant/status", "online");
+  run_until_discovery_done();
+  printf("  %-44s %12llu\n", "discovery messages", (unsigned long long)(discovery_messages() - discovery_before));
+  expect(discovery_messages() - discovery_before == boot_discovery, "discovery sent again in full");
+#endif  // HA_AUTODISCOVERY
+
+  // Commands go through the queue to the core task
+  printf("\nCommands\n");
+  fake_broker_send((std::string(mqtt_topic_name) + "/command/PAUSE").c_str(), "");
+  run_for(BUDGET_COMMAND_LATENCY_MS);
+  expect(sim_commands.pause == 1, "PAUSE executed");
+  fake_broker_send((std::string(mqtt_topic_name) + "/command/RESUME").c_str(), "");
+  run_for(BUDGET_COMMAND_LATENCY_MS);
+  expect(sim_commands.resume == 1, "RESUME executed");
+  fake_broker_send((std::string(mqtt_topic_name) + "/command/RESTART").c_str(), "");
+  run_for(BUDGET_COMMAND_LATENCY_MS);
+  expect(sim_commands.restart == 0, "RESTART waits for the pause to go out");
+  run_for(2000);
+  expect(sim_commands.restart > 0, "RESTART executed");
+
+  printf("\n%s\n", failures == 0 ? "All budgets met" : "Budgets exceeded");
+  return failures == 0 ? 0 : 1;
+}
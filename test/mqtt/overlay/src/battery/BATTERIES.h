@@ -0,0 +1,8 @@
+#ifndef BATTERIES_H
+#define BATTERIES_H
+
+// Host build replacement, the MQTT module only needs the settings and no battery integration
+
+#include "../../USER_SETTINGS.h"
+
+#endif
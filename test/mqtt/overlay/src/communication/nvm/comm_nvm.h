@@ -0,0 +1,8 @@
+#ifndef _COMM_NVM_H_
+#define _COMM_NVM_H_
+
+// Host build replacement, the MQTT module only flushes the settings before a restart
+
+void store_settings();
+
+#endif
@@ -0,0 +1,18 @@
+#ifndef INCLUDE_H_
+#define INCLUDE_H_
+
+// Host build replacement for Software/src/include.h, without the hardware, battery, charger and inverter headers
+
+#include <Arduino.h>
+#include <stdint.h>
+#include "../USER_SETTINGS.h"
+#include "system_settings.h"
+
+#include "devboard/safety/safety.h"
+#include "devboard/utils/logging.h"
+#include "devboard/utils/types.h"
+
+// Normally set by the hardware definition in devboard/hal
+#define BOOTUP_TIME 1000
+
+#endif
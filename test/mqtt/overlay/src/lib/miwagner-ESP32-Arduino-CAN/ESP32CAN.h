@@ -0,0 +1,6 @@
+#ifndef ESP32CAN_H
+#define ESP32CAN_H
+
+// Host build replacement, there is no CAN driver on the host
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef __ARDUINO_SHIM_H__
+#define __ARDUINO_SHIM_H__
+
+// Just enough of the Arduino core to build the MQTT module on a Linux host
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+#include "Print.h"
+
+using std::max;
+using std::min;
+
+/** Arduino String on top of std::string, so it allocates where the real one does */
+class String {
+ public:
+  String() {}
+  String(const char* text) : text(text) {}
+  String(const std::string& text) : text(text) {}
+  String(int value) : text(std::to_string(value)) {}
+  String(unsigned int value) : text(std::to_string(value)) {}
+  String(long value) : text(std::to_string(value)) {}
+  String(unsigned long value) : text(std::to_string(value)) {}
+  String(float value, unsigned int decimals = 2) {
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimals, value);
+    text = buffer;
+  }
+
+  String operator+(const String& other) const { return String(text + other.text); }
+  String& operator+=(const String& other) {
+    text += other.text;
+    return *this;
+  }
+  friend String operator+(const char* left, const String& right) { return String(left) + right; }
+
+  bool concat(const char* other) {
+    text += other;
+    return true;
+  }
+  bool concat(const char* other, unsigned int length) {
+    text.append(other, length);
+    return true;
+  }
+  bool concat(char c) {
+    text += c;
+    return true;
+  }
+  const char* c_str() const { return text.c_str(); }
+  unsigned int length() const { return text.size(); }
+
+ private:
+  std::string text;
+};
+
+unsigned long millis(void);
+void delay(unsigned long ms);
+
+class EspClass {
+ public:
+  void restart(void);
+  uint32_t getFreeHeap(void);
+  uint32_t getMaxAllocHeap(void);
+};
+
+extern EspClass ESP;
+
+#endif  // __ARDUINO_SHIM_H__
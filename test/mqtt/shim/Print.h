@@ -0,0 +1,24 @@
+#ifndef __PRINT_SHIM_H__
+#define __PRINT_SHIM_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** Print with the overloads the MQTT module uses, everything ends up in write() */
+class Print {
+ public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t c) = 0;
+  virtual size_t write(const uint8_t* buffer, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      write(buffer[i]);
+    }
+    return size;
+  }
+  size_t print(const char* text);
+  size_t print(int value);
+  size_t println(const char* text);
+  size_t println(int value);
+};
+
+#endif  // __PRINT_SHIM_H__
@@ -0,0 +1,14 @@
+#ifndef __WIFI_SHIM_H__
+#define __WIFI_SHIM_H__
+
+typedef enum { WL_IDLE_STATUS = 0, WL_CONNECTED = 3, WL_DISCONNECTED = 6 } wl_status_t;
+
+class WiFiClass {
+ public:
+  wl_status_t status(void);
+  const char* getHostname(void);
+};
+
+extern WiFiClass WiFi;
+
+#endif  // __WIFI_SHIM_H__
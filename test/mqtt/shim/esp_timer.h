@@ -0,0 +1,9 @@
+#ifndef __ESP_TIMER_SHIM_H__
+#define __ESP_TIMER_SHIM_H__
+
+#include <stdint.h>
+
+/** Microseconds since boot, follows the simulated clock of the harness */
+int64_t esp_timer_get_time(void);
+
+#endif  // __ESP_TIMER_SHIM_H__
@@ -0,0 +1,6 @@
+#ifndef __FREERTOS_SHIM_H__
+#define __FREERTOS_SHIM_H__
+
+// The MQTT module includes FreeRTOS but the harness runs everything on one thread
+
+#endif  // __FREERTOS_SHIM_H__
@@ -0,0 +1,31 @@
+#ifndef __FREERTOS_TASK_SHIM_H__
+#define __FREERTOS_TASK_SHIM_H__
+
+#include <stdint.h>
+
+// Single threaded harness: there is only one task and nothing ever waits on a notification
+
+typedef void* TaskHandle_t;
+typedef int32_t BaseType_t;
+typedef uint32_t TickType_t;
+typedef enum { eNoAction = 0, eSetBits, eIncrement, eSetValueWithOverwrite, eSetValueWithoutOverwrite } eNotifyAction;
+
+#define pdTRUE 1
+#define pdFALSE 0
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+inline TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+  static int task;
+  return &task;
+}
+
+inline BaseType_t xTaskNotify(TaskHandle_t, uint32_t, eNotifyAction) {
+  return pdTRUE;
+}
+
+inline BaseType_t xTaskNotifyWait(uint32_t, uint32_t, uint32_t* value, TickType_t) {
+  *value = 0;
+  return pdFALSE;
+}
+
+#endif  // __FREERTOS_TASK_SHIM_H__
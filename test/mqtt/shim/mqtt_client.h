@@ -0,0 +1,95 @@
+#ifndef __MQTT_CLIENT_SHIM_H__
+#define __MQTT_CLIENT_SHIM_H__
+
+// The parts of the ESP-IDF esp_mqtt_client API the MQTT module uses, implemented by fake_broker.cpp
+
+#include <stdint.h>
+
+typedef const char* esp_event_base_t;
+typedef void (*esp_event_handler_t)(void* handler_args, esp_event_base_t base, int32_t event_id, void* event_data);
+
+typedef struct esp_mqtt_client* esp_mqtt_client_handle_t;
+
+typedef enum {
+  MQTT_EVENT_ANY = -1,
+  MQTT_EVENT_ERROR = 0,
+  MQTT_EVENT_CONNECTED,
+  MQTT_EVENT_DISCONNECTED,
+  MQTT_EVENT_SUBSCRIBED,
+  MQTT_EVENT_UNSUBSCRIBED,
+  MQTT_EVENT_PUBLISHED,
+  MQTT_EVENT_DATA,
+  MQTT_EVENT_BEFORE_CONNECT,
+  MQTT_EVENT_DELETED,
+} esp_mqtt_event_id_t;
+
+typedef enum {
+  MQTT_TRANSPORT_UNKNOWN = 0,
+  MQTT_TRANSPORT_OVER_TCP,
+  MQTT_TRANSPORT_OVER_SSL,
+} esp_mqtt_transport_t;
+
+typedef struct {
+  int esp_tls_last_esp_err;
+  int esp_tls_stack_err;
+  int esp_transport_sock_errno;
+} esp_mqtt_error_codes_t;
+
+typedef struct {
+  esp_mqtt_event_id_t event_id;
+  esp_mqtt_client_handle_t client;
+  char* data;
+  int data_len;
+  int total_data_len;
+  int current_data_offset;
+  char* topic;
+  int topic_len;
+  int msg_id;
+  int session_present;
+  esp_mqtt_error_codes_t* error_handle;
+  bool retain;
+  int qos;
+  bool dup;
+} esp_mqtt_event_t;
+
+typedef esp_mqtt_event_t* esp_mqtt_event_handle_t;
+
+typedef struct {
+  struct {
+    struct {
+      esp_mqtt_transport_t transport;
+      const char* hostname;
+      uint32_t port;
+    } address;
+  } broker;
+  struct {
+    const char* client_id;
+    const char* username;
+    struct {
+      const char* password;
+    } authentication;
+  } credentials;
+  struct {
+    struct {
+      const char* topic;
+      const char* msg;
+      int msg_len;
+      int qos;
+      int retain;
+    } last_will;
+  } session;
+  struct {
+    int timeout_ms;
+  } network;
+} esp_mqtt_client_config_t;
+
+esp_mqtt_client_handle_t esp_mqtt_client_init(const esp_mqtt_client_config_t* config);
+int esp_mqtt_client_register_event(esp_mqtt_client_handle_t client, esp_mqtt_event_id_t event,
+                                   esp_event_handler_t event_handler, void* event_handler_arg);
+int esp_mqtt_client_start(esp_mqtt_client_handle_t client);
+int esp_mqtt_client_subscribe(esp_mqtt_client_handle_t client, const char* topic, int qos);
+int esp_mqtt_client_publish(esp_mqtt_client_handle_t client, const char* topic, const char* data, int len, int qos,
+                            int retain);
+int esp_mqtt_client_get_outbox_size(esp_mqtt_client_handle_t client);
+
+#endif  // __MQTT_CLIENT_SHIM_H__
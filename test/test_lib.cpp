@@ -1,11 +1,54 @@
 #include "test_lib.h"
 
+#include <Arduino.h>
+#include <stdarg.h>
 #include <cstdint>
+#include "src/datalayer/datalayer.h"
+#include "src/devboard/utils/logging.h"
 
-MySerial Serial;
+/* The parts of the firmware a module under test runs against */
 
 unsigned long testlib_millis = 0;
 
-uint8_t bms_status = ACTIVE;
+unsigned long millis(void) {
+  return testlib_millis;
+}
 
-uint8_t LEDcolor = GREEN;
+void delay(unsigned long ms) {
+  testlib_millis += ms;
+}
+
+DataLayer datalayer;
+
+size_t Print::print(const char* text) {
+  return write((const uint8_t*)text, strlen(text));
+}
+
+size_t Print::print(int value) {
+  char text[12];
+  snprintf(text, sizeof(text), "%d", value);
+  return print(text);
+}
+
+size_t Print::println(const char* text) {
+  return print(text) + print("\n");
+}
+
+size_t Print::println(int value) {
+  return print(value) + print("\n");
+}
+
+/* Logging goes straight to stdout */
+
+Logging logging;
+
+size_t Logging::write(const uint8_t* buffer, size_t size) {
+  return fwrite(buffer, 1, size, stdout);
+}
+
+void Logging::printf(const char* fmt, ...) {
+  va_list args;
+  va_start(args, fmt);
+  vprintf(fmt, args);
+  va_end(args);
+}
@@ -0,0 +1,263 @@
+// The test library must be included first!
+#include "../test_lib.h"
+
+#include "src/devboard/utils/events.cpp"
+
+/* Helper functions */
+
+static void reset_events_test(void) {
+  testlib_millis = 1000;
+  init_events();
+  reset_all_events();
+}
+
+/** Set and clear the event until it is flapping, it is left active */
+static void make_event_flap(EVENTS_ENUM_TYPE event) {
+  for (uint8_t i = 0; i < EVENT_FLAP_TRANSITIONS; i++) {
+    if (i > 0) {
+      clear_event(event);
+    }
+    testlib_millis += 100;
+    set_event(event, 0);
+  }
+}
+
+/* Test functions */
+
+TEST(init_events_test) {
+  reset_events_test();
+
+  for (uint8_t i = 0; i < EVENT_NOF_EVENTS; i++) {
+    ASSERT_EQ(events.entries[i].occurences, 0);
+    ASSERT_EQ(events.entries[i].data, 0);
+    ASSERT_EQ(events.entries[i].timestamp, 0);
+    ASSERT_FALSE(events.entries[i].flapping);
+  }
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+}
+
+TEST(set_event_test) {
+  reset_events_test();
+
+  // Initially, the event should not have any data or occurences
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].data, 0);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].occurences, 0);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].timestamp, 0);
+  // Set current time and overvoltage event for cell 123, a warning keeps the system active
+  testlib_millis = 345;
+  const uint32_t generation = get_event_generation();
+  set_event(EVENT_CELL_OVER_VOLTAGE, 123);
+  // Ensure proper event data
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].data, 123);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].occurences, 1);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].timestamp, 345);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_ACTIVE);
+  ASSERT_FALSE(events.entries[EVENT_CELL_OVER_VOLTAGE].MQTTpublished);
+  ASSERT_NEQ(get_event_generation(), generation);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  ASSERT_EQ(datalayer.battery.status.bms_status, ACTIVE);
+
+  // Setting it again only updates the data
+  set_event(EVENT_CELL_OVER_VOLTAGE, 124);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].data, 124);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].occurences, 1);
+
+  // An error faults the system
+  set_event(EVENT_DUMMY_ERROR, 0);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_ERROR);
+  ASSERT_EQ(datalayer.battery.status.bms_status, FAULT);
+}
+
+TEST(clear_event_test) {
+  reset_events_test();
+
+  set_event(EVENT_DUMMY_ERROR, 0);
+  const uint32_t generation = get_event_generation();
+  clear_event(EVENT_DUMMY_ERROR);
+  ASSERT_EQ(events.entries[EVENT_DUMMY_ERROR].state, EVENT_STATE_INACTIVE);
+  ASSERT_NEQ(get_event_generation(), generation);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+  ASSERT_EQ(datalayer.battery.status.bms_status, ACTIVE);
+
+  // Clearing an event that is not set changes nothing
+  const uint32_t cleared_generation = get_event_generation();
+  clear_event(EVENT_DUMMY_ERROR);
+  ASSERT_EQ(get_event_generation(), cleared_generation);
+
+  // Latched events are only cleared by reset_all_events()
+  set_event_latched(EVENT_DUMMY_ERROR, 0);
+  clear_event(EVENT_DUMMY_ERROR);
+  ASSERT_EQ(events.entries[EVENT_DUMMY_ERROR].state, EVENT_STATE_ACTIVE_LATCHED);
+  ASSERT_EQ(datalayer.battery.status.bms_status, FAULT);
+}
+
+TEST(event_level_count_test) {
+  reset_events_test();
+
+  set_event(EVENT_DUMMY_INFO, 0);
+  set_event(EVENT_DUMMY_WARNING, 0);
+  set_event(EVENT_CELL_OVER_VOLTAGE, 0);
+  set_event(EVENT_DUMMY_ERROR, 0);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_INFO], 1);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_WARNING], 2);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_ERROR], 1);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_ERROR);
+
+  // The level only drops once the last event of a level is cleared
+  clear_event(EVENT_DUMMY_ERROR);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_ERROR], 0);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  clear_event(EVENT_DUMMY_WARNING);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_WARNING], 1);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  clear_event(EVENT_CELL_OVER_VOLTAGE);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_WARNING], 0);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+
+  // Setting an active event again, or clearing an inactive one, does not count twice
+  set_event(EVENT_DUMMY_INFO, 1);
+  clear_event(EVENT_DUMMY_WARNING);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_INFO], 1);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_WARNING], 0);
+
+  // Updates raise their own level
+  set_event(EVENT_OTA_UPDATE, 0);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_UPDATE);
+  ASSERT_EQ(datalayer.battery.status.bms_status, UPDATING);
+  clear_event(EVENT_OTA_UPDATE);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+  ASSERT_EQ(datalayer.battery.status.bms_status, ACTIVE);
+}
+
+TEST(event_flap_test) {
+  reset_events_test();
+
+  // Fewer rises than EVENT_FLAP_TRANSITIONS are passed through as they are
+  for (uint8_t i = 0; i < EVENT_FLAP_TRANSITIONS - 1; i++) {
+    set_event(EVENT_CAN_OVERRUN, 0);
+    clear_event(EVENT_CAN_OVERRUN);
+    ASSERT_EQ(events.entries[EVENT_CAN_OVERRUN].state, EVENT_STATE_INACTIVE);
+  }
+  ASSERT_FALSE(events.entries[EVENT_CAN_OVERRUN].flapping);
+
+  // Rises spread over more than the window do not flap either
+  testlib_millis += EVENT_FLAP_WINDOW_MS;
+  set_event(EVENT_CAN_OVERRUN, 0);
+  ASSERT_FALSE(events.entries[EVENT_CAN_OVERRUN].flapping);
+  clear_event(EVENT_CAN_OVERRUN);
+
+  reset_events_test();
+  make_event_flap(EVENT_CELL_OVER_VOLTAGE);
+  ASSERT_TRUE(events.entries[EVENT_CELL_OVER_VOLTAGE].flapping);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].occurences, EVENT_FLAP_TRANSITIONS);
+
+  // While flapping, clears are held and the toggles do not touch the level or the generation
+  const uint32_t generation = get_event_generation();
+  for (uint8_t i = 0; i < 3; i++) {
+    clear_event(EVENT_CELL_OVER_VOLTAGE);
+    ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_ACTIVE);
+    ASSERT_TRUE(events.flap[EVENT_CELL_OVER_VOLTAGE].clear_held);
+    set_event(EVENT_CELL_OVER_VOLTAGE, 0);
+    ASSERT_FALSE(events.flap[EVENT_CELL_OVER_VOLTAGE].clear_held);
+  }
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].flaps, 3);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].occurences, EVENT_FLAP_TRANSITIONS);
+  ASSERT_EQ(get_event_generation(), generation);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_WARNING);
+  ASSERT_EQ(events.held_count, 0);
+}
+
+TEST(event_flap_error_test) {
+  reset_events_test();
+
+  // Errors are never held, every clear reaches the level and bms_status
+  for (uint8_t i = 0; i < 2 * EVENT_FLAP_TRANSITIONS; i++) {
+    testlib_millis += 100;
+    set_event(EVENT_DUMMY_ERROR, 0);
+    ASSERT_EQ(datalayer.battery.status.bms_status, FAULT);
+    clear_event(EVENT_DUMMY_ERROR);
+    ASSERT_EQ(events.entries[EVENT_DUMMY_ERROR].state, EVENT_STATE_INACTIVE);
+    ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+    ASSERT_EQ(datalayer.battery.status.bms_status, ACTIVE);
+  }
+  ASSERT_FALSE(events.entries[EVENT_DUMMY_ERROR].flapping);
+}
+
+TEST(event_flap_release_test) {
+  reset_events_test();
+
+  make_event_flap(EVENT_CELL_OVER_VOLTAGE);
+  set_event_MQTTpublished(EVENT_CELL_OVER_VOLTAGE);
+  clear_event(EVENT_CELL_OVER_VOLTAGE);
+  ASSERT_EQ(events.held_count, 1);
+
+  // Still within the quiet time
+  testlib_millis += EVENT_FLAP_QUIET_MS - 1;
+  release_held_events();
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_ACTIVE);
+
+  // Released without another clear_event()
+  testlib_millis += 1;
+  const uint32_t generation = get_event_generation();
+  release_held_events();
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_INACTIVE);
+  ASSERT_FALSE(events.entries[EVENT_CELL_OVER_VOLTAGE].flapping);
+  ASSERT_FALSE(events.flap[EVENT_CELL_OVER_VOLTAGE].clear_held);
+  ASSERT_FALSE(events.entries[EVENT_CELL_OVER_VOLTAGE].MQTTpublished);
+  ASSERT_NEQ(get_event_generation(), generation);
+  ASSERT_EQ(events.held_count, 0);
+  ASSERT_EQ(events.active_count[EVENT_LEVEL_WARNING], 0);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+
+  // A flapping event that is still set when the quiet time has passed stays active
+  make_event_flap(EVENT_CELL_OVER_VOLTAGE);
+  testlib_millis += EVENT_FLAP_QUIET_MS;
+  release_held_events();
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_ACTIVE);
+  // And a clear after the quiet time goes through at once
+  clear_event(EVENT_CELL_OVER_VOLTAGE);
+  ASSERT_EQ(events.entries[EVENT_CELL_OVER_VOLTAGE].state, EVENT_STATE_INACTIVE);
+  ASSERT_FALSE(events.entries[EVENT_CELL_OVER_VOLTAGE].flapping);
+}
+
+TEST(reset_all_events_test) {
+  reset_events_test();
+
+  set_event(EVENT_DUMMY_WARNING, 1);
+  set_event_latched(EVENT_DUMMY_ERROR, 2);
+  make_event_flap(EVENT_CELL_OVER_VOLTAGE);
+  clear_event(EVENT_CELL_OVER_VOLTAGE);
+  const uint32_t generation = get_event_generation();
+
+  reset_all_events();
+  for (uint8_t i = 0; i < EVENT_NOF_EVENTS; i++) {
+    ASSERT_EQ(events.entries[i].state, EVENT_STATE_INACTIVE);
+    ASSERT_EQ(events.entries[i].occurences, 0);
+    ASSERT_EQ(events.entries[i].data, 0);
+    ASSERT_FALSE(events.entries[i].flapping);
+    ASSERT_EQ(events.entries[i].flaps, 0);
+    ASSERT_FALSE(events.flap[i].clear_held);
+  }
+  for (uint8_t level = 0; level < EVENT_NOF_LEVELS; level++) {
+    ASSERT_EQ(events.active_count[level], 0);
+  }
+  ASSERT_EQ(events.held_count, 0);
+  ASSERT_NEQ(get_event_generation(), generation);
+  ASSERT_EQ(get_event_level(), EVENT_LEVEL_INFO);
+  ASSERT_EQ(datalayer.battery.status.bms_status, ACTIVE);
+}
+
+TEST(events_message_test) {
+  set_event(EVENT_DUMMY_ERROR, 0);  // Set dummy event with no data
+
+  ASSERT_STREQ("The dummy error event was set!", get_event_message_string(EVENT_DUMMY_ERROR));
+}
+
+TEST(events_level_test) {
+  init_events();
+  set_event(EVENT_DUMMY_ERROR, 0);  // Set dummy event with no data
+
+  ASSERT_STREQ("ERROR", get_event_level_string(EVENT_DUMMY_ERROR));
+}
+
+TEST_MAIN();